@@ -110,6 +110,102 @@ if(NOT HAVE_STD_ATOMIC)
   endif()
 endif()
 
+# Determine which kind of mutex is available to guard the global state.
+
+check_cxx_source_compiles("
+  #include <mutex>
+  int main() {
+    std::mutex m;
+    m.lock();
+    m.unlock();
+    return 0;
+  }
+" HAVE_STD_MUTEX)
+
+if(NOT HAVE_STD_MUTEX)
+  check_cxx_source_compiles("
+    #include <windows.h>
+    int main() {
+      CRITICAL_SECTION m;
+      InitializeCriticalSection(&m);
+      EnterCriticalSection(&m);
+      LeaveCriticalSection(&m);
+      DeleteCriticalSection(&m);
+      return 0;
+    }
+  " HAVE_WIN_MUTEX)
+
+  if(NOT HAVE_WIN_MUTEX)
+    check_cxx_source_compiles("
+      #include <pthread.h>
+      int main() {
+        pthread_mutex_t m;
+        pthread_mutex_init(&m, 0);
+        pthread_mutex_lock(&m);
+        pthread_mutex_unlock(&m);
+        pthread_mutex_destroy(&m);
+        return 0;
+      }
+    " HAVE_PTHREAD_MUTEX)
+  endif()
+endif()
+
+# Determine how threads are started, for the BatchReader.
+
+find_package(Threads)
+set(CMAKE_REQUIRED_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+
+check_cxx_source_compiles("
+  #include <thread>
+  void run() {}
+  int main() {
+    std::thread t(run);
+    t.join();
+    return std::thread::hardware_concurrency() > 0 ? 0 : 1;
+  }
+" HAVE_STD_THREAD)
+
+if(NOT HAVE_STD_THREAD)
+  check_cxx_source_compiles("
+    #include <windows.h>
+    DWORD WINAPI run(LPVOID) { return 0; }
+    int main() {
+      HANDLE t = CreateThread(0, 0, run, 0, 0, 0);
+      WaitForSingleObject(t, INFINITE);
+      CloseHandle(t);
+      return 0;
+    }
+  " HAVE_WIN_THREAD)
+
+  if(NOT HAVE_WIN_THREAD)
+    check_cxx_source_compiles("
+      #include <pthread.h>
+      void *run(void *) { return 0; }
+      int main() {
+        pthread_t t;
+        pthread_create(&t, 0, run, 0);
+        pthread_join(t, 0);
+        return 0;
+      }
+    " HAVE_PTHREAD)
+  endif()
+endif()
+
+set(CMAKE_REQUIRED_LIBRARIES)
+
+# The BatchReader reads the files on several threads only if the compiler
+# initializes function-local statics thread-safely, as the tag formats build
+# their key maps on first use.  MSVC does so from 2015 on.
+
+check_cxx_source_compiles("
+  #if !defined(__cpp_threadsafe_static_init) && !(defined(_MSC_VER) && _MSC_VER >= 1900)
+  #error No thread-safe statics
+  #endif
+  int main() {
+    return 0;
+  }
+" HAVE_THREADSAFE_STATICS)
+
 # Determine which kind of byte swap functions your compiler supports.
 
 # GCC's __builtin_bswap* should be checked individually 
@@ -197,15 +293,136 @@ if(NOT HAVE_SNPRINTF)
   " HAVE_SPRINTF_S)
 endif()
 
-# Determine whether your compiler supports codecvt.
+# Determine whether your system supports memory-mapped files.
 
 check_cxx_source_compiles("
-  #include <codecvt>
-  int main() { 
-    std::codecvt_utf8_utf16<wchar_t> x; 
-    return 0; 
+  #include <sys/mman.h>
+  int main() {
+    void *p = mmap(0, 1, PROT_READ, MAP_PRIVATE, 0, 0);
+    munmap(p, 1);
+    return 0;
+  }
+" HAVE_MMAP)
+
+# Determine whether your system can insert and collapse ranges of a file.
+
+check_cxx_source_compiles("
+  #include <fcntl.h>
+  #include <linux/falloc.h>
+  int main() {
+    fallocate(0, FALLOC_FL_INSERT_RANGE, 0, 4096);
+    fallocate(0, FALLOC_FL_COLLAPSE_RANGE, 0, 4096);
+    return 0;
   }
-" HAVE_STD_CODECVT)
+" HAVE_FALLOCATE_RANGE)
+
+# Determine whether your system can copy or share ranges between files in the kernel.
+
+check_cxx_source_compiles("
+  #include <unistd.h>
+  int main() {
+    off_t in = 0, out = 0;
+    return static_cast<int>(copy_file_range(0, &in, 1, &out, 4096, 0));
+  }
+" HAVE_COPY_FILE_RANGE)
+
+check_cxx_source_compiles("
+  #include <sys/ioctl.h>
+  #include <linux/fs.h>
+  int main() {
+    struct file_clone_range range = { 0, 0, 0, 0 };
+    return ioctl(1, FICLONERANGE, &range);
+  }
+" HAVE_FICLONERANGE)
+
+# Determine whether your system can create a temporary file that is closed on exec.
+
+check_cxx_source_compiles("
+  #include <stdlib.h>
+  #include <fcntl.h>
+  int main() {
+    char name[] = \"XXXXXX\";
+    return mkostemp(name, O_CLOEXEC);
+  }
+" HAVE_MKOSTEMP)
+
+# Determine whether your system can be given hints about file access patterns.
+
+check_cxx_source_compiles("
+  #include <fcntl.h>
+  int main() {
+    posix_fadvise(0, 0, 0, POSIX_FADV_SEQUENTIAL);
+    posix_fadvise(0, 0, 0, POSIX_FADV_NOREUSE);
+    return 0;
+  }
+" HAVE_POSIX_FADVISE)
+
+# Determine which SIMD instruction sets your compiler supports.
+
+check_cxx_source_compiles("
+  #include <emmintrin.h>
+  int main() {
+    __m128i x = _mm_set1_epi8(1);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(x, x));
+  }
+" HAVE_SSE2)
+
+check_cxx_source_compiles("
+  #include <immintrin.h>
+  __attribute__((target(\"avx2\"))) int f(const char *p) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(1)));
+  }
+  int main() {
+    char buf[32] = { 0 };
+    __builtin_cpu_init();
+    return __builtin_cpu_supports(\"avx2\") ? f(buf) : 0;
+  }
+" HAVE_GCC_AVX2)
+
+if(NOT HAVE_GCC_AVX2)
+  check_cxx_source_compiles("
+    #include <intrin.h>
+    #include <immintrin.h>
+    int main() {
+      int info[4];
+      __cpuidex(info, 7, 0);
+      unsigned __int64 xcr0 = _xgetbv(0);
+      __m256i x = _mm256_set1_epi8(1);
+      return _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, x)) + info[1] + (int)xcr0;
+    }
+  " HAVE_MSC_AVX2)
+endif()
+
+check_cxx_source_compiles("
+  #include <wmmintrin.h>
+  #include <tmmintrin.h>
+  __attribute__((target(\"pclmul,ssse3\"))) int f(const char *p) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    x = _mm_shuffle_epi8(x, _mm_set1_epi8(1));
+    return _mm_cvtsi128_si32(_mm_clmulepi64_si128(x, x, 0x00));
+  }
+  int main() {
+    char buf[16] = { 0 };
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports(\"pclmul\") && __builtin_cpu_supports(\"ssse3\")) ? f(buf) : 0;
+  }
+" HAVE_GCC_PCLMUL)
+
+if(NOT HAVE_GCC_PCLMUL)
+  check_cxx_source_compiles("
+    #include <intrin.h>
+    #include <wmmintrin.h>
+    #include <tmmintrin.h>
+    int main() {
+      int info[4];
+      __cpuid(info, 1);
+      __m128i x = _mm_set1_epi8(1);
+      x = _mm_shuffle_epi8(x, x);
+      return _mm_cvtsi128_si32(_mm_clmulepi64_si128(x, x, 0x00)) + info[2];
+    }
+  " HAVE_MSC_PCLMUL)
+endif()
 
 # Check for libz using the cmake supplied FindZLIB.cmake
 
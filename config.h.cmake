@@ -13,9 +13,6 @@
 #cmakedefine   HAVE_MAC_BYTESWAP 1
 #cmakedefine   HAVE_OPENBSD_BYTESWAP 1
 
-/* Defined if your compiler supports codecvt */
-#cmakedefine   HAVE_STD_CODECVT 1
-
 /* Defined if your compiler supports some atomic operations */
 #cmakedefine   HAVE_STD_ATOMIC 1
 #cmakedefine   HAVE_BOOST_ATOMIC 1
@@ -24,10 +21,46 @@
 #cmakedefine   HAVE_WIN_ATOMIC 1
 #cmakedefine   HAVE_IA64_ATOMIC 1
 
+/* Defined if your system supports some kind of mutex */
+#cmakedefine   HAVE_STD_MUTEX 1
+#cmakedefine   HAVE_WIN_MUTEX 1
+#cmakedefine   HAVE_PTHREAD_MUTEX 1
+
+/* Defined if your system supports some kind of threads */
+#cmakedefine   HAVE_STD_THREAD 1
+#cmakedefine   HAVE_WIN_THREAD 1
+#cmakedefine   HAVE_PTHREAD 1
+
+/* Defined if your compiler initializes function-local statics thread-safely */
+#cmakedefine   HAVE_THREADSAFE_STATICS 1
+
 /* Defined if your compiler supports some safer version of sprintf */
 #cmakedefine   HAVE_SNPRINTF 1
 #cmakedefine   HAVE_SPRINTF_S 1
 
+/* Defined if your system supports memory-mapped files */
+#cmakedefine   HAVE_MMAP 1
+
+/* Defined if your system supports fallocate() with range insert and collapse */
+#cmakedefine   HAVE_FALLOCATE_RANGE 1
+
+/* Defined if your system can copy or clone ranges between files in the kernel */
+#cmakedefine   HAVE_COPY_FILE_RANGE 1
+#cmakedefine   HAVE_FICLONERANGE 1
+
+/* Defined if your system supports mkostemp() */
+#cmakedefine   HAVE_MKOSTEMP 1
+
+/* Defined if your system supports posix_fadvise() */
+#cmakedefine   HAVE_POSIX_FADVISE 1
+
+/* Defined if your compiler supports some SIMD instruction sets */
+#cmakedefine   HAVE_SSE2 1
+#cmakedefine   HAVE_GCC_AVX2 1
+#cmakedefine   HAVE_MSC_AVX2 1
+#cmakedefine   HAVE_GCC_PCLMUL 1
+#cmakedefine   HAVE_MSC_PCLMUL 1
+
 /* Defined if you have libz */
 #cmakedefine   HAVE_ZLIB 1
 
@@ -0,0 +1,131 @@
+/* Copyright (C) 2013 TagLib developers
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include <batchreader.h>
+
+using namespace std;
+
+// Reads the files given on the command line with 1, 2, 4, ... up to 32
+// threads, or the number given with -j, and prints how fast it went.
+
+double seconds()
+{
+#ifdef _WIN32
+  return GetTickCount() / 1000.0;
+#else
+  timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+#endif
+}
+
+void usage()
+{
+  cout << "usage: batchreader-bench [-j maxthreads] [-n rounds] [-t] <file> [file ...]" << endl;
+  cout << endl;
+  cout << "  -j  read with 1, 2, 4, ... up to maxthreads threads (default 32)" << endl;
+  cout << "  -n  read all files this many times per thread count (default 3)" << endl;
+  cout << "  -t  read the tags only, no audio properties" << endl;
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int maxThreads = 32;
+  unsigned int rounds = 3;
+  int fields = TagLib::BatchReader::AllFields;
+
+  TagLib::List<TagLib::FileName> fileNames;
+
+  for(int i = 1; i < argc; i++) {
+    if(strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+      maxThreads = atoi(argv[++i]);
+    else if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+      rounds = atoi(argv[++i]);
+    else if(strcmp(argv[i], "-t") == 0)
+      fields = TagLib::BatchReader::AllTags;
+    else if(argv[i][0] == '-')
+      usage();
+    else
+      fileNames.append(argv[i]);
+  }
+
+  if(fileNames.isEmpty() || maxThreads == 0 || rounds == 0)
+    usage();
+
+  TagLib::BatchReader reader(fields);
+
+  // Warm up the file system cache.
+
+  reader.setThreadCount(1);
+  reader.read(fileNames);
+
+  unsigned int valid = 0;
+  for(unsigned int i = 0; i < reader.size(); i++) {
+    if(reader[i].isValid)
+      valid++;
+  }
+
+  cout << fileNames.size() << " files, " << valid << " readable, "
+       << reader.threadCount() << " processors" << endl;
+  cout << "threads    files/s    speedup" << endl;
+
+  double single = 0;
+
+  for(unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+    reader.setThreadCount(threads);
+
+    // Take the best of the rounds, which is the least disturbed one.
+
+    double best = 0;
+    for(unsigned int round = 0; round < rounds; round++) {
+      const double start = seconds();
+      reader.read(fileNames);
+      const double elapsed = seconds() - start;
+      if(round == 0 || elapsed < best)
+        best = elapsed;
+    }
+
+    const double rate = best > 0 ? fileNames.size() / best : 0;
+    if(threads == 1)
+      single = rate;
+
+    cout << setw(7) << threads
+         << setw(11) << fixed << setprecision(0) << rate
+         << setw(11) << setprecision(2) << (single > 0 ? rate / single : 0) << endl;
+  }
+
+  return 0;
+}
@@ -87,7 +87,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 APE::File::File(FileName file, bool readProperties,
-                Properties::ReadStyle propertiesStyle) : TagLib::File(file)
+                Properties::ReadStyle propertiesStyle,
+                int readOptions) : TagLib::File(file, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -95,7 +96,8 @@ APE::File::File(FileName file, bool readProperties,
 }
 
 APE::File::File(IOStream *stream, bool readProperties,
-                Properties::ReadStyle propertiesStyle) : TagLib::File(stream)
+                Properties::ReadStyle propertiesStyle,
+                int readOptions) : TagLib::File(stream, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -148,6 +150,11 @@ bool APE::File::save()
     return false;
   }
 
+  if(readInPart()) {
+    debug("APE::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   // Update ID3v1 tag
 
   if(ID3v1Tag()) {
@@ -265,7 +272,7 @@ void APE::File::read(bool readProperties, Properties::ReadStyle /* propertiesSty
   d->APELocation = findAPE();
 
   if(d->APELocation >= 0) {
-    d->tag.set(ApeAPEIndex, new APE::Tag(this, d->APELocation));
+    d->tag.set(ApeAPEIndex, new APE::Tag(this, d->APELocation, readOptions()));
     d->APESize = APETag()->footer()->completeTagSize();
     d->APELocation = d->APELocation + APETag()->footer()->size() - d->APESize;
     d->hasAPE = true;
@@ -35,6 +35,7 @@
 #include <tstring.h>
 #include <tmap.h>
 #include <tpropertymap.h>
+#include <tbytevectorview.h>
 
 #include "apetag.h"
 #include "apefooter.h"
@@ -43,14 +44,46 @@
 using namespace TagLib;
 using namespace APE;
 
+namespace
+{
+  // The keys of the items which carry the basic fields.
+
+  const struct {
+    const char *key;
+    int field;
+  } fieldKeys[] = {
+    { "TITLE",   TagLib::File::ReadTitle },
+    { "ARTIST",  TagLib::File::ReadArtist },
+    { "ALBUM",   TagLib::File::ReadAlbum },
+    { "COMMENT", TagLib::File::ReadComment },
+    { "GENRE",   TagLib::File::ReadGenre },
+    { "YEAR",    TagLib::File::ReadYear },
+    { "TRACK",   TagLib::File::ReadTrack }
+  };
+
+  // Returns true if the item with the undecoded key carries one of the fields
+  // in readOptions.
+
+  bool isRequestedItem(const ByteVectorView &key, int readOptions)
+  {
+    for(size_t i = 0; i < sizeof(fieldKeys) / sizeof(fieldKeys[0]); ++i) {
+      if((readOptions & fieldKeys[i].field) && key.equalsIgnoreCase(fieldKeys[i].key))
+        return true;
+    }
+
+    return false;
+  }
+}
+
 class APE::Tag::TagPrivate
 {
 public:
-  TagPrivate() : file(0), footerLocation(-1), tagLength(0) {}
+  TagPrivate() : file(0), footerLocation(-1), tagLength(0), readOptions(TagLib::File::ReadAll) {}
 
   TagLib::File *file;
   long footerLocation;
   long tagLength;
+  int readOptions;
 
   Footer footer;
 
@@ -66,11 +99,12 @@ APE::Tag::Tag() : TagLib::Tag()
   d = new TagPrivate;
 }
 
-APE::Tag::Tag(TagLib::File *file, long footerLocation) : TagLib::Tag()
+APE::Tag::Tag(TagLib::File *file, long footerLocation, int readOptions) : TagLib::Tag()
 {
   d = new TagPrivate;
   d->file = file;
   d->footerLocation = footerLocation;
+  d->readOptions = readOptions;
 
   read();
 }
@@ -373,6 +407,23 @@ void APE::Tag::parse(const ByteVector &data)
   // 11 bytes is the minimum size for an APE item
 
   for(uint i = 0; i < d->footer.itemCount() && pos <= data.size() - 11; i++) {
+
+    // Skip the items which carry none of the requested fields.  An item is
+    // the length of its value and its flags, followed by the key up to a null
+    // byte and the value.
+
+    if(d->readOptions & TagLib::File::ReadBasicFields) {
+      const ByteVectorView view = ByteVectorView(data).mid(pos);
+      const int keyEnd = view.find('\0', 8);
+      if(keyEnd < 0)
+        break;
+
+      if(!isRequestedItem(view.mid(8, keyEnd - 8), d->readOptions)) {
+        pos += keyEnd + 1 + view.toUInt(0U, false);
+        continue;
+      }
+    }
+
     APE::Item item;
     item.parse(data.mid(pos));
 
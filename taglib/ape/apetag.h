@@ -30,6 +30,7 @@
 #include "tbytevector.h"
 #include "tmap.h"
 #include "tstring.h"
+#include "tfile.h"
 #include "taglib_export.h"
 
 #include "apeitem.h"
@@ -64,9 +65,13 @@ namespace TagLib {
 
       /*!
        * Create an APE tag and parse the data in \a file with APE footer at
-       * \a tagOffset.
+       * \a tagOffset.  If \a readOptions requests some of the basic fields,
+       * the other items are skipped.
+       *
+       * \see File::ReadOption
        */
-      Tag(TagLib::File *file, long footerLocation);
+      Tag(TagLib::File *file, long footerLocation,
+          int readOptions = TagLib::File::ReadAll);
 
       /*!
        * Destroys this Tag instance.
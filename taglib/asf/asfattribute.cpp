@@ -31,6 +31,11 @@
 
 using namespace TagLib;
 
+namespace
+{
+  enum { DeferredPictureSize = 4096, PictureFieldsSize = 1024 };
+}
+
 class ASF::Attribute::AttributePrivate : public RefCounter
 {
 public:
@@ -174,7 +179,7 @@ ASF::Picture ASF::Attribute::toPicture() const
   return d->pictureValue;
 }
 
-String ASF::Attribute::parse(ASF::File &f, int kind)
+String ASF::Attribute::parse(ASF::File &f, int kind, int readOptions)
 {
   uint size, nameLength;
   String name;
@@ -232,11 +237,25 @@ String ASF::Attribute::parse(ASF::File &f, int kind)
 
   case BytesType:
   case GuidType:
+    if(d->type == BytesType && name == "WM/Picture" && size > DeferredPictureSize &&
+       (readOptions & File::DeferBinaryData))
+    {
+      // Leave the image data in the file, if the picture can be parsed from
+      // its first bytes.
+
+      const long offset = f.tell();
+      d->pictureValue.parse(f.readBlock(PictureFieldsSize), &f, offset, size);
+      if(d->pictureValue.isValid()) {
+        f.seek(offset + size);
+        break;
+      }
+      f.seek(offset);
+    }
     d->byteVectorValue = f.readBlock(size);
     break;
   }
 
-  if(d->type == BytesType && name == "WM/Picture") {
+  if(d->type == BytesType && name == "WM/Picture" && !d->pictureValue.isValid()) {
     d->pictureValue.parse(d->byteVectorValue);
     if(d->pictureValue.isValid()) {
       d->byteVectorValue.clear();
@@ -182,7 +182,7 @@ namespace TagLib
 
 #ifndef DO_NOT_DOCUMENT
       /* THIS IS PRIVATE, DON'T TOUCH IT! */
-      String parse(ASF::File &file, int kind = 0);
+      String parse(ASF::File &file, int kind = 0, int readOptions = 0);
 #endif
 
       //! Returns the size of the stored data
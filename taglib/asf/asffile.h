@@ -53,9 +53,12 @@ namespace TagLib {
        * \note In the current implementation, both \a readProperties and
        * \a propertiesStyle are ignored.  The audio properties are always
        * read.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(FileName file, bool readProperties = true, 
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Constructs an ASF file from \a stream.
@@ -66,9 +69,12 @@ namespace TagLib {
        *
        * \note TagLib will *not* take ownership of the stream, the caller is
        * responsible for deleting it after the File object.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(IOStream *stream, bool readProperties = true, 
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Destroys this instance of the File.
@@ -90,18 +96,18 @@ namespace TagLib {
       /*!
        * Implements the unified property interface -- export function.
        */
-      PropertyMap properties() const;
+      virtual PropertyMap properties() const;
 
       /*!
        * Removes unsupported properties. Forwards to the actual Tag's
        * removeUnsupportedProperties() function.
        */
-      void removeUnsupportedProperties(const StringList &properties);
+      virtual void removeUnsupportedProperties(const StringList &properties);
 
       /*!
        * Implements the unified property interface -- import function.
        */
-      PropertyMap setProperties(const PropertyMap &);
+      virtual PropertyMap setProperties(const PropertyMap &);
 
       /*!
        * Returns the ASF audio properties for this file.
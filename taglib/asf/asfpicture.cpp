@@ -26,6 +26,7 @@
 #include <taglib.h>
 #include <tdebug.h>
 #include "trefcounter.h"
+#include "tdeferreddata.h"
 #include "asfattribute.h"
 #include "asffile.h"
 #include "asfpicture.h"
@@ -39,7 +40,7 @@ public:
   Type type;
   String mimeType;
   String description;
-  ByteVector picture;
+  DeferredData picture;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -101,12 +102,12 @@ void ASF::Picture::setDescription(const String &desc)
 
 ByteVector ASF::Picture::picture() const
 {
-  return d->picture;
+  return d->picture.data();
 }
 
 void ASF::Picture::setPicture(const ByteVector &p)
 {
-  d->picture = p;
+  d->picture.setData(p);
 }
 
 int ASF::Picture::dataSize() const
@@ -136,38 +137,63 @@ ByteVector ASF::Picture::render() const
     ByteVector::fromUInt(d->picture.size(), false) +
     ASF::File::renderString(d->mimeType) +
     ASF::File::renderString(d->description) +
-    d->picture;
+    d->picture.data();
 }
 
 void ASF::Picture::parse(const ByteVector& bytes)
 {
   d->valid = false;
-  if(bytes.size() < 9)
+  uint dataLen;
+  const int pos = parseFields(bytes, &dataLen);
+  if(pos < 0)
+    return;
+
+  if(dataLen + pos != bytes.size())
+    return;
+
+  d->picture.setData(bytes.mid(pos, dataLen));
+  d->valid = true;
+  return;
+}
+
+void ASF::Picture::parse(const ByteVector &fields, TagLib::File *file, long offset, uint size)
+{
+  d->valid = false;
+  uint dataLen;
+  const int pos = parseFields(fields, &dataLen);
+  if(pos < 0)
+    return;
+
+  if(dataLen + pos != size)
     return;
+
+  d->picture.defer(file, offset + pos, dataLen);
+  d->valid = true;
+}
+
+int ASF::Picture::parseFields(const ByteVector &bytes, uint *dataLen)
+{
+  if(bytes.size() < 9)
+    return -1;
   int pos = 0;
   d->type = (Type)bytes[0]; ++pos;
-  const uint dataLen = bytes.toUInt(pos, false); pos+=4;
+  *dataLen = bytes.toUInt(pos, false); pos+=4;
 
   const ByteVector nullStringTerminator(2, 0);
 
   int endPos = bytes.find(nullStringTerminator, pos, 2);
   if(endPos < 0)
-    return;
+    return -1;
   d->mimeType = String(bytes.mid(pos, endPos - pos), String::UTF16LE);
   pos = endPos+2;
 
   endPos = bytes.find(nullStringTerminator, pos, 2);
   if(endPos < 0)
-    return;
+    return -1;
   d->description = String(bytes.mid(pos, endPos - pos), String::UTF16LE);
   pos = endPos+2;
 
-  if(dataLen + pos != bytes.size())
-    return;
-
-  d->picture = bytes.mid(pos, dataLen);
-  d->valid = true;
-  return;
+  return pos;
 }
 
 ASF::Picture ASF::Picture::fromInvalid()
@@ -33,6 +33,8 @@
 
 namespace TagLib
 {
+  class File;
+
   namespace ASF
   {
 
@@ -208,6 +210,14 @@ namespace TagLib
       friend class Attribute;
 #endif
       private:
+        /*
+         * Parses a picture of \a size bytes at \a offset in \a file from its
+         * first bytes, \a fields, and leaves the image data in the file until
+         * it is used.
+         */
+        void parse(const ByteVector &fields, TagLib::File *file, long offset, uint size);
+        int parseFields(const ByteVector &bytes, uint *dataLen);
+
         class PicturePrivate;
         PicturePrivate *d;
       };
@@ -234,15 +234,18 @@ static const char *keyTranslation[][2] = {
   { "Acoustid/Fingerprint", "ACOUSTID_FINGERPRINT" },
 };
 
+static Map<String, String> keyTranslationMap(int from, int to)
+{
+  Map<String, String> m;
+  const int numKeys = sizeof(keyTranslation) / sizeof(keyTranslation[0]);
+  for(int i = 0; i < numKeys; i++)
+    m.insert(keyTranslation[i][from], keyTranslation[i][to]);
+  return m;
+}
+
 PropertyMap ASF::Tag::properties() const
 {
-  static Map<String, String> keyMap;
-  if(keyMap.isEmpty()) {
-    int numKeys = sizeof(keyTranslation) / sizeof(keyTranslation[0]);
-    for(int i = 0; i < numKeys; i++) {
-      keyMap[keyTranslation[i][0]] = keyTranslation[i][1];
-    }
-  }
+  static const Map<String, String> keyMap = keyTranslationMap(0, 1);
 
   PropertyMap props;
 
@@ -292,13 +295,7 @@ void ASF::Tag::removeUnsupportedProperties(const StringList &props)
 
 PropertyMap ASF::Tag::setProperties(const PropertyMap &props)
 {
-  static Map<String, String> reverseKeyMap;
-  if(reverseKeyMap.isEmpty()) {
-    int numKeys = sizeof(keyTranslation) / sizeof(keyTranslation[0]);
-    for(int i = 0; i < numKeys; i++) {
-      reverseKeyMap[keyTranslation[i][1]] = keyTranslation[i][0];
-    }
-  }
+  static const Map<String, String> reverseKeyMap = keyTranslationMap(1, 0);
 
   PropertyMap origProps = properties();
   PropertyMap::ConstIterator it = origProps.begin();
@@ -0,0 +1,548 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#if defined(HAVE_STD_THREAD)
+# include <system_error>
+# include <thread>
+#elif defined(HAVE_WIN_THREAD)
+# if !defined(NOMINMAX)
+#   define NOMINMAX
+# endif
+# include <windows.h>
+#elif defined(HAVE_PTHREAD)
+# include <pthread.h>
+# include <unistd.h>
+#endif
+
+#include <tstring.h>
+#include <tiostream.h>
+#include "tutils.h"
+
+#include "batchreader.h"
+#include "fileref.h"
+#include "tag.h"
+
+using namespace TagLib;
+
+namespace
+{
+  typedef BatchReader::Record Record;
+  typedef BatchReader::Text Text;
+
+  uint processorCount()
+  {
+#if defined(HAVE_STD_THREAD)
+
+    const uint count = std::thread::hardware_concurrency();
+
+#elif defined(HAVE_WIN_THREAD)
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const uint count = info.dwNumberOfProcessors;
+
+#elif defined(HAVE_PTHREAD)
+
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    const uint count = n > 0 ? uint(n) : 0;
+
+#else
+
+    const uint count = 1;
+
+#endif
+
+    return count > 0 ? count : 1;
+  }
+
+  uint usableThreadCount(uint threadCount)
+  {
+#if defined(HAVE_THREADSAFE_STATICS)
+
+    return threadCount > 0 ? threadCount : processorCount();
+
+#else
+
+    // The tag formats build their key maps in function-local statics.
+
+    return 1;
+
+#endif
+  }
+
+#if defined(HAVE_STD_THREAD)
+
+  /*!
+   * Joins the threads when it goes out of scope, also by an exception, as
+   * destroying a std::thread which is still joinable terminates the program.
+   */
+  class ThreadJoiner
+  {
+  public:
+    explicit ThreadJoiner(std::vector<std::thread> &threads) : threads(threads) {}
+
+    ~ThreadJoiner()
+    {
+      for(size_t i = 0; i < threads.size(); ++i) {
+        if(threads[i].joinable())
+          threads[i].join();
+      }
+    }
+
+  private:
+    std::vector<std::thread> &threads;
+  };
+
+#endif
+
+  /*!
+   * The indexes of the files a worker has still to read.  The worker takes
+   * them one at a time from the front, other workers steal half of them at
+   * once from the back.
+   */
+  class WorkQueue
+  {
+  public:
+    WorkQueue() : first(0), last(0) {}
+
+    void assign(uint begin, uint end)
+    {
+      MutexLocker locker(mutex);
+      first = begin;
+      last = end;
+    }
+
+    bool take(uint &index)
+    {
+      MutexLocker locker(mutex);
+      if(first == last)
+        return false;
+      index = first++;
+      return true;
+    }
+
+    bool steal(uint &begin, uint &end)
+    {
+      MutexLocker locker(mutex);
+      const uint count = last - first;
+      if(count == 0)
+        return false;
+      end = last;
+      last -= (count + 1) / 2;
+      begin = last;
+      return true;
+    }
+
+    uint size()
+    {
+      MutexLocker locker(mutex);
+      return last - first;
+    }
+
+  private:
+    Mutex mutex;
+    uint first;
+    uint last;
+  };
+
+  class Batch;
+
+  struct Worker
+  {
+    Batch *batch;
+    uint id;
+    WorkQueue queue;
+
+    // The text of the records read by this worker.
+    std::string text;
+  };
+
+  /*!
+   * A single call of BatchReader::read().  Each record is only written by the
+   * worker that reads its file, so the records need no locking.
+   */
+  class Batch
+  {
+  public:
+    Batch(int fields, AudioProperties::ReadStyle audioPropertiesStyle,
+          const List<FileName> *fileNames, const BatchReader::StreamFactory *factory,
+          std::vector<Record> &records) :
+      fields(fields),
+      audioPropertiesStyle(audioPropertiesStyle),
+      fileNames(fileNames),
+      factory(factory),
+      records(records),
+      owners(records.size()),
+      workers(0),
+      workerCount(0) {}
+
+    void run(uint threadCount, std::string &text);
+
+  private:
+    void start();
+    void work(Worker *worker);
+    bool steal(Worker *worker);
+    void readFile(uint index, Worker *worker);
+
+#if defined(HAVE_STD_THREAD)
+    static void startWorker(Worker *worker)
+    {
+      worker->batch->work(worker);
+    }
+#elif defined(HAVE_WIN_THREAD)
+    static DWORD WINAPI startWorker(LPVOID worker)
+    {
+      static_cast<Worker *>(worker)->batch->work(static_cast<Worker *>(worker));
+      return 0;
+    }
+#elif defined(HAVE_PTHREAD)
+    static void *startWorker(void *worker)
+    {
+      static_cast<Worker *>(worker)->batch->work(static_cast<Worker *>(worker));
+      return 0;
+    }
+#endif
+
+    const int fields;
+    const AudioProperties::ReadStyle audioPropertiesStyle;
+    const List<FileName> *fileNames;
+    const BatchReader::StreamFactory *factory;
+
+    std::vector<Record> &records;
+
+    // The worker that read each record, whose text it refers to.
+    std::vector<uint> owners;
+
+    Worker *workers;
+    uint workerCount;
+  };
+
+  void Batch::run(uint threadCount, std::string &text)
+  {
+    const uint count = records.size();
+
+    workerCount = std::min<uint>(std::max<uint>(threadCount, 1), count);
+    workers = new Worker[workerCount];
+
+    for(uint i = 0; i < workerCount; ++i) {
+      workers[i].batch = this;
+      workers[i].id = i;
+      workers[i].queue.assign(uint(ulonglong(count) * i / workerCount),
+                              uint(ulonglong(count) * (i + 1) / workerCount));
+    }
+
+    start();
+
+    // Join the text of the workers and make the records refer to it.
+
+    std::vector<uint> offsets(workerCount);
+    for(uint i = 0; i < workerCount; ++i) {
+      offsets[i] = text.size();
+      text += workers[i].text;
+    }
+
+    for(uint i = 0; i < count; ++i) {
+      const uint offset = offsets[owners[i]];
+      records[i].title.offset   += offset;
+      records[i].artist.offset  += offset;
+      records[i].album.offset   += offset;
+      records[i].comment.offset += offset;
+      records[i].genre.offset   += offset;
+    }
+
+    delete [] workers;
+  }
+
+  /*!
+   * Runs the first worker on the calling thread, and each of the others on a
+   * thread of its own.
+   */
+  void Batch::start()
+  {
+#if defined(HAVE_STD_THREAD)
+
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount - 1);
+    const ThreadJoiner joiner(threads);
+
+    try {
+      for(uint i = 1; i < workerCount; ++i)
+        threads.emplace_back(startWorker, &workers[i]);
+    }
+    catch(const std::system_error &) {
+      // The workers which did not start leave their files to the others.
+    }
+
+    work(&workers[0]);
+
+#elif defined(HAVE_WIN_THREAD)
+
+    std::vector<HANDLE> threads;
+    for(uint i = 1; i < workerCount; ++i) {
+      const HANDLE thread = CreateThread(0, 0, startWorker, &workers[i], 0, 0);
+      if(thread)
+        threads.push_back(thread);
+    }
+
+    work(&workers[0]);
+
+    for(uint i = 0; i < threads.size(); ++i) {
+      WaitForSingleObject(threads[i], INFINITE);
+      CloseHandle(threads[i]);
+    }
+
+#elif defined(HAVE_PTHREAD)
+
+    std::vector<pthread_t> threads;
+    for(uint i = 1; i < workerCount; ++i) {
+      pthread_t thread;
+      if(pthread_create(&thread, 0, startWorker, &workers[i]) == 0)
+        threads.push_back(thread);
+    }
+
+    work(&workers[0]);
+
+    for(uint i = 0; i < threads.size(); ++i)
+      pthread_join(threads[i], 0);
+
+#else
+
+    work(&workers[0]);
+
+#endif
+  }
+
+  void Batch::work(Worker *worker)
+  {
+    do {
+      uint index;
+      while(worker->queue.take(index))
+        readFile(index, worker);
+    } while(steal(worker));
+  }
+
+  /*!
+   * Moves half of the files of the worker with the most files left to
+   * \a worker.  Returns false if no files are left, or rather no files that
+   * are not already being read.  Any worker which failed to start leaves its
+   * files to be stolen by the others.
+   */
+  bool Batch::steal(Worker *worker)
+  {
+    for(;;) {
+      Worker *victim = 0;
+      uint most = 0;
+
+      for(uint i = 0; i < workerCount; ++i) {
+        const uint size = workers[i].queue.size();
+        if(size > most) {
+          victim = &workers[i];
+          most = size;
+        }
+      }
+
+      if(!victim)
+        return false;
+
+      uint begin, end;
+      if(victim->queue.steal(begin, end)) {
+        worker->queue.assign(begin, end);
+        return true;
+      }
+    }
+  }
+
+  Text appendText(std::string &text, const String &s)
+  {
+    const std::string utf8 = s.to8Bit(true);
+    const Text t = { uint(text.size()), uint(utf8.size()) };
+    text += utf8;
+    return t;
+  }
+
+  void Batch::readFile(uint index, Worker *worker)
+  {
+    static const Record emptyRecord = Record();
+
+    Record &r = records[index];
+    r = emptyRecord;
+    owners[index] = worker->id;
+
+    const bool readAudioProperties = (fields & BatchReader::Properties) != 0;
+    IOStream *stream = 0;
+
+    // The tag fields of BatchReader line up with File::ReadTitle to
+    // File::ReadTrack, so the parsers can skip everything else.  Asking for
+    // none of them would read all of them, so without any the title is read
+    // and ignored.
+
+    int readOptions = File::DeferBinaryData;
+    if(fields & BatchReader::AllTags)
+      readOptions |= (fields & BatchReader::AllTags) << 8;
+    else
+      readOptions |= File::ReadTitle;
+
+    {
+      const FileRef f = fileNames
+        ? FileRef((*fileNames)[index], readAudioProperties, audioPropertiesStyle, readOptions)
+        : FileRef(stream = factory->createStream(index), readAudioProperties, audioPropertiesStyle,
+                  readOptions);
+
+      if(!f.isNull()) {
+        r.isValid = true;
+
+        const Tag *tag = f.tag();
+        if(tag) {
+          if(fields & BatchReader::Title)
+            r.title = appendText(worker->text, tag->title());
+          if(fields & BatchReader::Artist)
+            r.artist = appendText(worker->text, tag->artist());
+          if(fields & BatchReader::Album)
+            r.album = appendText(worker->text, tag->album());
+          if(fields & BatchReader::Comment)
+            r.comment = appendText(worker->text, tag->comment());
+          if(fields & BatchReader::Genre)
+            r.genre = appendText(worker->text, tag->genre());
+          if(fields & BatchReader::Year)
+            r.year = tag->year();
+          if(fields & BatchReader::Track)
+            r.track = tag->track();
+        }
+
+        const AudioProperties *properties = f.audioProperties();
+        if(properties && readAudioProperties) {
+          r.length     = properties->length();
+          r.bitrate    = properties->bitrate();
+          r.sampleRate = properties->sampleRate();
+          r.channels   = properties->channels();
+        }
+      }
+    }
+
+    delete stream;
+  }
+}
+
+class BatchReader::BatchReaderPrivate
+{
+public:
+  BatchReaderPrivate(int fields, AudioProperties::ReadStyle audioPropertiesStyle) :
+    fields(fields),
+    audioPropertiesStyle(audioPropertiesStyle),
+    threadCount(0) {}
+
+  void read(const List<FileName> *fileNames, const StreamFactory *factory, uint count);
+
+  const int fields;
+  const AudioProperties::ReadStyle audioPropertiesStyle;
+  uint threadCount;
+
+  std::vector<Record> records;
+  std::string text;
+};
+
+void BatchReader::BatchReaderPrivate::read(const List<FileName> *fileNames,
+                                           const StreamFactory *factory, uint count)
+{
+  records.assign(count, Record());
+  text.clear();
+
+  if(count > 0) {
+    Batch batch(fields, audioPropertiesStyle, fileNames, factory, records);
+    batch.run(usableThreadCount(threadCount), text);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// StreamFactory
+////////////////////////////////////////////////////////////////////////////////
+
+BatchReader::StreamFactory::~StreamFactory()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+BatchReader::BatchReader(int fields, AudioProperties::ReadStyle audioPropertiesStyle)
+{
+  d = new BatchReaderPrivate(fields, audioPropertiesStyle);
+}
+
+BatchReader::~BatchReader()
+{
+  delete d;
+}
+
+void BatchReader::setThreadCount(uint count)
+{
+  d->threadCount = count;
+}
+
+TagLib::uint BatchReader::threadCount() const
+{
+  return usableThreadCount(d->threadCount);
+}
+
+void BatchReader::read(const List<FileName> &fileNames)
+{
+  d->read(&fileNames, 0, fileNames.size());
+}
+
+void BatchReader::read(uint count, const StreamFactory &factory)
+{
+  d->read(0, &factory, count);
+}
+
+TagLib::uint BatchReader::size() const
+{
+  return d->records.size();
+}
+
+const BatchReader::Record &BatchReader::operator[](uint i) const
+{
+  return d->records[i];
+}
+
+String BatchReader::text(const Text &text) const
+{
+  if(text.length == 0)
+    return String::null;
+
+  return String(std::string(d->text, text.offset, text.length), String::UTF8);
+}
+
+const char *BatchReader::textData() const
+{
+  return d->text.data();
+}
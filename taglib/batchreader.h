@@ -0,0 +1,223 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_BATCHREADER_H
+#define TAGLIB_BATCHREADER_H
+
+#include "tfile.h"
+#include "tlist.h"
+#include "tstring.h"
+#include "taglib_export.h"
+#include "audioproperties.h"
+
+namespace TagLib {
+
+  class IOStream;
+
+  //! Reads the tags and audio properties of many files at once
+
+  /*!
+   * BatchReader reads the basic tag fields and audio properties of a list of
+   * files on several threads.  The files are split evenly between the threads
+   * up front, and a thread that runs out of files takes half of the files left
+   * to the busiest one, so that a few slow files don't hold up the others.
+   *
+   * The results are plain records, one per file in the order of the input.
+   * Their text fields refer to a single UTF-8 buffer owned by the reader:
+   *
+   * \code
+   *
+   * TagLib::BatchReader reader(TagLib::BatchReader::Title | TagLib::BatchReader::Artist);
+   * reader.read(fileNames);
+   *
+   * for(TagLib::uint i = 0; i < reader.size(); ++i) {
+   *   if(reader[i].isValid)
+   *     std::cout << reader.text(reader[i].title) << std::endl;
+   * }
+   *
+   * \endcode
+   *
+   * The files are opened with FileRef, so added file types and resolvers are
+   * used as well.  These and the other global settings of TagLib, like
+   * ID3v2::Tag::setLatin1StringHandler(), ID3v2::FrameFactory's default
+   * encoding or setDebugListener(), must not be changed while reading.
+   */
+
+  class TAGLIB_EXPORT BatchReader
+  {
+  public:
+
+    /*!
+     * The fields to be read.  Fields that are not requested are left empty or
+     * zero in the records.
+     */
+    enum Field {
+      //! The title of the tag
+      Title      = 0x0001,
+      //! The artist of the tag
+      Artist     = 0x0002,
+      //! The album of the tag
+      Album      = 0x0004,
+      //! The comment of the tag
+      Comment    = 0x0008,
+      //! The genre of the tag
+      Genre      = 0x0010,
+      //! The year of the tag
+      Year       = 0x0020,
+      //! The track number of the tag
+      Track      = 0x0040,
+      //! All of the above
+      AllTags    = 0x007f,
+      //! The length, bitrate, sample rate and channels of the audio
+      Properties = 0x0080,
+      //! All fields
+      AllFields  = 0x00ff
+    };
+
+    /*!
+     * A piece of UTF-8 text in the buffer of the reader.
+     *
+     * \see text()
+     */
+    struct Text
+    {
+      uint offset;
+      uint length;
+    };
+
+    /*!
+     * The fields read from one file.
+     */
+    struct Record
+    {
+      //! False if the file could not be opened or its type is unknown
+      bool isValid;
+
+      Text title;
+      Text artist;
+      Text album;
+      Text comment;
+      Text genre;
+      uint year;
+      uint track;
+
+      int length;
+      int bitrate;
+      int sampleRate;
+      int channels;
+    };
+
+    //! A class creating the streams to be read
+
+    /*!
+     * Used to read from streams instead of named files.
+     */
+    class TAGLIB_EXPORT StreamFactory
+    {
+    public:
+      virtual ~StreamFactory();
+
+      /*!
+       * Returns the stream of the \a index th file, or a null pointer if it
+       * cannot be opened.  The stream is deleted by the reader when it is
+       * done with it.
+       *
+       * \note This is called from several threads at once.
+       */
+      virtual IOStream *createStream(uint index) const = 0;
+    };
+
+    /*!
+     * Creates a reader that reads the \a fields, a combination of Field
+     * values.  The audio properties are read with \a audioPropertiesStyle.
+     */
+    explicit BatchReader(int fields = AllFields,
+                         AudioProperties::ReadStyle audioPropertiesStyle = AudioProperties::Average);
+
+    /*!
+     * Destroys the reader and its records.
+     */
+    ~BatchReader();
+
+    /*!
+     * Sets the number of threads used for reading to \a count.  If \a count
+     * is 0, which is the default, one thread per processor is used.
+     *
+     * \note Reading on several threads needs a compiler that initializes
+     * function-local statics thread-safely, as C++11 requires; the tag formats
+     * build their key maps in them on first use.  With older compilers, such
+     * as MSVC before 2015, or with -fno-threadsafe-statics, a single thread is
+     * used whatever \a count is.
+     */
+    void setThreadCount(uint count);
+
+    /*!
+     * Returns the number of threads used for reading.
+     */
+    uint threadCount() const;
+
+    /*!
+     * Reads the files named in \a fileNames, replacing the records of any
+     * earlier read.
+     */
+    void read(const List<FileName> &fileNames);
+
+    /*!
+     * Reads \a count streams created by \a factory, replacing the records of
+     * any earlier read.
+     */
+    void read(uint count, const StreamFactory &factory);
+
+    /*!
+     * Returns the number of records, which is the number of files read.
+     */
+    uint size() const;
+
+    /*!
+     * Returns the record of the \a i th file.
+     */
+    const Record &operator[](uint i) const;
+
+    /*!
+     * Returns the text referred to by \a text.
+     */
+    String text(const Text &text) const;
+
+    /*!
+     * Returns the UTF-8 buffer that the text of the records refers to.  It is
+     * not null terminated.
+     */
+    const char *textData() const;
+
+  private:
+    BatchReader(const BatchReader &);
+    BatchReader &operator=(const BatchReader &);
+
+    class BatchReaderPrivate;
+    BatchReaderPrivate *d;
+  };
+
+} // namespace TagLib
+
+#endif
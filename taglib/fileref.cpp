@@ -27,10 +27,15 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <algorithm>
+
 #include <tfile.h>
 #include <tstring.h>
 #include <tdebug.h>
+#include <tfilestream.h>
+#include <tmap.h>
 #include "trefcounter.h"
+#include "tutils.h"
 
 #include "fileref.h"
 #include "asffile.h"
@@ -51,22 +56,640 @@
 #include "s3mfile.h"
 #include "itfile.h"
 #include "xmfile.h"
+#include "id3v2framefactory.h"
 
 using namespace TagLib;
 
+namespace
+{
+  typedef FileRef::FileFormat FileFormat;
+  typedef FileRef::FileTypeResolver FileTypeResolver;
+
+  // Behind an ID3v2 tag this much is enough for all signatures but those of
+  // the module formats, which never carry such a tag.
+
+  const uint ShortProbeSize = 64;
+
+  const char ASFGuid[] = "\x30\x26\xB2\x75\x8E\x66\xCF\x11\xA6\xD9\x00\xAA\x00\x62\xCE\x6C";
+
+  String extensionOf(FileName fileName)
+  {
+#ifdef _WIN32
+    const String s = fileName.toString();
+#else
+    const String s = fileName;
+#endif
+
+    const int pos = s.rfind(".");
+    if(pos != -1)
+      return s.substr(pos + 1).upper();
+
+    return String::null;
+  }
+
+  bool isDigit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  // Signatures of the built-in formats.  Each one is only called with at least
+  // as many bytes as given along with it in FormatTable::addBuiltinFormats().
+
+  /*!
+   * Returns true if \a data starts with a plausible MPEG audio frame header.
+   * Layer "0" is rejected, which keeps ADTS AAC out.
+   */
+  bool isMPEGSignature(const ByteVectorView &data)
+  {
+    const uchar b1 = data[1];
+    const uchar b2 = data[2];
+
+    return uchar(data[0]) == 0xFF &&
+           (b1 & 0xE0) == 0xE0 &&      // sync
+           ((b1 >> 3) & 0x03) != 1 &&  // version
+           ((b1 >> 1) & 0x03) != 0 &&  // layer
+           (b2 >> 4) != 0x0F &&        // bitrate
+           ((b2 >> 2) & 0x03) != 3;    // sample rate
+  }
+
+  // The first Ogg page carries the codec's identification header at 28.
+
+  bool isVorbisSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("OggS") && data.containsAt("\x01vorbis", 28);
+  }
+
+  bool isOggFLACSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("OggS") && data.containsAt("\x7F" "FLAC", 28);
+  }
+
+  bool isSpeexSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("OggS") && data.containsAt("Speex   ", 28);
+  }
+
+  bool isOpusSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("OggS") && data.containsAt("OpusHead", 28);
+  }
+
+  bool isFLACSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("fLaC");
+  }
+
+  bool isMPCSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("MP+") || data.startsWith("MPCK");
+  }
+
+  bool isWavPackSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("wvpk");
+  }
+
+  bool isTrueAudioSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("TTA1");
+  }
+
+  bool isMP4Signature(const ByteVectorView &data)
+  {
+    return data.containsAt("ftyp", 4) || data.containsAt("moov", 4);
+  }
+
+  bool isASFSignature(const ByteVectorView &data)
+  {
+    return data.startsWith(ByteVectorView(ASFGuid, 16));
+  }
+
+  bool isAIFFSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("FORM") && (data.containsAt("AIFF", 8) || data.containsAt("AIFC", 8));
+  }
+
+  bool isWAVSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("RIFF") && data.containsAt("WAVE", 8);
+  }
+
+  bool isAPESignature(const ByteVectorView &data)
+  {
+    return data.startsWith("MAC ");
+  }
+
+  bool isModSignature(const ByteVectorView &data)
+  {
+    const ByteVectorView id = data.mid(1080, 4);
+
+    if(id == "M.K." || id == "M!K!" || id == "M&K!" || id == "N.T." ||
+       id == "CD81" || id == "OKTA" || id == "OCTA")
+      return true;
+
+    if((id.startsWith("FLT") || id.startsWith("TDZ")) && isDigit(id[3]))
+      return true;
+
+    if(isDigit(id[0]) && id.mid(1) == "CHN")
+      return true;
+
+    if(isDigit(id[0]) && isDigit(id[1]) && (id.mid(2) == "CH" || id.mid(2) == "CN"))
+      return true;
+
+    return false;
+  }
+
+  bool isS3MSignature(const ByteVectorView &data)
+  {
+    return data.containsAt("SCRM", 44);
+  }
+
+  bool isITSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("IMPM");
+  }
+
+  bool isXMSignature(const ByteVectorView &data)
+  {
+    return data.startsWith("Extended Module: ");
+  }
+
+  typedef bool (*Signature)(const ByteVectorView &data);
+
+  // Creates a T, passing the read options on if ReadOptions is true, which
+  // is the case for the formats whose constructors take them.
+
+  template <class T, bool ReadOptions>
+  struct Constructor
+  {
+    template <class Source>
+    static File *create(Source source, bool readAudioProperties,
+                        AudioProperties::ReadStyle audioPropertiesStyle, int /* readOptions */)
+    {
+      return new T(source, readAudioProperties, audioPropertiesStyle);
+    }
+  };
+
+  template <class T>
+  struct Constructor<T, true>
+  {
+    template <class Source>
+    static File *create(Source source, bool readAudioProperties,
+                        AudioProperties::ReadStyle audioPropertiesStyle, int readOptions)
+    {
+      return new T(source, readAudioProperties, audioPropertiesStyle, readOptions);
+    }
+  };
+
+  template <class T, bool ReadOptions = false>
+  class BuiltinFormat : public FileFormat
+  {
+  public:
+    BuiltinFormat(const char *extensions, uint length, Signature signature, bool weak = false) :
+      exts(String(extensions).split(" ")),
+      length(length),
+      signature(signature),
+      weak(weak) {}
+
+    StringList extensions() const
+    {
+      return exts;
+    }
+
+    uint signatureLength() const
+    {
+      return length;
+    }
+
+    bool hasWeakSignature() const
+    {
+      return weak;
+    }
+
+    bool isSignature(const ByteVectorView &data) const
+    {
+      return signature(data);
+    }
+
+    File *createFile(FileName fileName, bool readAudioProperties,
+                     AudioProperties::ReadStyle audioPropertiesStyle) const
+    {
+      return createFile(fileName, readAudioProperties, audioPropertiesStyle, File::ReadAll);
+    }
+
+    File *createFile(IOStream *stream, bool readAudioProperties,
+                     AudioProperties::ReadStyle audioPropertiesStyle) const
+    {
+      return createFile(stream, readAudioProperties, audioPropertiesStyle, File::ReadAll);
+    }
+
+    File *createFile(FileName fileName, bool readAudioProperties,
+                     AudioProperties::ReadStyle audioPropertiesStyle, int readOptions) const
+    {
+      return Constructor<T, ReadOptions>::create(
+        fileName, readAudioProperties, audioPropertiesStyle, readOptions);
+    }
+
+    File *createFile(IOStream *stream, bool readAudioProperties,
+                     AudioProperties::ReadStyle audioPropertiesStyle, int readOptions) const
+    {
+      return Constructor<T, ReadOptions>::create(
+        stream, readAudioProperties, audioPropertiesStyle, readOptions);
+    }
+
+  private:
+    const StringList exts;
+    const uint length;
+    const Signature signature;
+    const bool weak;
+  };
+
+  template <>
+  File *BuiltinFormat<MPEG::File, true>::createFile(IOStream *stream, bool readAudioProperties,
+                                                    AudioProperties::ReadStyle audioPropertiesStyle,
+                                                    int readOptions) const
+  {
+    return new MPEG::File(stream, ID3v2::FrameFactory::instance(),
+                          readAudioProperties, audioPropertiesStyle, readOptions);
+  }
+
+  template <>
+  File *BuiltinFormat<FLAC::File, true>::createFile(IOStream *stream, bool readAudioProperties,
+                                                    AudioProperties::ReadStyle audioPropertiesStyle,
+                                                    int readOptions) const
+  {
+    return new FLAC::File(stream, ID3v2::FrameFactory::instance(),
+                          readAudioProperties, audioPropertiesStyle, readOptions);
+  }
+
+  // Without content, .oga can be any audio in the Ogg container.  First try
+  // FLAC, then Vorbis.
+
+  template <>
+  File *BuiltinFormat<Ogg::FLAC::File, true>::createFile(FileName fileName, bool readAudioProperties,
+                                                         AudioProperties::ReadStyle audioPropertiesStyle,
+                                                         int readOptions) const
+  {
+    File *file = new Ogg::FLAC::File(fileName, readAudioProperties, audioPropertiesStyle, readOptions);
+    if(file->isValid())
+      return file;
+    delete file;
+    return new Ogg::Vorbis::File(fileName, readAudioProperties, audioPropertiesStyle, readOptions);
+  }
+
+  template <>
+  File *BuiltinFormat<Ogg::FLAC::File, true>::createFile(IOStream *stream, bool readAudioProperties,
+                                                         AudioProperties::ReadStyle audioPropertiesStyle,
+                                                         int readOptions) const
+  {
+    File *file = new Ogg::FLAC::File(stream, readAudioProperties, audioPropertiesStyle, readOptions);
+    if(file->isValid())
+      return file;
+    delete file;
+    stream->seek(0);
+    return new Ogg::Vorbis::File(stream, readAudioProperties, audioPropertiesStyle, readOptions);
+  }
+
+  /*!
+   * The resolvers and formats known at some point.  A table is never modified
+   * once it has been published by the registry, so any number of threads can
+   * read it without locking.
+   */
+  class FormatTable : public RefCounter
+  {
+  public:
+    FormatTable() :
+      RefCounter(),
+      probeSize(ShortProbeSize),
+      mpegFormat(0) {}
+
+    FormatTable(const FormatTable &t) :
+      RefCounter(),
+      resolvers(t.resolvers),
+      formats(t.formats),
+      signatures(t.signatures),
+      weakSignatures(t.weakSignatures),
+      extensions(t.extensions),
+      probeSize(t.probeSize),
+      mpegFormat(t.mpegFormat) {}
+
+    void addBuiltinFormats(List<const FileFormat *> &builtins);
+    void addFormat(const FileFormat *format);
+
+    const FileFormat *formatForExtension(const String &ext) const;
+    const FileFormat *formatForContent(IOStream *stream, const String &ext) const;
+
+    File *createFile(FileName fileName, bool readAudioProperties,
+                     AudioProperties::ReadStyle audioPropertiesStyle) const;
+    File *createFile(IOStream *stream, bool readAudioProperties,
+                     AudioProperties::ReadStyle audioPropertiesStyle, int readOptions) const;
+
+    // Prepended to, the last one added is tried first.
+    List<const FileTypeResolver *> resolvers;
+
+    // In the order they were added.
+    List<const FileFormat *> formats;
+
+    // Sorted by the length of their signatures.
+    List<const FileFormat *> signatures;
+    List<const FileFormat *> weakSignatures;
+
+    // Keyed by the extension in uppercase.
+    Map<String, const FileFormat *> extensions;
+
+    // The longest signature, which is what is read from the start of a stream.
+    uint probeSize;
+
+    // Assumed for anything behind an ID3v2 tag.
+    const FileFormat *mpegFormat;
+  };
+
+  bool isShorterSignature(const FileFormat *a, const FileFormat *b)
+  {
+    return a->signatureLength() < b->signatureLength();
+  }
+
+  void FormatTable::addBuiltinFormats(List<const FileFormat *> &builtins)
+  {
+    // If the order is changed, the order of the extensions returned by
+    // defaultFileExtensions() changes as well.
+
+    mpegFormat = new BuiltinFormat<MPEG::File, true>("mp3", 4, isMPEGSignature, true);
+
+    builtins.append(new BuiltinFormat<Ogg::Vorbis::File, true>("ogg", 35, isVorbisSignature));
+    builtins.append(new BuiltinFormat<FLAC::File, true>("flac", 4, isFLACSignature));
+    builtins.append(new BuiltinFormat<Ogg::FLAC::File, true>("oga", 33, isOggFLACSignature));
+    builtins.append(mpegFormat);
+    builtins.append(new BuiltinFormat<MPC::File, true>("mpc", 4, isMPCSignature));
+    builtins.append(new BuiltinFormat<WavPack::File, true>("wv", 4, isWavPackSignature));
+    builtins.append(new BuiltinFormat<Ogg::Speex::File, true>("spx", 36, isSpeexSignature));
+    builtins.append(new BuiltinFormat<Ogg::Opus::File, true>("opus", 36, isOpusSignature));
+    builtins.append(new BuiltinFormat<TrueAudio::File, true>("tta", 4, isTrueAudioSignature));
+    builtins.append(new BuiltinFormat<MP4::File, true>("m4a m4r m4b m4p 3g2 mp4", 8, isMP4Signature));
+    builtins.append(new BuiltinFormat<ASF::File, true>("wma asf", 16, isASFSignature));
+    builtins.append(new BuiltinFormat<RIFF::AIFF::File, true>("aif aiff", 12, isAIFFSignature));
+    builtins.append(new BuiltinFormat<RIFF::WAV::File, true>("wav", 12, isWAVSignature));
+    builtins.append(new BuiltinFormat<APE::File, true>("ape", 4, isAPESignature));
+    // module, nst and wow are possible but uncommon extensions
+    builtins.append(new BuiltinFormat<Mod::File>("mod module nst wow", 1084, isModSignature));
+    builtins.append(new BuiltinFormat<S3M::File>("s3m", 48, isS3MSignature));
+    builtins.append(new BuiltinFormat<IT::File>("it", 4, isITSignature));
+    builtins.append(new BuiltinFormat<XM::File>("xm", 17, isXMSignature));
+
+    for(List<const FileFormat *>::ConstIterator it = builtins.begin(); it != builtins.end(); ++it)
+      addFormat(*it);
+  }
+
+  void FormatTable::addFormat(const FileFormat *format)
+  {
+    formats.append(format);
+
+    const StringList exts = format->extensions();
+    for(StringList::ConstIterator it = exts.begin(); it != exts.end(); ++it)
+      extensions.insert(it->upper(), format);
+
+    const uint length = format->signatureLength();
+    if(length > 0) {
+      List<const FileFormat *> &l = format->hasWeakSignature() ? weakSignatures : signatures;
+      l.insert(std::lower_bound(l.begin(), l.end(), format, isShorterSignature), format);
+      probeSize = std::max(probeSize, length);
+    }
+  }
+
+  const FileFormat *FormatTable::formatForExtension(const String &ext) const
+  {
+    const Map<String, const FileFormat *>::ConstIterator it = extensions.find(ext);
+    if(it != extensions.end())
+      return it->second;
+
+    return 0;
+  }
+
+  /*!
+   * Guesses the format of \a stream from its first bytes.  Only a file starting
+   * with an ID3v2 tag costs a second read just behind the tag.  The extension
+   * \a ext is used if the content is not conclusive.
+   */
+  const FileFormat *FormatTable::formatForContent(IOStream *stream, const String &ext) const
+  {
+    stream->seek(0);
+    ByteVector data = stream->readBlock(probeSize);
+    uint offset = 0;
+    const bool hasID3v2 = data.startsWith("ID3") && data.size() >= 10;
+
+    if(hasID3v2) {
+
+      // The size is a 28 bit synch safe integer, followed by an optional footer.
+
+      const uint tagSize = 10 + ((data[6] & 0x7f) << 21 | (data[7] & 0x7f) << 14 |
+                                 (data[8] & 0x7f) << 7  | (data[9] & 0x7f)) +
+                           ((data[5] & 0x10) ? 10 : 0);
+
+      if(tagSize + ShortProbeSize <= data.size())
+        offset = tagSize;
+      else {
+        stream->seek(tagSize);
+        data = stream->readBlock(ShortProbeSize);
+      }
+    }
+
+    const ByteVectorView content = ByteVectorView(data).mid(offset);
+
+    List<const FileFormat *>::ConstIterator it = signatures.begin();
+    for(; it != signatures.end() && (*it)->signatureLength() <= content.size(); ++it) {
+      if((*it)->isSignature(content))
+        return *it;
+    }
+
+    it = weakSignatures.begin();
+    for(; it != weakSignatures.end() && (*it)->signatureLength() <= content.size(); ++it) {
+      if((*it)->isSignature(content))
+        return *it;
+    }
+
+    const FileFormat *format = formatForExtension(ext);
+    if(format)
+      return format;
+
+    // Anything else behind an ID3v2 tag is most likely an MPEG stream with
+    // some junk before the first frame.
+
+    if(hasID3v2)
+      return mpegFormat;
+
+    return 0;
+  }
+
+  File *FormatTable::createFile(FileName fileName, bool readAudioProperties,
+                                AudioProperties::ReadStyle audioPropertiesStyle) const
+  {
+    List<const FileTypeResolver *>::ConstIterator it = resolvers.begin();
+    for(; it != resolvers.end(); ++it) {
+      File *file = (*it)->createFile(fileName, readAudioProperties, audioPropertiesStyle);
+      if(file)
+        return file;
+    }
+
+    return 0;
+  }
+
+  File *FormatTable::createFile(IOStream *stream, bool readAudioProperties,
+                                AudioProperties::ReadStyle audioPropertiesStyle,
+                                int readOptions) const
+  {
+    if(!stream || !stream->isOpen())
+      return 0;
+
+    const FileFormat *format = formatForContent(stream, extensionOf(stream->name()));
+    if(!format)
+      return 0;
+
+    stream->seek(0);
+    return format->createFile(stream, readAudioProperties, audioPropertiesStyle, readOptions);
+  }
+
+  /*!
+   * Holds the current FormatTable.  Adding a resolver or a format publishes a
+   * modified copy of the table, so readers only hold the lock for as long as
+   * it takes to reference the table.
+   */
+  class FormatRegistry
+  {
+  public:
+    static FormatRegistry &instance()
+    {
+      static FormatRegistry registry;
+      return registry;
+    }
+
+    FormatTable *table()
+    {
+      MutexLocker locker(mutex);
+      d->ref();
+      return d;
+    }
+
+    void addResolver(const FileTypeResolver *resolver)
+    {
+      MutexLocker locker(mutex);
+      FormatTable *t = new FormatTable(*d);
+      t->resolvers.prepend(resolver);
+      publish(t);
+    }
+
+    void addFormat(const FileFormat *format)
+    {
+      MutexLocker locker(mutex);
+      FormatTable *t = new FormatTable(*d);
+      t->addFormat(format);
+      publish(t);
+    }
+
+  private:
+    FormatRegistry() : d(new FormatTable())
+    {
+      d->addBuiltinFormats(builtins);
+    }
+
+    ~FormatRegistry()
+    {
+      if(d->deref())
+        delete d;
+
+      for(List<const FileFormat *>::ConstIterator it = builtins.begin(); it != builtins.end(); ++it)
+        delete *it;
+    }
+
+    void publish(FormatTable *t)
+    {
+      if(d->deref())
+        delete d;
+      d = t;
+    }
+
+    Mutex mutex;
+    FormatTable *d;
+    List<const FileFormat *> builtins;
+  };
+
+  /*!
+   * Keeps the table of the registry, as it was when this was created, alive.
+   */
+  class Formats
+  {
+  public:
+    Formats() : d(FormatRegistry::instance().table()) {}
+
+    ~Formats()
+    {
+      if(d->deref())
+        delete d;
+    }
+
+    const FormatTable *operator->() const
+    {
+      return d;
+    }
+
+  private:
+    Formats(const Formats &);
+    Formats &operator=(const Formats &);
+
+    FormatTable *d;
+  };
+}
+
 class FileRef::FileRefPrivate : public RefCounter
 {
 public:
-  FileRefPrivate(File *f) : RefCounter(), file(f) {}
+  FileRefPrivate(File *f, IOStream *s = 0) : RefCounter(), file(f), stream(s) {}
   ~FileRefPrivate() {
     delete file;
+    delete stream;
   }
 
   File *file;
-  static List<const FileTypeResolver *> fileTypeResolvers;
+
+  // Only set if the stream was opened by the FileRef itself.
+  IOStream *stream;
 };
 
-List<const FileRef::FileTypeResolver *> FileRef::FileRefPrivate::fileTypeResolvers;
+////////////////////////////////////////////////////////////////////////////////
+// FileFormat
+////////////////////////////////////////////////////////////////////////////////
+
+FileRef::FileFormat::~FileFormat()
+{
+}
+
+TagLib::uint FileRef::FileFormat::signatureLength() const
+{
+  return 0;
+}
+
+bool FileRef::FileFormat::hasWeakSignature() const
+{
+  return false;
+}
+
+bool FileRef::FileFormat::isSignature(const ByteVectorView &) const
+{
+  return false;
+}
+
+File *FileRef::FileFormat::createFile(FileName fileName, bool readAudioProperties,
+                                      AudioProperties::ReadStyle audioPropertiesStyle,
+                                      int /* readOptions */) const
+{
+  return createFile(fileName, readAudioProperties, audioPropertiesStyle);
+}
+
+File *FileRef::FileFormat::createFile(IOStream *stream, bool readAudioProperties,
+                                      AudioProperties::ReadStyle audioPropertiesStyle,
+                                      int /* readOptions */) const
+{
+  return createFile(stream, readAudioProperties, audioPropertiesStyle);
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 // public members
@@ -78,9 +701,34 @@ FileRef::FileRef()
 }
 
 FileRef::FileRef(FileName fileName, bool readAudioProperties,
-                 AudioProperties::ReadStyle audioPropertiesStyle)
+                 AudioProperties::ReadStyle audioPropertiesStyle, int readOptions)
+{
+  const Formats formats;
+
+  // The resolvers can't be given the read options, but the formats can.
+
+  File *file = formats->createFile(fileName, readAudioProperties, audioPropertiesStyle);
+  if(file) {
+    d = new FileRefPrivate(file);
+    return;
+  }
+
+  IOStream *stream = new FileStream(fileName);
+  file = formats->createFile(stream, readAudioProperties, audioPropertiesStyle, readOptions);
+  if(file) {
+    d = new FileRefPrivate(file, stream);
+  }
+  else {
+    delete stream;
+    d = new FileRefPrivate(0);
+  }
+}
+
+FileRef::FileRef(IOStream *stream, bool readAudioProperties,
+                 AudioProperties::ReadStyle audioPropertiesStyle, int readOptions)
 {
-  d = new FileRefPrivate(create(fileName, readAudioProperties, audioPropertiesStyle));
+  d = new FileRefPrivate(Formats()->createFile(stream, readAudioProperties, audioPropertiesStyle,
+                                               readOptions));
 }
 
 FileRef::FileRef(File *file)
@@ -133,41 +781,24 @@ bool FileRef::save()
 
 const FileRef::FileTypeResolver *FileRef::addFileTypeResolver(const FileRef::FileTypeResolver *resolver) // static
 {
-  FileRefPrivate::fileTypeResolvers.prepend(resolver);
+  FormatRegistry::instance().addResolver(resolver);
   return resolver;
 }
 
+const FileRef::FileFormat *FileRef::addFileFormat(const FileRef::FileFormat *format) // static
+{
+  FormatRegistry::instance().addFormat(format);
+  return format;
+}
+
 StringList FileRef::defaultFileExtensions()
 {
+  const Formats formats;
   StringList l;
 
-  l.append("ogg");
-  l.append("flac");
-  l.append("oga");
-  l.append("mp3");
-  l.append("mpc");
-  l.append("wv");
-  l.append("spx");
-  l.append("tta");
-  l.append("m4a");
-  l.append("m4r");
-  l.append("m4b");
-  l.append("m4p");
-  l.append("3g2");
-  l.append("mp4");
-  l.append("wma");
-  l.append("asf");
-  l.append("aif");
-  l.append("aiff");
-  l.append("wav");
-  l.append("ape");
-  l.append("mod");
-  l.append("module"); // alias for "mod"
-  l.append("nst"); // alias for "mod"
-  l.append("wow"); // alias for "mod"
-  l.append("s3m");
-  l.append("it");
-  l.append("xm");
+  List<const FileFormat *>::ConstIterator it = formats->formats.begin();
+  for(; it != formats->formats.end(); ++it)
+    l.append((*it)->extensions());
 
   return l;
 }
@@ -204,83 +835,15 @@ bool FileRef::operator!=(const FileRef &ref) const
 File *FileRef::create(FileName fileName, bool readAudioProperties,
                       AudioProperties::ReadStyle audioPropertiesStyle) // static
 {
+  const Formats formats;
 
-  List<const FileTypeResolver *>::ConstIterator it = FileRefPrivate::fileTypeResolvers.begin();
-
-  for(; it != FileRefPrivate::fileTypeResolvers.end(); ++it) {
-    File *file = (*it)->createFile(fileName, readAudioProperties, audioPropertiesStyle);
-    if(file)
-      return file;
-  }
+  File *file = formats->createFile(fileName, readAudioProperties, audioPropertiesStyle);
+  if(file)
+    return file;
 
-  // Ok, this is really dumb for now, but it works for testing.
-
-  String ext;
-  {
-#ifdef _WIN32
-
-    String s = fileName.toString();
-
-#else
-
-    String s = fileName;
-
- #endif
-
-    const int pos = s.rfind(".");
-    if(pos != -1)
-      ext = s.substr(pos + 1).upper();
-  }
-
-  // If this list is updated, the method defaultFileExtensions() should also be
-  // updated.  However at some point that list should be created at the same time
-  // that a default file type resolver is created.
-
-  if(!ext.isEmpty()) {
-    if(ext == "MP3")
-      return new MPEG::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "OGG")
-      return new Ogg::Vorbis::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "OGA") {
-      /* .oga can be any audio in the Ogg container. First try FLAC, then Vorbis. */
-      File *file = new Ogg::FLAC::File(fileName, readAudioProperties, audioPropertiesStyle);
-      if (file->isValid())
-        return file;
-      delete file;
-      return new Ogg::Vorbis::File(fileName, readAudioProperties, audioPropertiesStyle);
-    }
-    if(ext == "FLAC")
-      return new FLAC::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "MPC")
-      return new MPC::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "WV")
-      return new WavPack::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "SPX")
-      return new Ogg::Speex::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "OPUS")
-      return new Ogg::Opus::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "TTA")
-      return new TrueAudio::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "M4A" || ext == "M4R" || ext == "M4B" || ext == "M4P" || ext == "MP4" || ext == "3G2")
-      return new MP4::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "WMA" || ext == "ASF")
-      return new ASF::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "AIF" || ext == "AIFF")
-      return new RIFF::AIFF::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "WAV")
-      return new RIFF::WAV::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "APE")
-      return new APE::File(fileName, readAudioProperties, audioPropertiesStyle);
-    // module, nst and wow are possible but uncommon extensions
-    if(ext == "MOD" || ext == "MODULE" || ext == "NST" || ext == "WOW")
-      return new Mod::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "S3M")
-      return new S3M::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "IT")
-      return new IT::File(fileName, readAudioProperties, audioPropertiesStyle);
-    if(ext == "XM")
-      return new XM::File(fileName, readAudioProperties, audioPropertiesStyle);
-  }
+  const FileFormat *format = formats->formatForExtension(extensionOf(fileName));
+  if(format)
+    return format->createFile(fileName, readAudioProperties, audioPropertiesStyle);
 
   return 0;
 }
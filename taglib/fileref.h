@@ -28,6 +28,7 @@
 
 #include "tfile.h"
 #include "tstringlist.h"
+#include "tbytevectorview.h"
 
 #include "taglib_export.h"
 #include "audioproperties.h"
@@ -101,6 +102,9 @@ namespace TagLib {
        * \note The created file is then owned by the FileRef and should not be
        * deleted.  Deletion will happen automatically when the FileRef passes
        * out of scope.
+       *
+       * \note Resolvers are not given the read options of the FileRef.  A
+       * format added with addFileFormat() is.
        */
       virtual File *createFile(FileName fileName,
                                bool readAudioProperties = true,
@@ -108,6 +112,114 @@ namespace TagLib {
                                audioPropertiesStyle = AudioProperties::Average) const = 0;
     };
 
+  //! A class describing a file format to TagLib's file type detection.
+
+  /*!
+   * Each format known to FileRef is described by a FileFormat: the file name
+   * extensions that it uses, an optional signature that identifies its
+   * content and the factory methods that create a File for it.  TagLib's own
+   * formats are described the same way, and further formats can be added with
+   * addFileFormat():
+   *
+   * \code
+   *
+   * class MyFileFormat : public FileRef::FileFormat
+   * {
+   *   StringList extensions() const { return StringList("xyz"); }
+   *   uint signatureLength() const { return 4; }
+   *   bool isSignature(const ByteVectorView &data) const { return data.startsWith("XYZ!"); }
+   *   File *createFile(FileName fileName, bool, AudioProperties::ReadStyle) const
+   *   {
+   *     return new MyFile(fileName);
+   *   }
+   *   File *createFile(IOStream *stream, bool, AudioProperties::ReadStyle) const
+   *   {
+   *     return new MyFile(stream);
+   *   }
+   * };
+   *
+   * FileRef::addFileFormat(new MyFileFormat);
+   *
+   * \endcode
+   *
+   * The content of a file is matched against the signatures from the shortest
+   * to the longest, so cheap checks come first.  The extension of the file
+   * name is only used if no signature matches.
+   */
+
+    class TAGLIB_EXPORT FileFormat
+    {
+    public:
+      virtual ~FileFormat();
+
+      /*!
+       * Returns the file name extensions used by this format, in lowercase and
+       * without the leading dot.
+       */
+      virtual StringList extensions() const = 0;
+
+      /*!
+       * Returns the number of bytes at the start of the content that
+       * isSignature() needs to see.  The default implementation returns 0,
+       * which means that the format has no signature and can only be detected
+       * by the extension.
+       */
+      virtual uint signatureLength() const;
+
+      /*!
+       * Returns true if a match of the signature is only a hint, like the sync
+       * word of an MPEG frame, which may as well show up in other data.  Weak
+       * signatures are only tried if no other signature matched.  The default
+       * implementation returns false.
+       */
+      virtual bool hasWeakSignature() const;
+
+      /*!
+       * Returns true if \a data, the first bytes of the content, carries the
+       * signature of this format.  \a data is at least signatureLength()
+       * bytes long.  If the file starts with an ID3v2 tag, \a data starts
+       * behind it.  The default implementation returns false.
+       */
+      virtual bool isSignature(const ByteVectorView &data) const;
+
+      /*!
+       * Creates a File of this format for \a fileName.
+       *
+       * \see FileRef::create()
+       */
+      virtual File *createFile(FileName fileName,
+                               bool readAudioProperties,
+                               AudioProperties::ReadStyle audioPropertiesStyle) const = 0;
+
+      /*!
+       * Creates a File of this format reading from \a stream, which is
+       * positioned at its start.  The stream is not owned by the File.
+       */
+      virtual File *createFile(IOStream *stream,
+                               bool readAudioProperties,
+                               AudioProperties::ReadStyle audioPropertiesStyle) const = 0;
+
+      /*!
+       * Creates a File of this format for \a fileName, read with
+       * \a readOptions, a combination of File::ReadOption values.  The default
+       * implementation ignores \a readOptions and calls the above method.
+       */
+      virtual File *createFile(FileName fileName,
+                               bool readAudioProperties,
+                               AudioProperties::ReadStyle audioPropertiesStyle,
+                               int readOptions) const;
+
+      /*!
+       * Creates a File of this format reading from \a stream with
+       * \a readOptions.  The default implementation ignores \a readOptions
+       * and calls the above method.
+       */
+      virtual File *createFile(IOStream *stream,
+                               bool readAudioProperties,
+                               AudioProperties::ReadStyle audioPropertiesStyle,
+                               int readOptions) const;
+    };
+
     /*!
      * Creates a null FileRef.
      */
@@ -119,13 +231,40 @@ namespace TagLib {
      * \a readAudioProperties is false then \a audioPropertiesStyle will be
      * ignored.
      *
+     * Unless one of the added FileTypeResolvers claims the file, the type of
+     * the file is detected from its content; the extension is only used if the
+     * content is not conclusive.
+     *
+     * \a readOptions is a combination of File::ReadOption values, which are
+     * passed on to the formats that support them.  FileTypeResolvers do not
+     * see them.  For a scan of the tags only, pass false for
+     * \a readAudioProperties and File::DeferBinaryData.
+     *
      * Also see the note in the class documentation about why you may not want to
      * use this method in your application.
      */
     explicit FileRef(FileName fileName,
                      bool readAudioProperties = true,
                      AudioProperties::ReadStyle
-                     audioPropertiesStyle = AudioProperties::Average);
+                     audioPropertiesStyle = AudioProperties::Average,
+                     int readOptions = File::ReadAll);
+
+    /*!
+     * Create a FileRef from \a stream.  The type of the file is detected from
+     * the first bytes of the stream, and the extension of its name is used only
+     * if the content is not conclusive.  FileTypeResolvers are not consulted.
+     *
+     * \note TagLib will *not* take ownership of the stream, the caller is
+     * responsible for deleting it after the FileRef and all its copies have
+     * passed out of scope.
+     *
+     * \a readOptions is a combination of File::ReadOption values.
+     */
+    explicit FileRef(IOStream *stream,
+                     bool readAudioProperties = true,
+                     AudioProperties::ReadStyle
+                     audioPropertiesStyle = AudioProperties::Average,
+                     int readOptions = File::ReadAll);
 
     /*!
      * Contruct a FileRef using \a file.  The FileRef now takes ownership of the
@@ -190,6 +329,8 @@ namespace TagLib {
      * that are tried.  If the FileTypeResolver returns zero the next resolver
      * is tried.
      *
+     * This may be called while other threads create FileRefs.
+     *
      * Returns a pointer to the added resolver (the same one that's passed in --
      * this is mostly so that static inialializers have something to use for
      * assignment).
@@ -199,11 +340,23 @@ namespace TagLib {
     static const FileTypeResolver *addFileTypeResolver(const FileTypeResolver *resolver);
 
     /*!
-     * As is mentioned elsewhere in this class's documentation, the default file
-     * type resolution code provided by TagLib only works by comparing file
-     * extensions.
+     * Adds \a format to the formats that TagLib detects.  Its extensions take
+     * precedence over those of the formats that were added before, including
+     * TagLib's own, and its signature is tried before other signatures of the
+     * same length.  The format is not owned by TagLib and must stay alive as
+     * long as it may be used.
+     *
+     * This may be called while other threads create FileRefs.
      *
-     * This method returns the list of file extensions that are used by default.
+     * Returns a pointer to the added format, like addFileTypeResolver().
+     *
+     * \see FileFormat
+     */
+    static const FileFormat *addFileFormat(const FileFormat *format);
+
+    /*!
+     * Returns the list of file extensions of the formats that TagLib knows,
+     * followed by those of the formats added with addFileFormat().
      *
      * The extensions are all returned in lowercase, though the comparison used
      * by TagLib for resolution is case-insensitive.
@@ -213,6 +366,7 @@ namespace TagLib {
      * mime-type resolution system, but is just here for reference.
      *
      * \see FileTypeResolver
+     * \see FileFormat
      */
     static StringList defaultFileExtensions();
 
@@ -238,10 +392,11 @@ namespace TagLib {
     bool operator!=(const FileRef &ref) const;
 
     /*!
-     * A simple implementation of file type guessing.  If \a readAudioProperties
-     * is true then the audio properties will be read using
-     * \a audioPropertiesStyle.  If \a readAudioProperties is false then
-     * \a audioPropertiesStyle will be ignored.
+     * A simple implementation of file type guessing, which looks only at the
+     * extension of \a fileName.  If \a readAudioProperties is true then the
+     * audio properties will be read using \a audioPropertiesStyle.  If
+     * \a readAudioProperties is false then \a audioPropertiesStyle will be
+     * ignored.
      *
      * \note You generally shouldn't use this method, but instead the constructor
      * directly.
@@ -47,6 +47,7 @@ namespace
   enum { FlacXiphIndex = 0, FlacID3v2Index = 1, FlacID3v1Index = 2 };
   enum { MinPaddingLength = 4096 };
   enum { LastBlockFlag = 0x80 };
+  enum { DeferredPictureSize = 4096, PictureFieldsSize = 1024 };
 }
 
 class FLAC::File::FilePrivate
@@ -105,8 +106,9 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 FLAC::File::File(FileName file, bool readProperties,
-                 Properties::ReadStyle propertiesStyle) :
-  TagLib::File(file)
+                 Properties::ReadStyle propertiesStyle,
+                 int readOptions) :
+  TagLib::File(file, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -114,8 +116,9 @@ FLAC::File::File(FileName file, bool readProperties,
 }
 
 FLAC::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle propertiesStyle) :
-  TagLib::File(file)
+                 bool readProperties, Properties::ReadStyle propertiesStyle,
+                 int readOptions) :
+  TagLib::File(file, readOptions)
 {
   d = new FilePrivate;
   d->ID3v2FrameFactory = frameFactory;
@@ -124,8 +127,9 @@ FLAC::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
 }
 
 FLAC::File::File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle propertiesStyle) :
-  TagLib::File(stream)
+                 bool readProperties, Properties::ReadStyle propertiesStyle,
+                 int readOptions) :
+  TagLib::File(stream, readOptions)
 {
   d = new FilePrivate;
   d->ID3v2FrameFactory = frameFactory;
@@ -184,6 +188,11 @@ bool FLAC::File::save()
     return false;
   }
 
+  if(readInPart()) {
+    debug("FLAC::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   if(!isValid()) {
     debug("FLAC::File::save() -- Trying to save invalid file.");
     return false;
@@ -243,9 +252,9 @@ bool FLAC::File::save()
   padding[0] = (char)(FLAC::MetadataBlock::Padding | LastBlockFlag);
   data.append(padding);
 
-  // Write the data to the file
+  // Write the data to the file, together with the ID3v2 tag in one pass
 
-  insert(data, d->flacStart, originalLength);
+  queueInsert(data, d->flacStart, originalLength);
   d->hasXiphComment = true;
 
   // Update ID3 tags
@@ -256,12 +265,14 @@ bool FLAC::File::save()
         debug("FLAC::File::save() -- This can't be right -- an ID3v2 tag after the "
               "start of the FLAC bytestream?  Not writing the ID3v2 tag.");
       else
-        insert(ID3v2Tag()->render(), d->ID3v2Location, d->ID3v2OriginalSize);
+        queueInsert(ID3v2Tag()->render(), d->ID3v2Location, d->ID3v2OriginalSize);
     }
     else
-      insert(ID3v2Tag()->render(), 0, 0);
+      queueInsert(ID3v2Tag()->render(), 0, 0);
   }
 
+  commitEdits();
+
   if(ID3v1Tag()) {
     seek(-128, End);
     writeBlock(ID3v1Tag()->render());
@@ -307,7 +318,8 @@ void FLAC::File::read(bool readProperties, Properties::ReadStyle propertiesStyle
 
   if(d->ID3v2Location >= 0) {
 
-    d->tag.set(FlacID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory));
+    d->tag.set(FlacID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory,
+                                              readOptions()));
 
     d->ID3v2OriginalSize = ID3v2Tag()->header()->completeTagSize();
 
@@ -334,7 +346,7 @@ void FLAC::File::read(bool readProperties, Properties::ReadStyle propertiesStyle
     return;
 
   if(d->hasXiphComment)
-    d->tag.set(FlacXiphIndex, new Ogg::XiphComment(xiphCommentData()));
+    d->tag.set(FlacXiphIndex, new Ogg::XiphComment(xiphCommentData(), readOptions()));
   else
     d->tag.set(FlacXiphIndex, new Ogg::XiphComment);
 
@@ -421,39 +433,58 @@ void FLAC::File::scan()
     isLastBlock = (header[0] & 0x80) != 0;
     length = header.toUInt(1U, 3U);
 
-    ByteVector data = readBlock(length);
-    if(data.size() != length || length == 0) {
-      debug("FLAC::File::scan() -- FLAC stream corrupted");
-      setValid(false);
-      return;
-    }
-
     MetadataBlock *block = 0;
 
-    // Found the vorbis-comment
-    if(blockType == MetadataBlock::VorbisComment) {
-      if(!d->hasXiphComment) {
-        d->xiphCommentData = data;
-        d->hasXiphComment = true;
-      }
-      else {
-        debug("FLAC::File::scan() -- multiple Vorbis Comment blocks found, using the first one");
-      }
-    }
-    else if(blockType == MetadataBlock::Picture) {
+    // Leave the data of large pictures in the file, if they are parsed from
+    // their first bytes.
+
+    if(blockType == MetadataBlock::Picture && length > DeferredPictureSize &&
+       (readOptions() & DeferBinaryData))
+    {
       FLAC::Picture *picture = new FLAC::Picture();
-      if(picture->parse(data)) {
+      if(picture->parse(readBlock(PictureFieldsSize), this, nextBlockOffset + 4, length)) {
         block = picture;
       }
       else {
-        debug("FLAC::File::scan() -- invalid picture found, discarting");
         delete picture;
+        seek(nextBlockOffset + 4);
       }
     }
 
     if(!block) {
-      block = new UnknownMetadataBlock(blockType, data);
+      ByteVector data = readBlock(length);
+      if(data.size() != length || length == 0) {
+        debug("FLAC::File::scan() -- FLAC stream corrupted");
+        setValid(false);
+        return;
+      }
+
+      // Found the vorbis-comment
+      if(blockType == MetadataBlock::VorbisComment) {
+        if(!d->hasXiphComment) {
+          d->xiphCommentData = data;
+          d->hasXiphComment = true;
+        }
+        else {
+          debug("FLAC::File::scan() -- multiple Vorbis Comment blocks found, using the first one");
+        }
+      }
+      else if(blockType == MetadataBlock::Picture) {
+        FLAC::Picture *picture = new FLAC::Picture();
+        if(picture->parse(data)) {
+          block = picture;
+        }
+        else {
+          debug("FLAC::File::scan() -- invalid picture found, discarting");
+          delete picture;
+        }
+      }
+
+      if(!block) {
+        block = new UnknownMetadataBlock(blockType, data);
+      }
     }
+
     if(block->code() != MetadataBlock::Padding) {
       d->blocks.append(block);
     }
@@ -74,9 +74,12 @@ namespace TagLib {
        *
        * \deprecated This constructor will be dropped in favor of the one below
        * in a future version.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(FileName file, bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Constructs an APE file from \a file.  If \a readProperties is true the
@@ -86,11 +89,14 @@ namespace TagLib {
        * \a frameFactory.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       // BIC: merge with the above constructor
       File(FileName file, ID3v2::FrameFactory *frameFactory,
            bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Constructs a FLAC file from \a stream.  If \a readProperties is true the
@@ -103,11 +109,14 @@ namespace TagLib {
        * \a frameFactory.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       // BIC: merge with the above constructor
       File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
            bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Destroys this instance of the File.
@@ -130,9 +139,9 @@ namespace TagLib {
        * only the first one (in the order XiphComment, ID3v2, ID3v1) will be
        * converted to the PropertyMap.
        */
-      PropertyMap properties() const;
+      virtual PropertyMap properties() const;
 
-      void removeUnsupportedProperties(const StringList &);
+      virtual void removeUnsupportedProperties(const StringList &);
 
       /*!
        * Implements the unified property interface -- import function.
@@ -141,7 +150,7 @@ namespace TagLib {
        * Ignores any changes to ID3v1 or ID3v2 comments since they are not allowed
        * in the FLAC specification.
        */
-      PropertyMap setProperties(const PropertyMap &);
+      virtual PropertyMap setProperties(const PropertyMap &);
 
       /*!
        * Returns the FLAC::Properties for this file.  If no audio properties
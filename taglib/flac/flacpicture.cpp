@@ -25,6 +25,7 @@
 
 #include <taglib.h>
 #include <tdebug.h>
+#include <tdeferreddata.h>
 #include "flacpicture.h"
 
 using namespace TagLib;
@@ -47,7 +48,7 @@ public:
   int height;
   int colorDepth;
   int numColors;
-  ByteVector data;
+  DeferredData data;
 };
 
 FLAC::Picture::Picture()
@@ -73,45 +74,16 @@ int FLAC::Picture::code() const
 
 bool FLAC::Picture::parse(const ByteVector &data)
 {
-  if(data.size() < 32) {
-    debug("A picture block must contain at least 5 bytes.");
+  const uint pos = parseFields(data);
+  if(pos == 0)
     return false;
-  }
 
-  uint pos = 0;
-  d->type = FLAC::Picture::Type(data.toUInt(pos));
-  pos += 4;
-  uint mimeTypeLength = data.toUInt(pos);
-  pos += 4;
-  if(pos + mimeTypeLength + 24 > data.size()) {
-    debug("Invalid picture block.");
-    return false;
-  }
-  d->mimeType = String(data.mid(pos, mimeTypeLength), String::UTF8);
-  pos += mimeTypeLength;
-  uint descriptionLength = data.toUInt(pos);
-  pos += 4;
-  if(pos + descriptionLength + 20 > data.size()) {
-    debug("Invalid picture block.");
-    return false;
-  }
-  d->description = String(data.mid(pos, descriptionLength), String::UTF8);
-  pos += descriptionLength;
-  d->width = data.toUInt(pos);
-  pos += 4;
-  d->height = data.toUInt(pos);
-  pos += 4;
-  d->colorDepth = data.toUInt(pos);
-  pos += 4;
-  d->numColors = data.toUInt(pos);
-  pos += 4;
-  uint dataLength = data.toUInt(pos);
-  pos += 4;
+  const uint dataLength = data.toUInt(pos - 4);
   if(pos + dataLength > data.size()) {
     debug("Invalid picture block.");
     return false;
   }
-  d->data = data.mid(pos, dataLength);
+  d->data.setData(data.mid(pos, dataLength));
 
   return true;
 }
@@ -131,7 +103,7 @@ ByteVector FLAC::Picture::render() const
   result.append(ByteVector::fromUInt(d->colorDepth));
   result.append(ByteVector::fromUInt(d->numColors));
   result.append(ByteVector::fromUInt(d->data.size()));
-  result.append(d->data);
+  result.append(d->data.data());
   return result;
 }
 
@@ -207,11 +179,72 @@ void FLAC::Picture::setNumColors(int numColors)
 
 ByteVector FLAC::Picture::data() const
 {
-  return d->data;
+  return d->data.data();
 }
 
 void FLAC::Picture::setData(const ByteVector &data)
 {
-  d->data = data;
+  d->data.setData(data);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// private members
+////////////////////////////////////////////////////////////////////////////////
+
+bool FLAC::Picture::parse(const ByteVector &fields, TagLib::File *file, long offset, uint length)
+{
+  const uint pos = parseFields(fields);
+  if(pos == 0)
+    return false;
+
+  const uint dataLength = fields.toUInt(pos - 4);
+  if(pos + dataLength > length) {
+    debug("Invalid picture block.");
+    return false;
+  }
+  d->data.defer(file, offset + pos, dataLength);
+
+  return true;
+}
+
+TagLib::uint FLAC::Picture::parseFields(const ByteVector &data)
+{
+  if(data.size() < 32) {
+    debug("A picture block must contain at least 5 bytes.");
+    return 0;
+  }
+
+  uint pos = 0;
+  d->type = FLAC::Picture::Type(data.toUInt(pos));
+  pos += 4;
+  uint mimeTypeLength = data.toUInt(pos);
+  pos += 4;
+  if(pos + mimeTypeLength + 24 > data.size()) {
+    debug("Invalid picture block.");
+    return 0;
+  }
+  d->mimeType = String(data.mid(pos, mimeTypeLength), String::UTF8);
+  pos += mimeTypeLength;
+  uint descriptionLength = data.toUInt(pos);
+  pos += 4;
+  if(pos + descriptionLength + 20 > data.size()) {
+    debug("Invalid picture block.");
+    return 0;
+  }
+  d->description = String(data.mid(pos, descriptionLength), String::UTF8);
+  pos += descriptionLength;
+  d->width = data.toUInt(pos);
+  pos += 4;
+  d->height = data.toUInt(pos);
+  pos += 4;
+  d->colorDepth = data.toUInt(pos);
+  pos += 4;
+  d->numColors = data.toUInt(pos);
+  pos += 4;
+
+  // Skip the length of the data, which is read by the caller.
+
+  pos += 4;
+
+  return pos;
+}
@@ -34,6 +34,8 @@
 
 namespace TagLib {
 
+  class File;
+
   namespace FLAC {
 
     class TAGLIB_EXPORT Picture : public MetadataBlock
@@ -195,6 +197,17 @@ namespace TagLib {
       Picture(const Picture &item);
       Picture &operator=(const Picture &item);
 
+      friend class File;
+
+      /*
+       * Parses a picture block of \a length bytes at \a offset in \a file
+       * from its first bytes, \a fields, and leaves the image data in the file
+       * until it is used.  Returns false if the fields do not fit in \a fields.
+       */
+      bool parse(const ByteVector &fields, TagLib::File *file, long offset, uint length);
+
+      uint parseFields(const ByteVector &data);
+
       class PicturePrivate;
       PicturePrivate *d;
     };
@@ -69,15 +69,13 @@ namespace TagLib {
 
         /*!
          * Forwards to Mod::Tag::properties().
-         * BIC: will be removed once File::toDict() is made virtual
          */
-        PropertyMap properties() const;
+        virtual PropertyMap properties() const;
 
         /*!
          * Forwards to Mod::Tag::setProperties().
-         * BIC: will be removed once File::setProperties() is made virtual
          */
-        PropertyMap setProperties(const PropertyMap &);
+        virtual PropertyMap setProperties(const PropertyMap &);
 
         /*!
          * Returns the IT::Properties for this file. If no audio properties
@@ -72,13 +72,13 @@ namespace TagLib {
        * Implements the unified property interface -- export function.
        * Forwards to Mod::Tag::properties().
        */
-      PropertyMap properties() const;
+      virtual PropertyMap properties() const;
 
       /*!
        * Implements the unified property interface -- import function.
        * Forwards to Mod::Tag::setProperties().
        */
-      PropertyMap setProperties(const PropertyMap &);
+      virtual PropertyMap setProperties(const PropertyMap &);
       /*!
        * Returns the Mod::Properties for this file. If no audio properties
        * were read then this will return a null pointer.
@@ -26,6 +26,7 @@
 #include <taglib.h>
 #include <tdebug.h>
 #include "trefcounter.h"
+#include "tdeferreddata.h"
 #include "mp4coverart.h"
 
 using namespace TagLib;
@@ -36,14 +37,21 @@ public:
   CoverArtPrivate() : RefCounter(), format(MP4::CoverArt::JPEG) {}
 
   Format format;
-  ByteVector data;
+  DeferredData data;
 };
 
 MP4::CoverArt::CoverArt(Format format, const ByteVector &data)
 {
   d = new CoverArtPrivate;
   d->format = format;
-  d->data = data;
+  d->data.setData(data);
+}
+
+MP4::CoverArt::CoverArt(Format format, File *file, long offset, uint length)
+{
+  d = new CoverArtPrivate;
+  d->format = format;
+  d->data.defer(file, offset, length);
 }
 
 MP4::CoverArt::CoverArt(const CoverArt &item) : d(item.d)
@@ -78,6 +86,6 @@ MP4::CoverArt::format() const
 ByteVector
 MP4::CoverArt::data() const
 {
-  return d->data;
+  return d->data.data();
 }
 
@@ -62,6 +62,14 @@ namespace TagLib {
       ByteVector data() const;
 
     private:
+      friend class Tag;
+
+      /*
+       * Constructs cover art whose \a length bytes of data at \a offset in
+       * \a file are read when they are used.
+       */
+      CoverArt(Format format, File *file, long offset, uint length);
+
       class CoverArtPrivate;
       CoverArtPrivate *d;
     };
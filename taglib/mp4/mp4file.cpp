@@ -60,16 +60,18 @@ public:
   MP4::Properties *properties;
 };
 
-MP4::File::File(FileName file, bool readProperties, AudioProperties::ReadStyle audioPropertiesStyle)
-    : TagLib::File(file)
+MP4::File::File(FileName file, bool readProperties, AudioProperties::ReadStyle audioPropertiesStyle,
+                int readOptions)
+    : TagLib::File(file, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
     read(readProperties, audioPropertiesStyle);
 }
 
-MP4::File::File(IOStream *stream, bool readProperties, AudioProperties::ReadStyle audioPropertiesStyle)
-    : TagLib::File(stream)
+MP4::File::File(IOStream *stream, bool readProperties, AudioProperties::ReadStyle audioPropertiesStyle,
+                int readOptions)
+    : TagLib::File(stream, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -139,7 +141,7 @@ MP4::File::read(bool readProperties, Properties::ReadStyle audioPropertiesStyle)
     return;
   }
 
-  d->tag = new Tag(this, d->atoms);
+  d->tag = new Tag(this, d->atoms, readOptions());
   if(readProperties) {
     d->properties = new Properties(this, d->atoms, audioPropertiesStyle);
   }
@@ -153,6 +155,11 @@ MP4::File::save()
     return false;
   }
 
+  if(readInPart()) {
+    debug("MP4::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   if(!isValid()) {
     debug("MP4::File::save() -- Trying to save invalid file.");
     return false;
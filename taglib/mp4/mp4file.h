@@ -53,9 +53,12 @@ namespace TagLib {
        * file's audio properties will also be read.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(FileName file, bool readProperties = true, 
-           Properties::ReadStyle audioPropertiesStyle = Properties::Average);
+           Properties::ReadStyle audioPropertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Constructs an MP4 file from \a stream.  If \a readProperties is true the
@@ -65,9 +68,12 @@ namespace TagLib {
        * responsible for deleting it after the File object.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(IOStream *stream, bool readProperties = true, 
-           Properties::ReadStyle audioPropertiesStyle = Properties::Average);
+           Properties::ReadStyle audioPropertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Destroys this instance of the File.
@@ -89,18 +95,18 @@ namespace TagLib {
       /*!
        * Implements the unified property interface -- export function.
        */
-      PropertyMap properties() const;
+      virtual PropertyMap properties() const;
 
       /*!
        * Removes unsupported properties. Forwards to the actual Tag's
        * removeUnsupportedProperties() function.
        */
-      void removeUnsupportedProperties(const StringList &properties);
+      virtual void removeUnsupportedProperties(const StringList &properties);
 
       /*!
        * Implements the unified property interface -- import function.
        */
-      PropertyMap setProperties(const PropertyMap &);
+      virtual PropertyMap setProperties(const PropertyMap &);
 
       /*!
        * Returns the MP4 audio properties for this file.
@@ -32,13 +32,49 @@
 
 using namespace TagLib;
 
+namespace
+{
+  // The items which carry the basic fields.
+
+  const struct {
+    const char *name;
+    int field;
+  } fieldAtoms[] = {
+    { "\251nam", TagLib::File::ReadTitle },
+    { "\251ART", TagLib::File::ReadArtist },
+    { "\251alb", TagLib::File::ReadAlbum },
+    { "\251cmt", TagLib::File::ReadComment },
+    { "\251gen", TagLib::File::ReadGenre },
+    { "gnre",    TagLib::File::ReadGenre },
+    { "\251day", TagLib::File::ReadYear },
+    { "trkn",    TagLib::File::ReadTrack }
+  };
+
+  // Returns true if the item atom carries one of the fields in readOptions,
+  // or if all fields are read.
+
+  bool isRequestedAtom(const MP4::Atom *atom, int readOptions)
+  {
+    if(!(readOptions & TagLib::File::ReadBasicFields))
+      return true;
+
+    for(size_t i = 0; i < sizeof(fieldAtoms) / sizeof(fieldAtoms[0]); ++i) {
+      if((readOptions & fieldAtoms[i].field) && atom->name == fieldAtoms[i].name)
+        return true;
+    }
+
+    return false;
+  }
+}
+
 class MP4::Tag::TagPrivate
 {
 public:
-  TagPrivate() : file(0), atoms(0) {}
+  TagPrivate() : file(0), atoms(0), readOptions(TagLib::File::ReadAll) {}
   ~TagPrivate() {}
   TagLib::File *file;
   Atoms *atoms;
+  int readOptions;
   ItemListMap items;
 };
 
@@ -47,11 +83,12 @@ MP4::Tag::Tag()
   d = new TagPrivate;
 }
 
-MP4::Tag::Tag(TagLib::File *file, MP4::Atoms *atoms)
+MP4::Tag::Tag(TagLib::File *file, MP4::Atoms *atoms, int readOptions)
 {
   d = new TagPrivate;
   d->file = file;
   d->atoms = atoms;
+  d->readOptions = readOptions;
 
   MP4::Atom *ilst = atoms->find("moov", "udta", "meta", "ilst");
   if(!ilst) {
@@ -61,6 +98,9 @@ MP4::Tag::Tag(TagLib::File *file, MP4::Atoms *atoms)
 
   for(unsigned int i = 0; i < ilst->children.size(); i++) {
     MP4::Atom *atom = ilst->children[i];
+    if(!isRequestedAtom(atom, readOptions)) {
+      continue;
+    }
     file->seek(atom->offset + 8);
     if(atom->name == "----") {
       parseFreeForm(atom, file);
@@ -89,7 +129,10 @@ MP4::Tag::Tag(TagLib::File *file, MP4::Atoms *atoms)
       parseGnre(atom, file);
     }
     else if(atom->name == "covr") {
-      parseCovr(atom, file);
+      if(readOptions & TagLib::File::DeferBinaryData)
+        parseDeferredCovr(atom, file);
+      else
+        parseCovr(atom, file);
     }
     else {
       parseText(atom, file);
@@ -107,12 +150,13 @@ MP4::Tag::parseData2(MP4::Atom *atom, TagLib::File *file, int expectedFlags, boo
 {
   AtomDataList result;
   ByteVector data = file->readBlock(atom->length - 8);
+  const ByteVectorView view(data);
   int i = 0;
   unsigned int pos = 0;
   while(pos < data.size()) {
-    const int length = static_cast<int>(data.toUInt(pos));
-    ByteVector name = data.mid(pos + 4, 4);
-    const int flags = static_cast<int>(data.toUInt(pos + 8));
+    const int length = static_cast<int>(view.toUInt(pos));
+    const ByteVectorView name = view.mid(pos + 4, 4);
+    const int flags = static_cast<int>(view.toUInt(pos + 8));
     if(freeForm && i < 2) {
       if(i == 0 && name != "mean") {
         debug("MP4: Unexpected atom \"" + name + "\", expecting \"mean\"");
@@ -271,11 +315,12 @@ MP4::Tag::parseCovr(MP4::Atom *atom, TagLib::File *file)
 {
   MP4::CoverArtList value;
   ByteVector data = file->readBlock(atom->length - 8);
+  const ByteVectorView view(data);
   unsigned int pos = 0;
   while(pos < data.size()) {
-    const int length = static_cast<int>(data.toUInt(pos));
-    ByteVector name = data.mid(pos + 4, 4);
-    const int flags = static_cast<int>(data.toUInt(pos + 8));
+    const int length = static_cast<int>(view.toUInt(pos));
+    const ByteVectorView name = view.mid(pos + 4, 4);
+    const int flags = static_cast<int>(view.toUInt(pos + 8));
     if(name != "data") {
       debug("MP4: Unexpected atom \"" + name + "\", expecting \"data\"");
       break;
@@ -293,6 +338,45 @@ MP4::Tag::parseCovr(MP4::Atom *atom, TagLib::File *file)
     addItem(atom->name, value);
 }
 
+void
+MP4::Tag::parseDeferredCovr(MP4::Atom *atom, TagLib::File *file)
+{
+  // Like parseCovr(), but reads only the headers of the data atoms and leaves
+  // the images in the file until they are used.
+
+  MP4::CoverArtList value;
+  const long end = atom->offset + atom->length;
+  long offset = atom->offset + 8;
+  while(offset + 16 <= end) {
+    file->seek(offset);
+    const ByteVector header = file->readBlock(16);
+    if(header.size() < 16) {
+      break;
+    }
+    const ByteVectorView view(header);
+    const uint length = view.toUInt(0U);
+    const ByteVectorView name = view.mid(4, 4);
+    const int flags = static_cast<int>(view.toUInt(8U));
+    if(name != "data") {
+      debug("MP4: Unexpected atom \"" + name + "\", expecting \"data\"");
+      break;
+    }
+    if(length < 16 || length > ulong(end - offset)) {
+      debug("MP4: Invalid covr data atom length");
+      break;
+    }
+    if(flags == TypeJPEG || flags == TypePNG || flags == TypeBMP || flags == TypeGIF || flags == TypeImplicit) {
+      value.append(MP4::CoverArt(MP4::CoverArt::Format(flags), file, offset + 16, length - 16));
+    }
+    else {
+      debug("MP4: Unknown covr format " + String::number(flags));
+    }
+    offset += length;
+  }
+  if(value.size() > 0)
+    addItem(atom->name, value);
+}
+
 ByteVector
 MP4::Tag::padIlst(const ByteVector &data, int length)
 {
@@ -805,15 +889,18 @@ static const char *keyTranslation[][2] = {
   { "----:com.apple.iTunes:MEDIA", "MEDIA" },
 };
 
+static Map<String, String> keyTranslationMap(int from, int to)
+{
+  Map<String, String> m;
+  const int numKeys = sizeof(keyTranslation) / sizeof(keyTranslation[0]);
+  for(int i = 0; i < numKeys; i++)
+    m.insert(keyTranslation[i][from], keyTranslation[i][to]);
+  return m;
+}
+
 PropertyMap MP4::Tag::properties() const
 {
-  static Map<String, String> keyMap;
-  if(keyMap.isEmpty()) {
-    int numKeys = sizeof(keyTranslation) / sizeof(keyTranslation[0]);
-    for(int i = 0; i < numKeys; i++) {
-      keyMap[keyTranslation[i][0]] = keyTranslation[i][1];
-    }
-  }
+  static const Map<String, String> keyMap = keyTranslationMap(0, 1);
 
   PropertyMap props;
   MP4::ItemListMap::ConstIterator it = d->items.begin();
@@ -854,13 +941,7 @@ void MP4::Tag::removeUnsupportedProperties(const StringList &props)
 
 PropertyMap MP4::Tag::setProperties(const PropertyMap &props)
 {
-  static Map<String, String> reverseKeyMap;
-  if(reverseKeyMap.isEmpty()) {
-    int numKeys = sizeof(keyTranslation) / sizeof(keyTranslation[0]);
-    for(int i = 0; i < numKeys; i++) {
-      reverseKeyMap[keyTranslation[i][1]] = keyTranslation[i][0];
-    }
-  }
+  static const Map<String, String> reverseKeyMap = keyTranslationMap(1, 0);
 
   PropertyMap origProps = properties();
   PropertyMap::ConstIterator it = origProps.begin();
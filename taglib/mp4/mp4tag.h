@@ -45,7 +45,8 @@ namespace TagLib {
     {
     public:
         Tag();
-        Tag(TagLib::File *file, Atoms *atoms);
+        Tag(TagLib::File *file, Atoms *atoms,
+            int readOptions = TagLib::File::ReadAll);
         ~Tag();
         bool save();
 
@@ -84,6 +85,7 @@ namespace TagLib {
         void parseIntPair(Atom *atom, TagLib::File *file);
         void parseBool(Atom *atom, TagLib::File *file);
         void parseCovr(Atom *atom, TagLib::File *file);
+        void parseDeferredCovr(Atom *atom, TagLib::File *file);
 
         TagLib::ByteVector padIlst(const ByteVector &data, int length = -1);
         TagLib::ByteVector renderAtom(const ByteVector &name, const TagLib::ByteVector &data);
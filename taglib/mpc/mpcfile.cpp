@@ -91,7 +91,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 MPC::File::File(FileName file, bool readProperties,
-                Properties::ReadStyle propertiesStyle) : TagLib::File(file)
+                Properties::ReadStyle propertiesStyle,
+                int readOptions) : TagLib::File(file, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -99,7 +100,8 @@ MPC::File::File(FileName file, bool readProperties,
 }
 
 MPC::File::File(IOStream *stream, bool readProperties,
-                Properties::ReadStyle propertiesStyle) : TagLib::File(stream)
+                Properties::ReadStyle propertiesStyle,
+                int readOptions) : TagLib::File(stream, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -152,6 +154,11 @@ bool MPC::File::save()
     return false;
   }
 
+  if(readInPart()) {
+    debug("MPC::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   // Possibly strip ID3v2 tag
 
   if(d->hasID3v2 && !d->ID3v2Header) {
@@ -288,7 +295,7 @@ void MPC::File::read(bool readProperties, Properties::ReadStyle /* propertiesSty
   d->APELocation = findAPE();
 
   if(d->APELocation >= 0) {
-    d->tag.set(MPCAPEIndex, new APE::Tag(this, d->APELocation));
+    d->tag.set(MPCAPEIndex, new APE::Tag(this, d->APELocation, readOptions()));
 
     d->APESize = APETag()->footer()->completeTagSize();
     d->APELocation = d->APELocation + APETag()->footer()->size() - d->APESize;
@@ -88,9 +88,12 @@ namespace TagLib {
        * file's audio properties will also be read.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(FileName file, bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Constructs an MPC file from \a stream.  If \a readProperties is true the
@@ -100,9 +103,12 @@ namespace TagLib {
        * responsible for deleting it after the File object.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(IOStream *stream, bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Destroys this instance of the File.
@@ -120,16 +126,16 @@ namespace TagLib {
        * If the file contains both an APE and an ID3v1 tag, only the APE
        * tag  will be converted to the PropertyMap.
        */
-      PropertyMap properties() const;
+      virtual PropertyMap properties() const;
 
-      void removeUnsupportedProperties(const StringList &properties);
+      virtual void removeUnsupportedProperties(const StringList &properties);
 
       /*!
        * Implements the unified property interface -- import function.
        * Affects only the APEv2 tag which will be created if necessary.
        * If an ID3v1 tag exists, it will be updated as well.
        */
-      PropertyMap setProperties(const PropertyMap &);
+      virtual PropertyMap setProperties(const PropertyMap &);
 
       /*!
        * Returns the MPC::Properties for this file.  If no audio properties
@@ -181,26 +181,34 @@ namespace TagLib {
       "Jpop",
       "Synthpop"
     };
+
+    static StringList makeGenreList()
+    {
+      StringList l;
+      for(int i = 0; i < genresSize; i++)
+        l.append(genres[i]);
+      return l;
+    }
+
+    static GenreMap makeGenreMap()
+    {
+      GenreMap m;
+      for(int i = 0; i < genresSize; i++)
+        m.insert(genres[i], i);
+      return m;
+    }
   }
 }
 
 StringList ID3v1::genreList()
 {
-  static StringList l;
-  if(l.isEmpty()) {
-    for(int i = 0; i < genresSize; i++)
-      l.append(genres[i]);
-  }
+  static const StringList l = makeGenreList();
   return l;
 }
 
 ID3v1::GenreMap ID3v1::genreMap()
 {
-  static GenreMap m;
-  if(m.isEmpty()) {
-    for(int i = 0; i < genresSize; i++)
-      m.insert(genres[i], i);
-  }
+  static const GenreMap m = makeGenreMap();
   return m;
 }
 
@@ -175,6 +175,9 @@ namespace TagLib {
        * \note The caller is responsible for deleting the previous handler
        * as needed after it is released.
        *
+       * \note The handler is used by all threads.  It should be set before
+       * any files are read, and must not be changed while files are read.
+       *
        * \see StringHandler
        */
       static void setStringHandler(const StringHandler *handler);
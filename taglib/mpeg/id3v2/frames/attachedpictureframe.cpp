@@ -27,6 +27,7 @@
 
 #include <tstringlist.h>
 #include <tdebug.h>
+#include <tdeferreddata.h>
 
 using namespace TagLib;
 using namespace ID3v2;
@@ -41,7 +42,7 @@ public:
   String mimeType;
   AttachedPictureFrame::Type type;
   String description;
-  ByteVector data;
+  DeferredData data;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -112,12 +113,12 @@ void AttachedPictureFrame::setDescription(const String &desc)
 
 ByteVector AttachedPictureFrame::picture() const
 {
-  return d->data;
+  return d->data.data();
 }
 
 void AttachedPictureFrame::setPicture(const ByteVector &p)
 {
-  d->data = p;
+  d->data.setData(p);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -145,7 +146,7 @@ void AttachedPictureFrame::parseFields(const ByteVector &data)
   d->type = (TagLib::ID3v2::AttachedPictureFrame::Type)data[pos++];
   d->description = readStringField(data, d->textEncoding, &pos);
 
-  d->data = data.mid(pos);
+  d->data.setData(data.mid(pos));
 }
 
 ByteVector AttachedPictureFrame::renderFields() const
@@ -160,7 +161,7 @@ ByteVector AttachedPictureFrame::renderFields() const
   data.append(char(d->type));
   data.append(d->description.data(encoding));
   data.append(textDelimiter(encoding));
-  data.append(d->data);
+  data.append(d->data.data());
 
   return data;
 }
@@ -175,6 +176,11 @@ AttachedPictureFrame::AttachedPictureFrame(const ByteVector &data, Header *h) :
   parseFields(fieldData(data));
 }
 
+bool AttachedPictureFrame::deferData(File *file, long offset, uint parsed)
+{
+  return deferFieldData(d->data, file, offset, parsed);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // support for ID3v2.2 PIC frames
 ////////////////////////////////////////////////////////////////////////////////
@@ -205,7 +211,7 @@ void AttachedPictureFrameV22::parseFields(const ByteVector &data)
   d->type = (TagLib::ID3v2::AttachedPictureFrame::Type)data[pos++];
   d->description = readStringField(data, d->textEncoding, &pos);
 
-  d->data = data.mid(pos);
+  d->data.setData(data.mid(pos));
 }
 
 AttachedPictureFrameV22::AttachedPictureFrameV22(const ByteVector &data, Header *h)
@@ -213,6 +213,12 @@ namespace TagLib {
       AttachedPictureFrame &operator=(const AttachedPictureFrame &);
       AttachedPictureFrame(const ByteVector &data, Header *h);
 
+      friend class Tag;
+
+      /*
+       * Defers the picture.  See Frame::deferFieldData().
+       */
+      bool deferData(File *file, long offset, uint parsed);
     };
 
     //! support for ID3v2.2 PIC frames
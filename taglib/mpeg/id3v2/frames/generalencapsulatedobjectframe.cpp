@@ -26,6 +26,7 @@
  ***************************************************************************/
 
 #include <tdebug.h>
+#include <tdeferreddata.h>
 
 #include "generalencapsulatedobjectframe.h"
 
@@ -41,7 +42,7 @@ public:
   String mimeType;
   String fileName;
   String description;
-  ByteVector data;
+  DeferredData data;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -119,12 +120,12 @@ void GeneralEncapsulatedObjectFrame::setDescription(const String &desc)
 
 ByteVector GeneralEncapsulatedObjectFrame::object() const
 {
-  return d->data;
+  return d->data.data();
 }
 
 void GeneralEncapsulatedObjectFrame::setObject(const ByteVector &data)
 {
-  d->data = data;
+  d->data.setData(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -146,7 +147,7 @@ void GeneralEncapsulatedObjectFrame::parseFields(const ByteVector &data)
   d->fileName = readStringField(data, d->textEncoding, &pos);
   d->description = readStringField(data, d->textEncoding, &pos);
 
-  d->data = data.mid(pos);
+  d->data.setData(data.mid(pos));
 }
 
 ByteVector GeneralEncapsulatedObjectFrame::renderFields() const
@@ -160,7 +161,7 @@ ByteVector GeneralEncapsulatedObjectFrame::renderFields() const
   data.append(textDelimiter(d->textEncoding));
   data.append(d->description.data(d->textEncoding));
   data.append(textDelimiter(d->textEncoding));
-  data.append(d->data);
+  data.append(d->data.data());
 
   return data;
 }
@@ -174,3 +175,8 @@ GeneralEncapsulatedObjectFrame::GeneralEncapsulatedObjectFrame(const ByteVector
   d = new GeneralEncapsulatedObjectFramePrivate;
   parseFields(fieldData(data));
 }
+
+bool GeneralEncapsulatedObjectFrame::deferData(File *file, long offset, uint parsed)
+{
+  return deferFieldData(d->data, file, offset, parsed);
+}
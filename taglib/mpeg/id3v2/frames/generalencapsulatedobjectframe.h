@@ -169,6 +169,13 @@ namespace TagLib {
       GeneralEncapsulatedObjectFrame(const GeneralEncapsulatedObjectFrame &);
       GeneralEncapsulatedObjectFrame &operator=(const GeneralEncapsulatedObjectFrame &);
 
+      friend class Tag;
+
+      /*
+       * Defers the object.  See Frame::deferFieldData().
+       */
+      bool deferData(File *file, long offset, uint parsed);
+
       class GeneralEncapsulatedObjectFramePrivate;
       GeneralEncapsulatedObjectFramePrivate *d;
     };
@@ -27,6 +27,7 @@
 #include <tbytevectorlist.h>
 #include <id3v2tag.h>
 #include <tdebug.h>
+#include <tdeferreddata.h>
 
 #include "privateframe.h"
 
@@ -37,7 +38,7 @@ using namespace ID3v2;
 class PrivateFrame::PrivateFramePrivate
 {
 public:
-  ByteVector data;
+  DeferredData data;
   String owner;
 };
 
@@ -73,7 +74,7 @@ String PrivateFrame::owner() const
 
 ByteVector PrivateFrame::data() const
 {
-  return d->data;
+  return d->data.data();
 }
 
 void PrivateFrame::setOwner(const String &s)
@@ -83,7 +84,7 @@ void PrivateFrame::setOwner(const String &s)
 
 void PrivateFrame::setData(const ByteVector & data)
 {
-  d->data = data;
+  d->data.setData(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -103,7 +104,7 @@ void PrivateFrame::parseFields(const ByteVector &data)
   const int endOfOwner = data.find(textDelimiter(String::Latin1), 0, byteAlign);
 
   d->owner =  String(data.mid(0, endOfOwner));
-  d->data = data.mid(endOfOwner + 1);
+  d->data.setData(data.mid(endOfOwner + 1));
 }
 
 ByteVector PrivateFrame::renderFields() const
@@ -112,7 +113,7 @@ ByteVector PrivateFrame::renderFields() const
 
   v.append(d->owner.data(String::Latin1));
   v.append(textDelimiter(String::Latin1));
-  v.append(d->data);
+  v.append(d->data.data());
 
   return v;
 }
@@ -126,3 +127,8 @@ PrivateFrame::PrivateFrame(const ByteVector &data, Header *h) : Frame(h)
   d = new PrivateFramePrivate();
   parseFields(fieldData(data));
 }
+
+bool PrivateFrame::deferData(File *file, long offset, uint parsed)
+{
+  return deferFieldData(d->data, file, offset, parsed);
+}
@@ -102,6 +102,13 @@ namespace TagLib {
       PrivateFrame(const PrivateFrame &);
       PrivateFrame &operator=(const PrivateFrame &);
 
+      friend class Tag;
+
+      /*
+       * Defers the data.  See Frame::deferFieldData().
+       */
+      bool deferData(File *file, long offset, uint parsed);
+
       class PrivateFramePrivate;
       PrivateFramePrivate *d;
     };
@@ -129,12 +129,17 @@ static const char* involvedPeople[][2] = {
     {"MIX", "MIXER"},
 };
 
+static KeyConversionMap makeInvolvedPeopleMap()
+{
+  KeyConversionMap m;
+  for(uint i = 0; i < involvedPeopleSize; ++i)
+    m.insert(involvedPeople[i][1], involvedPeople[i][0]);
+  return m;
+}
+
 const KeyConversionMap &TextIdentificationFrame::involvedPeopleMap() // static
 {
-  static KeyConversionMap m;
-  if(m.isEmpty())
-    for(uint i = 0; i < involvedPeopleSize; ++i)
-      m.insert(involvedPeople[i][1], involvedPeople[i][0]);
+  static const KeyConversionMap m = makeInvolvedPeopleMap();
   return m;
 }
 
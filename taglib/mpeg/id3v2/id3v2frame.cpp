@@ -35,6 +35,7 @@
 
 #include <tdebug.h>
 #include <tstringlist.h>
+#include <tdeferreddata.h>
 
 #include "id3v2tag.h"
 #include "id3v2frame.h"
@@ -67,13 +68,13 @@ public:
 
 namespace
 {
-  bool isValidFrameID(const ByteVector &frameID)
+  bool isValidFrameID(const ByteVectorView &frameID)
   {
     if(frameID.size() != 4)
       return false;
 
-    for(ByteVector::ConstIterator it = frameID.begin(); it != frameID.end(); it++) {
-      if( (*it < 'A' || *it > 'Z') && (*it < '0' || *it > '9') ) {
+    for(uint i = 0; i < frameID.size(); i++) {
+      if( (frameID[i] < 'A' || frameID[i] > 'Z') && (frameID[i] < '0' || frameID[i] > '9') ) {
         return false;
       }
     }
@@ -246,7 +247,7 @@ ByteVector Frame::fieldData(const ByteVector &frameData) const
   uint frameDataLength = size();
 
   if(d->header->compression() || d->header->dataLengthIndicator()) {
-    frameDataLength = SynchData::toUInt(frameData.mid(headerSize, 4));
+    frameDataLength = SynchData::toUInt(ByteVectorView(frameData).mid(headerSize, 4));
     frameDataOffset += 4;
   }
 
@@ -267,6 +268,18 @@ ByteVector Frame::fieldData(const ByteVector &frameData) const
     return frameData.mid(frameDataOffset, frameDataLength);
 }
 
+bool Frame::deferFieldData(DeferredData &data, File *file, long offset, uint parsed) const
+{
+  const uint size = data.size();
+
+  if(size == 0 || size >= parsed)
+    return false;
+
+  const uint start = parsed - size;
+  data.defer(file, offset + start, d->header->frameSize() - start);
+  return true;
+}
+
 String Frame::readStringField(const ByteVector &data, String::Type encoding, int *position)
 {
   int start = 0;
@@ -285,7 +298,7 @@ String Frame::readStringField(const ByteVector &data, String::Type encoding, int
   if(encoding == String::Latin1)
     str = Tag::latin1StringHandler()->parse(data.mid(*position, end - *position));
   else
-    str = String(data.mid(*position, end - *position), encoding);
+    str = String(ByteVectorView(data).mid(*position, end - *position), encoding);
 
   *position = end + delimiter.size();
 
@@ -404,24 +417,33 @@ static const char *txxxFrameTranslation[][2] = {
   { "MusicIP PUID", "MUSICIP_PUID" },
 };
 
-Map<ByteVector, String> &idMap()
+template <class Key, class T>
+static Map<Key, T> translationMap(const char *table[][2], size_t size, int from)
 {
-  static Map<ByteVector, String> m;
-  if(m.isEmpty())
-    for(size_t i = 0; i < frameTranslationSize; ++i)
-      m[frameTranslation[i][0]] = frameTranslation[i][1];
+  Map<Key, T> m;
+  for(size_t i = 0; i < size; ++i)
+    m.insert(table[i][from], table[i][1 - from]);
   return m;
 }
 
-Map<String, String> &txxxMap()
+const Map<ByteVector, String> &idMap()
 {
-  static Map<String, String> m;
-  if(m.isEmpty()) {
-    for(size_t i = 0; i < txxxFrameTranslationSize; ++i) {
-      String key = String(txxxFrameTranslation[i][0]).upper();
-      m[key] = txxxFrameTranslation[i][1];
-    }
-  }
+  static const Map<ByteVector, String> m =
+    translationMap<ByteVector, String>(frameTranslation, frameTranslationSize, 0);
+  return m;
+}
+
+static Map<String, String> upperCaseTXXXMap()
+{
+  Map<String, String> m;
+  for(size_t i = 0; i < txxxFrameTranslationSize; ++i)
+    m.insert(String(txxxFrameTranslation[i][0]).upper(), txxxFrameTranslation[i][1]);
+  return m;
+}
+
+const Map<String, String> &txxxMap()
+{
+  static const Map<String, String> m = upperCaseTXXXMap();
   return m;
 }
 
@@ -434,53 +456,54 @@ static const char *deprecatedFrames[][2] = {
   {"TIME", "TDRC"}, // 2.3 -> 2.4
 };
 
-Map<ByteVector,ByteVector> &deprecationMap()
+const Map<ByteVector,ByteVector> &deprecationMap()
 {
-  static Map<ByteVector,ByteVector> depMap;
-  if(depMap.isEmpty())
-    for(TagLib::uint i = 0; i < deprecatedFramesSize; ++i)
-      depMap[deprecatedFrames[i][0]] = deprecatedFrames[i][1];
+  static const Map<ByteVector,ByteVector> depMap =
+    translationMap<ByteVector, ByteVector>(deprecatedFrames, deprecatedFramesSize, 0);
   return depMap;
 }
 
 String Frame::frameIDToKey(const ByteVector &id)
 {
-  Map<ByteVector, String> &m = idMap();
-  if(m.contains(id))
-    return m[id];
-  if(deprecationMap().contains(id))
-    return m[deprecationMap()[id]];
+  const Map<ByteVector, String> &m = idMap();
+  Map<ByteVector, String>::ConstIterator it = m.find(id);
+  if(it != m.end())
+    return it->second;
+
+  Map<ByteVector, ByteVector>::ConstIterator newId = deprecationMap().find(id);
+  if(newId != deprecationMap().end())
+    return m[newId->second];
+
   return String::null;
 }
 
 ByteVector Frame::keyToFrameID(const String &s)
 {
-  static Map<String, ByteVector> m;
-  if(m.isEmpty())
-    for(size_t i = 0; i < frameTranslationSize; ++i)
-      m[frameTranslation[i][1]] = frameTranslation[i][0];
-  if(m.contains(s.upper()))
-    return m[s];
+  static const Map<String, ByteVector> m =
+    translationMap<String, ByteVector>(frameTranslation, frameTranslationSize, 1);
+  Map<String, ByteVector>::ConstIterator it = m.find(s.upper());
+  if(it != m.end())
+    return it->second;
   return ByteVector::null;
 }
 
 String Frame::txxxToKey(const String &description)
 {
-  Map<String, String> &m = txxxMap();
+  const Map<String, String> &m = txxxMap();
   String d = description.upper();
-  if(m.contains(d))
-    return m[d];
+  Map<String, String>::ConstIterator it = m.find(d);
+  if(it != m.end())
+    return it->second;
   return d;
 }
 
 String Frame::keyToTXXX(const String &s)
 {
-  static Map<String, String> m;
-  if(m.isEmpty())
-    for(size_t i = 0; i < txxxFrameTranslationSize; ++i)
-      m[txxxFrameTranslation[i][1]] = txxxFrameTranslation[i][0];
-  if(m.contains(s.upper()))
-    return m[s];
+  static const Map<String, String> m =
+    translationMap<String, String>(txxxFrameTranslation, txxxFrameTranslationSize, 1);
+  Map<String, String>::ConstIterator it = m.find(s.upper());
+  if(it != m.end())
+    return it->second;
   return s;
 }
 
@@ -712,13 +735,15 @@ void Frame::Header::setData(const ByteVector &data, uint version)
     // Set the size -- the frame size is the four bytes starting at byte four in
     // the frame header (structure 4)
 
-    d->frameSize = SynchData::toUInt(data.mid(4, 4));
+    const ByteVectorView view(data);
+
+    d->frameSize = SynchData::toUInt(view.mid(4, 4));
 #ifndef NO_ITUNES_HACKS
     // iTunes writes v2.4 tags with v2.3-like frame sizes
     if(d->frameSize > 127) {
-      if(!isValidFrameID(data.mid(d->frameSize + 10, 4))) {
-        unsigned int uintSize = data.toUInt(4U);
-        if(isValidFrameID(data.mid(uintSize + 10, 4))) {
+      if(!isValidFrameID(view.mid(d->frameSize + 10, 4))) {
+        unsigned int uintSize = view.toUInt(4U);
+        if(isValidFrameID(view.mid(uintSize + 10, 4))) {
           d->frameSize = uintSize;
         }
       }
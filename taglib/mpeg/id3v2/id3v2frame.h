@@ -34,6 +34,8 @@ namespace TagLib {
 
   class StringList;
   class PropertyMap;
+  class File;
+  class DeferredData;
 
   namespace ID3v2 {
 
@@ -253,6 +255,14 @@ namespace TagLib {
       String::Type checkTextEncoding(const StringList &fields,
                                      String::Type encoding) const;
 
+      /*!
+       * Makes \a data, the binary field which ends the frame, be read from
+       * \a file when it is used.  The frame has been parsed from the first
+       * \a parsed bytes of its fields, which begin at \a offset.  Returns false
+       * if \a data does not begin within those bytes.
+       */
+      bool deferFieldData(DeferredData &data, File *file, long offset, uint parsed) const;
+
 
       /*!
        * Parses the contents of this frame as PropertyMap. If that fails, the returend
@@ -27,6 +27,9 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
+#include <cstring>
+
 #include <tdebug.h>
 
 #include "id3v2framefactory.h"
@@ -127,10 +130,16 @@ Frame *FrameFactory::createFrame(const ByteVector &origData, Header *tagHeader)
 
   if(version > 3 && (tagHeader->unsynchronisation() || header->unsynchronisation())) {
     // Data lengths are not part of the encoded data, but since they are synch-safe
-    // integers they will be never actually encoded.
-    ByteVector frameData = data.mid(Frame::Header::size(version), header->frameSize());
-    frameData = SynchData::decode(frameData);
-    data = data.mid(0, Frame::Header::size(version)) + frameData;
+    // integers they will be never actually encoded.  The frame is decoded
+    // right behind a copy of its header.
+
+    const uint headerSize = Frame::Header::size(version);
+    const uint frameSize = std::min(header->frameSize(), data.size() - headerSize);
+    ByteVector decoded(headerSize + frameSize);
+    ::memcpy(decoded.data(), data.data(), headerSize);
+    decoded.resize(headerSize + SynchData::decode(data.data() + headerSize, frameSize,
+                                                  decoded.data() + headerSize));
+    data = decoded;
   }
 
   // TagLib doesn't mess with encrypted frames, so just treat them
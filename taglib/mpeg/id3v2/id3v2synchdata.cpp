@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include <iostream>
+#include <cstring>
 
 #include "id3v2synchdata.h"
 
@@ -31,6 +32,11 @@ using namespace TagLib;
 using namespace ID3v2;
 
 TagLib::uint SynchData::toUInt(const ByteVector &data)
+{
+  return toUInt(ByteVectorView(data));
+}
+
+TagLib::uint SynchData::toUInt(const ByteVectorView &data)
 {
   uint sum = 0;
   bool notSynchSafe = false;
@@ -53,9 +59,8 @@ TagLib::uint SynchData::toUInt(const ByteVector &data)
       sum = data.toUInt(0, true);
     }
     else {
-      ByteVector tmp(data);
-      tmp.resize(4);
-      sum = tmp.toUInt(0, true);
+      // Same as padding the data with zeros to 4 bytes.
+      sum = data.toUInt(0, data.size(), true) << ((4 - data.size()) * 8);
     }
   }
 
@@ -74,11 +79,80 @@ ByteVector SynchData::fromUInt(uint value)
 
 ByteVector SynchData::decode(const ByteVector &data)
 {
-  ByteVector result = data;
+  // Data without anything to remove is shared rather than copied.
+
+  if(data.find(ByteVector("\xFF\x00", 2)) == -1)
+    return data;
+
+  ByteVector result(data.size());
+  result.resize(decode(data.data(), data.size(), result.data()));
+  return result;
+}
+
+TagLib::uint SynchData::decode(const char *input, uint length, char *output)
+{
+  // Everything up to and including a 0xFF is copied as it is, and a zero byte
+  // right after the 0xFF is dropped.  memchr() does the scanning, which is
+  // vectorized by most C libraries.
+
+  const char *p = input;
+  const char *end = input + length;
+  char *out = output;
+
+  while(p < end) {
+    const char *ff = static_cast<const char *>(::memchr(p, '\xFF', end - p));
+    const char *next = ff ? (ff + 1) : end;
+
+    // Nothing has to be moved while decoding in place until the first zero
+    // byte has been dropped.
+
+    if(out != p)
+      ::memmove(out, p, next - p);
+
+    out += next - p;
+    p = next;
+
+    if(p < end && *p == '\0')
+      ++p;
+  }
+
+  return out - output;
+}
+
+ByteVector SynchData::encode(const ByteVector &data)
+{
+  const char *begin = data.data();
+  const char *end = begin + data.size();
+
+  // Count the inserted bytes first, so that the result is allocated once.
+
+  uint inserted = 0;
+  for(const char *p = begin; p < end; ++p) {
+    p = static_cast<const char *>(::memchr(p, '\xFF', end - p));
+    if(!p)
+      break;
+    if(p + 1 == end || p[1] == '\0' || (uchar(p[1]) & 0xE0) == 0xE0)
+      ++inserted;
+  }
+
+  if(inserted == 0)
+    return data;
+
+  ByteVector result(data.size() + inserted);
+  char *out = result.data();
 
-  ByteVector pattern(2, char(0));
-  pattern[0] = '\xFF';
-  pattern[1] = '\x00';
+  const char *p = begin;
+  while(p < end) {
+    const char *ff = static_cast<const char *>(::memchr(p, '\xFF', end - p));
+    const char *next = ff ? (ff + 1) : end;
+
+    ::memcpy(out, p, next - p);
+    out += next - p;
+    p = next;
+
+    if(ff && (p == end || *p == '\0' || (uchar(*p) & 0xE0) == 0xE0))
+      *out++ = '\0';
+  }
 
-  return result.replace(pattern, '\xFF');
+  return result;
 }
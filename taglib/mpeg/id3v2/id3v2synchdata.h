@@ -27,6 +27,7 @@
 #define TAGLIB_ID3V2SYNCHDATA_H
 
 #include "tbytevector.h"
+#include "tbytevectorview.h"
 #include "taglib.h"
 
 namespace TagLib {
@@ -53,6 +54,12 @@ namespace TagLib {
        */
       TAGLIB_EXPORT uint toUInt(const ByteVector &data);
 
+      /*!
+       * Same as above, but reads the integer from a view, e.g. of a part of a
+       * frame, without copying it.
+       */
+      TAGLIB_EXPORT uint toUInt(const ByteVectorView &data);
+
       /*!
        * Returns a 4 byte (32 bit) synchsafe integer based on \a value.
        */
@@ -62,6 +69,21 @@ namespace TagLib {
        * Convert the data from unsynchronized data to its original format.
        */
       TAGLIB_EXPORT ByteVector decode(const ByteVector &input);
+
+      /*!
+       * Convert \a length bytes of unsynchronized data at \a input to their
+       * original format and write them to \a output, which must have room for
+       * \a length bytes.  \a output may be the same as \a input, so that the
+       * data is decoded in place.  Returns the size of the decoded data.
+       */
+      TAGLIB_EXPORT uint decode(const char *input, uint length, char *output);
+
+      /*!
+       * Convert the data to unsynchronized data, which inserts a zero byte
+       * after every 0xFF that is followed by a zero byte or a byte of the form
+       * %111xxxxx, or that is the last byte.
+       */
+      TAGLIB_EXPORT ByteVector encode(const ByteVector &input);
     }
 
   }
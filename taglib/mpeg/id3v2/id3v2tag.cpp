@@ -45,14 +45,113 @@
 #include "frames/uniquefileidentifierframe.h"
 #include "frames/unsynchronizedlyricsframe.h"
 #include "frames/unknownframe.h"
+#include "frames/attachedpictureframe.h"
+#include "frames/generalencapsulatedobjectframe.h"
+#include "frames/privateframe.h"
+
+#include <algorithm>
 
 using namespace TagLib;
 using namespace ID3v2;
 
+namespace
+{
+  // The filesystem block size that the growth of an existing tag is rounded to.
+  const TagLib::uint PaddingAlignment = 4096;
+
+  // When binary data is deferred, the frames are read in blocks of this size,
+  // and the binary frames larger than DeferredFrameSize are parsed from their
+  // first DeferredFieldsSize bytes.
+
+  const TagLib::uint FrameBlockSize = 16 * 1024;
+  const TagLib::uint DeferredFrameSize = 4096;
+  const TagLib::uint DeferredFieldsSize = 1024;
+
+  bool isBinaryFrame(const ByteVector &id)
+  {
+    return (id == "APIC" || id == "GEOB" || id == "PRIV" || id == "PIC" || id == "GEO");
+  }
+
+  // The frames which carry the basic fields, by their identifiers in ID3v2.2,
+  // which iTunes also writes into ID3v2.3 tags, and in ID3v2.3 and 2.4.
+
+  const struct {
+    const char *id;
+    int field;
+  } fieldFrames[] = {
+    { "TT2",  File::ReadTitle },   { "TIT2", File::ReadTitle },
+    { "TP1",  File::ReadArtist },  { "TPE1", File::ReadArtist },
+    { "TAL",  File::ReadAlbum },   { "TALB", File::ReadAlbum },
+    { "COM",  File::ReadComment }, { "COMM", File::ReadComment },
+    { "TCO",  File::ReadGenre },   { "TCON", File::ReadGenre },
+    { "TYE",  File::ReadYear },    { "TYER", File::ReadYear },   { "TDRC", File::ReadYear },
+    { "TRK",  File::ReadTrack },   { "TRCK", File::ReadTrack }
+  };
+
+  // Returns true if the frame with the identifier id carries one of the
+  // fields in readOptions.
+
+  bool isRequestedFrame(ByteVector id, int readOptions)
+  {
+    if(id.size() == 4 && id[3] == '\0')
+      id.resize(3);
+
+    for(size_t i = 0; i < sizeof(fieldFrames) / sizeof(fieldFrames[0]); ++i) {
+      if((readOptions & fieldFrames[i].field) && id == fieldFrames[i].id)
+        return true;
+    }
+
+    return false;
+  }
+
+  // Returns frame header data with the frame size replaced by size.
+
+  ByteVector resizeFrameHeader(const ByteVector &data, TagLib::uint version, TagLib::uint size)
+  {
+    if(version < 3)
+      return data.mid(0, 3) + ByteVector::fromUInt(size).mid(1);
+    else if(version == 3)
+      return data.mid(0, 4) + ByteVector::fromUInt(size) + data.mid(8, 2);
+    else
+      return data.mid(0, 4) + SynchData::fromUInt(size) + data.mid(8, 2);
+  }
+
+  // The part of a tag in the file which has been read last, which is moved
+  // forward as the frames are read.
+
+  class FrameBlock
+  {
+  public:
+    FrameBlock(File *file, long offset, TagLib::uint size) :
+      file(file), offset(offset), size(size), position(0) {}
+
+    ByteVector read(TagLib::uint start, TagLib::uint length)
+    {
+      length = std::min(length, size - start);
+
+      if(start < position || start + length > position + block.size()) {
+        file->seek(offset + start);
+        block = file->readBlock(std::min(std::max(length, FrameBlockSize), size - start));
+        position = start;
+      }
+
+      return block.mid(start - position, length);
+    }
+
+  private:
+    File *file;
+    const long offset;
+    const TagLib::uint size;
+    TagLib::uint position;
+    ByteVector block;
+  };
+}
+
 class ID3v2::Tag::TagPrivate
 {
 public:
-  TagPrivate() : file(0), tagOffset(-1), extendedHeader(0), footer(0), paddingSize(0)
+  TagPrivate() : file(0), tagOffset(-1), readOptions(File::ReadAll), extendedHeader(0),
+    footer(0), paddingSize(0)
   {
     frameList.setAutoDelete(true);
   }
@@ -64,6 +163,7 @@ public:
 
   File *file;
   long tagOffset;
+  int readOptions;
   const FrameFactory *factory;
 
   Header header;
@@ -108,13 +208,15 @@ ID3v2::Tag::Tag() : TagLib::Tag()
   d->factory = FrameFactory::instance();
 }
 
-ID3v2::Tag::Tag(File *file, long tagOffset, const FrameFactory *factory) :
+ID3v2::Tag::Tag(File *file, long tagOffset, const FrameFactory *factory,
+                int readOptions) :
   TagLib::Tag()
 {
   d = new TagPrivate;
 
   d->file = file;
   d->tagOffset = tagOffset;
+  d->readOptions = readOptions;
   d->factory = factory;
 
   read();
@@ -555,6 +657,11 @@ void ID3v2::Tag::downgradeFrames(FrameList *frames, FrameList *newFrames) const
 
 
 ByteVector ID3v2::Tag::render(int version) const
+{
+  return render(version, false);
+}
+
+ByteVector ID3v2::Tag::render(int version, bool alignGrowth) const
 {
   // We need to render the "tag data" first so that we have to correct size to
   // render in the tag's header.  The "tag data" -- everything that is included
@@ -601,9 +708,19 @@ ByteVector ID3v2::Tag::render(int version) const
 
   if(tagData.size() < originalSize)
     paddingSize = originalSize - tagData.size();
-  else
+  else {
     paddingSize = 1024;
 
+    // If an existing tag grows, round the growth up to a multiple of the
+    // usual filesystem block size.  FileStream can then insert the extra
+    // space without rewriting the rest of the file.
+
+    if(alignGrowth && originalSize > 0) {
+      const uint growth = Header::size() + tagData.size() + paddingSize - d->header.completeTagSize();
+      paddingSize += (PaddingAlignment - growth % PaddingAlignment) % PaddingAlignment;
+    }
+  }
+
   tagData.append(ByteVector(paddingSize, char(0)));
 
   // Set the version and data size.
@@ -644,7 +761,16 @@ void ID3v2::Tag::read()
     if(d->header.tagSize() == 0)
       return;
 
-    parse(d->file->readBlock(d->header.tagSize()));
+    // Deferring binary data needs the frames to be where they are in the file.
+    // Reading the frames one at a time also leaves skipped frames unread.
+
+    if((d->readOptions & (File::DeferBinaryData | File::ReadBasicFields)) &&
+       !d->header.unsynchronisation() && !d->header.extendedHeader())
+    {
+      readFrames();
+    }
+    else
+      parse(d->file->readBlock(d->header.tagSize()));
   }
 }
 
@@ -682,7 +808,10 @@ void ID3v2::Tag::parse(const ByteVector &origData)
   // Make sure that there is at least enough room in the remaining frame data for
   // a frame header.
 
-  while(frameDataPosition < frameDataLength - Frame::headerSize(d->header.majorVersion())) {
+  const uint version = d->header.majorVersion();
+  const uint headerSize = Frame::headerSize(version);
+
+  while(frameDataPosition < frameDataLength - headerSize) {
 
     // If the next data is position is 0, assume that we've hit the padding
     // portion of the frame data.
@@ -696,6 +825,20 @@ void ID3v2::Tag::parse(const ByteVector &origData)
       return;
     }
 
+    // Skip the frames which carry none of the requested fields.
+
+    if(d->readOptions & File::ReadBasicFields) {
+      const Frame::Header header(data.mid(frameDataPosition), version);
+      if(!isRequestedFrame(header.frameID(), d->readOptions)) {
+        if(header.frameSize() == 0 ||
+           header.frameSize() > frameDataLength - frameDataPosition - headerSize)
+          return;
+
+        frameDataPosition += headerSize + header.frameSize();
+        continue;
+      }
+    }
+
     Frame *frame = d->factory->createFrame(data.mid(frameDataPosition),
                                            &d->header);
 
@@ -709,7 +852,7 @@ void ID3v2::Tag::parse(const ByteVector &origData)
       return;
     }
 
-    frameDataPosition += frame->size() + Frame::headerSize(d->header.majorVersion());
+    frameDataPosition += frame->size() + headerSize;
     addFrame(frame);
   }
 }
@@ -730,3 +873,113 @@ void ID3v2::Tag::setTextFrame(const ByteVector &id, const String &value)
     f->setText(value);
   }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// private members
+////////////////////////////////////////////////////////////////////////////////
+
+void ID3v2::Tag::readFrames()
+{
+  // Like parse(), but reads the frames one at a time, and leaves the data of
+  // large binary frames in the file if it is deferred.
+
+  const uint version = d->header.majorVersion();
+  const uint headerSize = Frame::headerSize(version);
+  const uint tagSize = d->header.tagSize();
+  const long offset = d->tagOffset + Header::size();
+
+  uint frameDataLength = tagSize;
+
+  if(d->header.footerPresent() && Footer::size() <= frameDataLength)
+    frameDataLength -= Footer::size();
+
+  FrameBlock block(d->file, offset, tagSize);
+  uint frameDataPosition = 0;
+
+  while(frameDataPosition + headerSize < frameDataLength) {
+
+    const ByteVector headerData = block.read(frameDataPosition, headerSize);
+
+    if(headerData.size() < headerSize)
+      return;
+
+    if(headerData[0] == 0) {
+      if(d->header.footerPresent()) {
+        debug("Padding *and* a footer found.  This is not allowed by the spec.");
+      }
+
+      d->paddingSize = frameDataLength - frameDataPosition;
+      return;
+    }
+
+    Frame::Header header(headerData, version);
+
+    // Skip the frames which carry none of the requested fields.
+
+    if((d->readOptions & File::ReadBasicFields) &&
+       !isRequestedFrame(header.frameID(), d->readOptions))
+    {
+      if(header.frameSize() == 0 ||
+         header.frameSize() > frameDataLength - frameDataPosition - headerSize)
+        return;
+
+      frameDataPosition += headerSize + header.frameSize();
+      continue;
+    }
+
+    Frame *frame = 0;
+
+    if((d->readOptions & File::DeferBinaryData) &&
+       header.frameSize() > DeferredFrameSize &&
+       header.frameSize() <= tagSize - frameDataPosition - headerSize &&
+       isBinaryFrame(header.frameID()) &&
+       !header.compression() && !header.encryption() && !header.groupingIdentity() &&
+       !header.unsynchronisation() && !header.dataLengthIndicator())
+    {
+      // Parse the frame from the beginning of its fields, as if that were all
+      // of it, and then let it read the rest when it is used.
+
+      const ByteVector fields = block.read(frameDataPosition + headerSize, DeferredFieldsSize);
+
+      frame = d->factory->createFrame(
+        resizeFrameHeader(headerData, version, fields.size()) + fields, &d->header);
+
+      if(frame) {
+        frame->header()->setFrameSize(header.frameSize());
+
+        const long fieldsOffset = offset + frameDataPosition + headerSize;
+        bool deferred = false;
+
+        if(AttachedPictureFrame *f = dynamic_cast<AttachedPictureFrame *>(frame))
+          deferred = f->deferData(d->file, fieldsOffset, fields.size());
+        else if(GeneralEncapsulatedObjectFrame *f = dynamic_cast<GeneralEncapsulatedObjectFrame *>(frame))
+          deferred = f->deferData(d->file, fieldsOffset, fields.size());
+        else if(PrivateFrame *f = dynamic_cast<PrivateFrame *>(frame))
+          deferred = f->deferData(d->file, fieldsOffset, fields.size());
+
+        if(!deferred) {
+          delete frame;
+          frame = 0;
+        }
+      }
+    }
+
+    if(!frame) {
+      frame = d->factory->createFrame(
+        block.read(frameDataPosition, headerSize + header.frameSize()), &d->header);
+    }
+
+    if(!frame)
+      return;
+
+    // Checks to make sure that frame parsed correctly.
+
+    if(frame->size() <= 0) {
+      delete frame;
+      return;
+    }
+
+    frameDataPosition += frame->size() + headerSize;
+    addFrame(frame);
+  }
+}
@@ -31,6 +31,7 @@
 #include "tstring.h"
 #include "tlist.h"
 #include "tmap.h"
+#include "tfile.h"
 #include "taglib_export.h"
 
 #include "id3v2framefactory.h"
@@ -152,10 +153,16 @@ namespace TagLib {
        * subclass in the case that you are extending TagLib to support additional
        * frame types, which would be incorperated into your factory.
        *
+       * If \a readOptions contains File::DeferBinaryData, the data of large
+       * picture, object and private frames is read only when it is used.  If
+       * it requests some of the basic fields, the other frames are skipped.
+       *
        * \see FrameFactory
+       * \see File::ReadOption
        */
       Tag(File *file, long tagOffset,
-          const FrameFactory *factory = FrameFactory::instance());
+          const FrameFactory *factory = FrameFactory::instance(),
+          int readOptions = File::ReadAll);
 
       /*!
        * Destroys this Tag instance.
@@ -353,6 +360,18 @@ namespace TagLib {
        */
       // BIC: combine with the above method
       ByteVector render(int version) const;
+
+      /*!
+       * Render the tag like render(int).  If \a alignGrowth is true and an
+       * existing tag grows, the growth is rounded up to a multiple of 4 KiB
+       * with padding, so that a FileStream can insert the extra space without
+       * rewriting the rest of the file.
+       *
+       * This only pays off for a tag at the start of a file, as in MPEG and
+       * TrueAudio files, and not for a tag embedded in a RIFF chunk.
+       */
+      // BIC: combine with the above methods
+      ByteVector render(int version, bool alignGrowth) const;
       
       /*!
        * Gets the current string handler that decides how the "Latin-1" data 
@@ -371,6 +390,9 @@ namespace TagLib {
        * \note The caller is responsible for deleting the previous handler
        * as needed after it is released. 
        *
+       * \note The handler is used by all threads.  It should be set before
+       * any files are read, and must not be changed while files are read.
+       *
        * \see Latin1StringHandler
        */
       static void setLatin1StringHandler(const Latin1StringHandler *handler);
@@ -402,6 +424,8 @@ namespace TagLib {
       Tag(const Tag &);
       Tag &operator=(const Tag &);
 
+      void readFrames();
+
       class TagPrivate;
       TagPrivate *d;
     };
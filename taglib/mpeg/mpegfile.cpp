@@ -96,7 +96,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 MPEG::File::File(FileName file, bool readProperties,
-                 Properties::ReadStyle propertiesStyle) : TagLib::File(file)
+                 Properties::ReadStyle propertiesStyle,
+                 int readOptions) : TagLib::File(file, readOptions)
 {
   d = new FilePrivate;
 
@@ -105,8 +106,9 @@ MPEG::File::File(FileName file, bool readProperties,
 }
 
 MPEG::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle propertiesStyle) :
-  TagLib::File(file)
+                 bool readProperties, Properties::ReadStyle propertiesStyle,
+                 int readOptions) :
+  TagLib::File(file, readOptions)
 {
   d = new FilePrivate(frameFactory);
 
@@ -115,8 +117,9 @@ MPEG::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
 }
 
 MPEG::File::File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle propertiesStyle) :
-  TagLib::File(stream)
+                 bool readProperties, Properties::ReadStyle propertiesStyle,
+                 int readOptions) :
+  TagLib::File(stream, readOptions)
 {
   d = new FilePrivate(frameFactory);
 
@@ -192,6 +195,11 @@ bool MPEG::File::save(int tags, bool stripOthers, int id3v2Version)
 
 bool MPEG::File::save(int tags, bool stripOthers, int id3v2Version, bool duplicateTags)
 {
+  if(readInPart()) {
+    debug("MPEG::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   if(tags == NoTags && stripOthers)
     return strip(AllTags);
 
@@ -222,7 +230,14 @@ bool MPEG::File::save(int tags, bool stripOthers, int id3v2Version, bool duplica
       Tag::duplicate(ID3v2Tag(), ID3v1Tag(true), false);
   }
 
-  bool success = true;
+  // All changes are queued with their offsets in the file as it is now, and
+  // then done in a single pass over the file.
+
+  bool saveID3v2 = false;
+  bool saveID3v1 = false;
+  bool saveAPE = false;
+  int strippedTags = NoTags;
+  int freedTags = NoTags;
 
   if(ID3v2 & tags) {
 
@@ -231,70 +246,71 @@ bool MPEG::File::save(int tags, bool stripOthers, int id3v2Version, bool duplica
       if(!d->hasID3v2)
         d->ID3v2Location = 0;
 
-      insert(ID3v2Tag()->render(id3v2Version), d->ID3v2Location, d->ID3v2OriginalSize);
-
-      d->hasID3v2 = true;
-
-      // v1 tag location has changed, update if it exists
-
-      if(ID3v1Tag())
-        d->ID3v1Location = findID3v1();
-
-      // APE tag location has changed, update if it exists
-
-      if(APETag())
-        findAPE();
+      queueInsert(ID3v2Tag()->render(id3v2Version, true), d->ID3v2Location, d->ID3v2OriginalSize);
+      saveID3v2 = true;
     }
-    else if(stripOthers)
-      success = strip(ID3v2, false) && success;
+    else if(stripOthers && d->hasID3v2)
+      strippedTags |= ID3v2;
   }
   else if(d->hasID3v2 && stripOthers)
-    success = strip(ID3v2) && success;
+    freedTags |= ID3v2;
+
+  // Dont save an APE-tag unless one has been created
+
+  if((APE & tags) && APETag()) {
+    if(d->hasAPE)
+      queueInsert(APETag()->render(), d->APELocation, d->APEOriginalSize);
+    else if(d->hasID3v1)
+      queueInsert(APETag()->render(), d->ID3v1Location, 0);
+    else
+      queueInsert(APETag()->render(), length(), 0);
+    saveAPE = true;
+  }
+  else if(d->hasAPE && stripOthers)
+    strippedTags |= APE;
 
   if(ID3v1 & tags) {
     if(ID3v1Tag() && !ID3v1Tag()->isEmpty()) {
-      int offset = d->hasID3v1 ? -128 : 0;
-      seek(offset, End);
-      writeBlock(ID3v1Tag()->render());
-      d->hasID3v1 = true;
-      d->ID3v1Location = findID3v1();
+      if(d->hasID3v1)
+        queueInsert(ID3v1Tag()->render(), d->ID3v1Location, 128);
+      else
+        queueInsert(ID3v1Tag()->render(), length(), 0);
+      saveID3v1 = true;
     }
-    else if(stripOthers)
-      success = strip(ID3v1) && success;
+    else if(stripOthers && d->hasID3v1)
+      freedTags |= ID3v1;
   }
   else if(d->hasID3v1 && stripOthers)
-    success = strip(ID3v1, false) && success;
+    strippedTags |= ID3v1;
 
-  // Dont save an APE-tag unless one has been created
+  queueStrip(strippedTags | freedTags);
+  commitEdits();
 
-  if((APE & tags) && APETag()) {
-    if(d->hasAPE)
-      insert(APETag()->render(), d->APELocation, d->APEOriginalSize);
-    else {
-      if(d->hasID3v1) {
-        insert(APETag()->render(), d->ID3v1Location, 0);
-        d->APEOriginalSize = APETag()->footer()->completeTagSize();
-        d->hasAPE = true;
-        d->APELocation = d->ID3v1Location;
-        d->ID3v1Location += d->APEOriginalSize;
-      }
-      else {
-        seek(0, End);
-        d->APELocation = tell();
-        APE::Tag *apeTag = d->tag.access<APE::Tag>(APEIndex, false);
-        d->APEFooterLocation = d->APELocation
-                               + apeTag->footer()->completeTagSize()
-                               - APE::Footer::size();
-        writeBlock(APETag()->render());
-        d->APEOriginalSize = APETag()->footer()->completeTagSize();
-        d->hasAPE = true;
-      }
-    }
+  // Now that the file has its final layout, find the tags again.
+
+  markStripped(strippedTags, false);
+  markStripped(freedTags, true);
+
+  if(saveID3v2) {
+    d->hasID3v2 = true;
+    d->ID3v2OriginalSize = ID3v2Tag()->header()->completeTagSize();
   }
-  else if(d->hasAPE && stripOthers)
-    success = strip(APE, false) && success;
 
-  return success;
+  if(saveID3v1)
+    d->hasID3v1 = true;
+
+  if(d->hasID3v1)
+    d->ID3v1Location = findID3v1();
+
+  if(saveAPE) {
+    d->hasAPE = true;
+    d->APEOriginalSize = APETag()->footer()->completeTagSize();
+  }
+
+  if(d->hasAPE)
+    findAPE();
+
+  return true;
 }
 
 ID3v2::Tag *MPEG::File::ID3v2Tag(bool create)
@@ -324,48 +340,17 @@ bool MPEG::File::strip(int tags, bool freeMemory)
     return false;
   }
 
-  if((tags & ID3v2) && d->hasID3v2) {
-    removeBlock(d->ID3v2Location, d->ID3v2OriginalSize);
-    d->ID3v2Location = -1;
-    d->ID3v2OriginalSize = 0;
-    d->hasID3v2 = false;
-
-    if(freeMemory)
-      d->tag.set(ID3v2Index, 0);
-
-    // v1 tag location has changed, update if it exists
-
-    if(ID3v1Tag())
-      d->ID3v1Location = findID3v1();
+  queueStrip(tags);
+  commitEdits();
+  markStripped(tags, freeMemory);
 
-    // APE tag location has changed, update if it exists
+  // The tag locations have changed, update them if they exist
 
-   if(APETag())
-      findAPE();
-  }
-
-  if((tags & ID3v1) && d->hasID3v1) {
-    truncate(d->ID3v1Location);
-    d->ID3v1Location = -1;
-    d->hasID3v1 = false;
-
-    if(freeMemory)
-      d->tag.set(ID3v1Index, 0);
-  }
-
-  if((tags & APE) && d->hasAPE) {
-    removeBlock(d->APELocation, d->APEOriginalSize);
-    d->APELocation = -1;
-    d->APEFooterLocation = -1;
-    d->hasAPE = false;
-    if(d->hasID3v1) {
-      if(d->ID3v1Location > d->APELocation)
-        d->ID3v1Location -= d->APEOriginalSize;
-    }
+  if(d->hasID3v1)
+    d->ID3v1Location = findID3v1();
 
-    if(freeMemory)
-      d->tag.set(APEIndex, 0);
-  }
+  if(d->hasAPE)
+    findAPE();
 
   return true;
 }
@@ -383,7 +368,7 @@ long MPEG::File::nextFrameOffset(long position)
 
   while(true) {
     seek(position);
-    buffer = readBlock(bufferSize());
+    buffer = readBlock(streamBufferSize());
 
     if(buffer.size() <= 0)
       return -1;
@@ -407,7 +392,7 @@ long MPEG::File::previousFrameOffset(long position)
   ByteVector buffer;
 
   while (position > 0) {
-    long size = ulong(position) < bufferSize() ? position : bufferSize();
+    long size = ulong(position) < streamBufferSize() ? position : streamBufferSize();
     position -= size;
 
     seek(position);
@@ -471,7 +456,8 @@ void MPEG::File::read(bool readProperties, Properties::ReadStyle propertiesStyle
 
   if(d->ID3v2Location >= 0) {
 
-    d->tag.set(ID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory));
+    d->tag.set(ID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory,
+                                          readOptions()));
 
     d->ID3v2OriginalSize = ID3v2Tag()->header()->completeTagSize();
 
@@ -496,7 +482,7 @@ void MPEG::File::read(bool readProperties, Properties::ReadStyle propertiesStyle
 
   if(d->APELocation >= 0) {
 
-    d->tag.set(APEIndex, new APE::Tag(this, d->APEFooterLocation));
+    d->tag.set(APEIndex, new APE::Tag(this, d->APEFooterLocation, readOptions()));
     d->APEOriginalSize = APETag()->footer()->completeTagSize();
     d->hasAPE = true;
   }
@@ -516,7 +502,7 @@ long MPEG::File::findID3v2()
   // of some subtlteies -- specifically the need to look for the bit pattern of
   // an MPEG sync, it has been modified for use here.
 
-  if(isValid() && ID3v2::Header::fileIdentifier().size() <= bufferSize()) {
+  if(isValid() && ID3v2::Header::fileIdentifier().size() <= streamBufferSize()) {
 
     // The position in the file that the current buffer starts at.
 
@@ -550,18 +536,18 @@ long MPEG::File::findID3v2()
     // note this for use in the next itteration, where we will check for the rest
     // of the pattern.
 
-    for(buffer = readBlock(bufferSize()); buffer.size() > 0; buffer = readBlock(bufferSize())) {
+    for(buffer = readBlock(streamBufferSize()); buffer.size() > 0; buffer = readBlock(streamBufferSize())) {
 
       // (1) previous partial match
 
       if(previousPartialSynchMatch && secondSynchByte(buffer[0]))
         return -1;
 
-      if(previousPartialMatch >= 0 && int(bufferSize()) > previousPartialMatch) {
-        const int patternOffset = (bufferSize() - previousPartialMatch);
+      if(previousPartialMatch >= 0 && int(streamBufferSize()) > previousPartialMatch) {
+        const int patternOffset = (streamBufferSize() - previousPartialMatch);
         if(buffer.containsAt(ID3v2::Header::fileIdentifier(), 0, patternOffset)) {
           seek(originalPosition);
-          return bufferOffset - bufferSize() + previousPartialMatch;
+          return bufferOffset - streamBufferSize() + previousPartialMatch;
         }
       }
 
@@ -608,7 +594,7 @@ long MPEG::File::findID3v2()
 
       previousPartialMatch = buffer.endsWithPartialMatch(ID3v2::Header::fileIdentifier());
 
-      bufferOffset += bufferSize();
+      bufferOffset += streamBufferSize();
     }
 
     // Since we hit the end of the file, reset the status before continuing.
@@ -621,6 +607,47 @@ long MPEG::File::findID3v2()
   return -1;
 }
 
+void MPEG::File::queueStrip(int tags)
+{
+  if((tags & ID3v2) && d->hasID3v2)
+    queueRemoveBlock(d->ID3v2Location, d->ID3v2OriginalSize);
+
+  if((tags & APE) && d->hasAPE)
+    queueRemoveBlock(d->APELocation, d->APEOriginalSize);
+
+  if((tags & ID3v1) && d->hasID3v1)
+    queueRemoveBlock(d->ID3v1Location, length() - d->ID3v1Location);
+}
+
+void MPEG::File::markStripped(int tags, bool freeMemory)
+{
+  if((tags & ID3v2) && d->hasID3v2) {
+    d->ID3v2Location = -1;
+    d->ID3v2OriginalSize = 0;
+    d->hasID3v2 = false;
+
+    if(freeMemory)
+      d->tag.set(ID3v2Index, 0);
+  }
+
+  if((tags & ID3v1) && d->hasID3v1) {
+    d->ID3v1Location = -1;
+    d->hasID3v1 = false;
+
+    if(freeMemory)
+      d->tag.set(ID3v1Index, 0);
+  }
+
+  if((tags & APE) && d->hasAPE) {
+    d->APELocation = -1;
+    d->APEFooterLocation = -1;
+    d->hasAPE = false;
+
+    if(freeMemory)
+      d->tag.set(APEIndex, 0);
+  }
+}
+
 long MPEG::File::findID3v1()
 {
   if(isValid()) {
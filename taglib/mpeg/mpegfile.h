@@ -78,9 +78,12 @@ namespace TagLib {
        *
        * \deprecated This constructor will be dropped in favor of the one below
        * in a future version.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(FileName file, bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Constructs an MPEG file from \a file.  If \a readProperties is true the
@@ -90,11 +93,14 @@ namespace TagLib {
        * \a frameFactory.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       // BIC: merge with the above constructor
       File(FileName file, ID3v2::FrameFactory *frameFactory,
            bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Constructs an MPEG file from \a stream.  If \a readProperties is true the
@@ -107,10 +113,13 @@ namespace TagLib {
        * \a frameFactory.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
            bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Destroys this instance of the File.
@@ -142,9 +151,9 @@ namespace TagLib {
        * first one (in the order ID3v2, APE, ID3v1) will be converted to the
        * PropertyMap.
        */
-      PropertyMap properties() const;
+      virtual PropertyMap properties() const;
 
-      void removeUnsupportedProperties(const StringList &properties);
+      virtual void removeUnsupportedProperties(const StringList &properties);
 
       /*!
        * Implements the writing part of the unified tag dictionary interface.
@@ -154,7 +163,7 @@ namespace TagLib {
        * limitations of that format.
        * The returned PropertyMap refers to the ID3v2 tag only.
        */
-      PropertyMap setProperties(const PropertyMap &);
+      virtual PropertyMap setProperties(const PropertyMap &);
 
       /*!
        * Returns the MPEG::Properties for this file.  If no audio properties
@@ -374,6 +383,13 @@ namespace TagLib {
       long findID3v1();
       void findAPE();
 
+      /*!
+       * Queues removing the tags in \a tags from the file, and updates the
+       * state once they have been removed.
+       */
+      void queueStrip(int tags);
+      void markStripped(int tags, bool freeMemory);
+
       /*!
        * MPEG frames can be recognized by the bit pattern 11111111 111, so the
        * first byte is easy to check for, however checking to see if the second byte
@@ -70,7 +70,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 Ogg::FLAC::File::File(FileName file, bool readProperties,
-                      Properties::ReadStyle propertiesStyle) : Ogg::File(file)
+                      Properties::ReadStyle propertiesStyle,
+                      int readOptions) : Ogg::File(file, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -78,7 +79,8 @@ Ogg::FLAC::File::File(FileName file, bool readProperties,
 }
 
 Ogg::FLAC::File::File(IOStream *stream, bool readProperties,
-                      Properties::ReadStyle propertiesStyle) : Ogg::File(stream)
+                      Properties::ReadStyle propertiesStyle,
+                      int readOptions) : Ogg::File(stream, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -113,6 +115,11 @@ Properties *Ogg::FLAC::File::audioProperties() const
 
 bool Ogg::FLAC::File::save()
 {
+  if(readInPart()) {
+    debug("Ogg::FLAC::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   d->xiphCommentData = d->comment->render(false);
 
   // Create FLAC metadata-block:
@@ -170,7 +177,7 @@ void Ogg::FLAC::File::read(bool readProperties, Properties::ReadStyle properties
 
 
   if(d->hasXiphComment)
-    d->comment = new Ogg::XiphComment(xiphCommentData());
+    d->comment = new Ogg::XiphComment(xiphCommentData(), readOptions());
   else
     d->comment = new Ogg::XiphComment;
 
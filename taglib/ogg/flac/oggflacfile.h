@@ -68,9 +68,12 @@ namespace TagLib {
        * the file's audio properties will also be read.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(FileName file, bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Constructs an Ogg/FLAC file from \a stream.  If \a readProperties is true 
@@ -80,9 +83,12 @@ namespace TagLib {
        * responsible for deleting it after the File object.
        *
        * \note In the current implementation, \a propertiesStyle is ignored.
+       *
+       * \a readOptions is a combination of File::ReadOption values.
        */
       File(IOStream *stream, bool readProperties = true,
-           Properties::ReadStyle propertiesStyle = Properties::Average);
+           Properties::ReadStyle propertiesStyle = Properties::Average,
+           int readOptions = ReadAll);
 
       /*!
        * Destroys this instance of the File.
@@ -115,13 +121,13 @@ namespace TagLib {
        * Implements the unified property interface -- export function.
        * This forwards directly to XiphComment::properties().
        */
-      PropertyMap properties() const;
+      virtual PropertyMap properties() const;
 
       /*! 
        * Implements the unified tag dictionary interface -- import function.
        * Like properties(), this is a forwarder to the file's XiphComment.
        */
-      PropertyMap setProperties(const PropertyMap &); 
+      virtual PropertyMap setProperties(const PropertyMap &);
 
 
       /*!
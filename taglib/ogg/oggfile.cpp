@@ -218,6 +218,16 @@ Ogg::File::File(IOStream *stream) : TagLib::File(stream)
   d = new FilePrivate;
 }
 
+Ogg::File::File(FileName file, int readOptions) : TagLib::File(file, readOptions)
+{
+  d = new FilePrivate;
+}
+
+Ogg::File::File(IOStream *stream, int readOptions) : TagLib::File(stream, readOptions)
+{
+  d = new FilePrivate;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // private members
 ////////////////////////////////////////////////////////////////////////////////
@@ -102,6 +102,19 @@ namespace TagLib {
        */
       File(IOStream *stream);
 
+      /*!
+       * Constructs an Ogg file from \a file, which is read with \a readOptions.
+       */
+      // BIC: merge with the above
+      File(FileName file, int readOptions);
+
+      /*!
+       * Constructs an Ogg file from \a stream, which is read with
+       * \a readOptions.
+       */
+      // BIC: merge with the above
+      File(IOStream *stream, int readOptions);
+
     private:
       File(const File &);
       File &operator=(const File &);
@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include <tstring.h>
+#include <tbytevectorview.h>
 #include <tdebug.h>
 
 #include "oggpage.h"
@@ -195,6 +196,51 @@ ByteVector Ogg::Page::render() const
   return data;
 }
 
+bool Ogg::Page::checksumIsValid() const
+{
+  if(!d->file)
+    return true;
+
+  if(!d->header.isValid())
+    return false;
+
+  d->file->seek(d->fileOffset);
+  return checksumIsValid(d->file->readBlock(size()));
+}
+
+bool Ogg::Page::checksumIsValid(const ByteVector &data) // static
+{
+  const ByteVectorView view(data);
+
+  // The fixed part of the header is 27 bytes long and followed by the segment
+  // table, which gives the size of the data.
+
+  if(view.size() < 27 || !view.startsWith("OggS"))
+    return false;
+
+  const uint segmentCount = uchar(view[26]);
+  uint pageSize = 27 + segmentCount;
+
+  if(view.size() < pageSize)
+    return false;
+
+  for(uint i = 0; i < segmentCount; i++)
+    pageSize += uchar(view[27 + i]);
+
+  if(view.size() < pageSize)
+    return false;
+
+  // The checksum is taken with its own 4 bytes set to zero.
+
+  static const char zero[4] = { 0, 0, 0, 0 };
+
+  uint checksum = view.mid(0, 22).checksum();
+  checksum = ByteVectorView(zero, 4).checksum(checksum);
+  checksum = view.mid(26, pageSize - 26).checksum(checksum);
+
+  return (checksum == view.toUInt(22U, false));
+}
+
 List<Ogg::Page *> Ogg::Page::paginate(const ByteVectorList &packets,
                                       PaginationStrategy strategy,
                                       uint streamSerialNumber,
@@ -138,6 +138,22 @@ namespace TagLib {
 
       ByteVector render() const;
 
+      /*!
+       * Returns true if the CRC checksum stored in the page header matches the
+       * contents of the page.  This reads the whole page from the file.  Pages
+       * that were not read from a file always get a valid checksum when they
+       * are rendered, so this returns true for them.
+       */
+      bool checksumIsValid() const;
+
+      /*!
+       * Returns true if \a data starts with a complete Ogg page whose stored
+       * CRC checksum matches its contents.  Anything after the end of the page
+       * is ignored.  This does not need a File, so it can be used to check the
+       * pages of a stream as they are read.
+       */
+      static bool checksumIsValid(const ByteVector &data);
+
       /*!
        * Defines a strategy for pagination, or grouping pages into Ogg packets,
        * for use with pagination methods.
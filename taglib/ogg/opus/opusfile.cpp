@@ -59,16 +59,18 @@ public:
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-Opus::File::File(FileName file, bool readProperties, Properties::ReadStyle propertiesStyle) :
-  Ogg::File(file),
+Opus::File::File(FileName file, bool readProperties, Properties::ReadStyle propertiesStyle,
+                 int readOptions) :
+  Ogg::File(file, readOptions),
   d(new FilePrivate())
 {
   if(isOpen())
     read(readProperties, propertiesStyle);
 }
 
-Opus::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle propertiesStyle) :
-  Ogg::File(stream),
+Opus::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle propertiesStyle,
+                 int readOptions) :
+  Ogg::File(stream, readOptions),
   d(new FilePrivate())
 {
   if(isOpen())
@@ -102,6 +104,11 @@ Opus::Properties *Opus::File::audioProperties() const
 
 bool Opus::File::save()
 {
+  if(readInPart()) {
+    debug("Opus::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   if(!d->comment)
     d->comment = new Ogg::XiphComment;
 
@@ -132,7 +139,7 @@ void Opus::File::read(bool readProperties, Properties::ReadStyle propertiesStyle
     return;
   }
 
-  d->comment = new Ogg::XiphComment(commentHeaderData.mid(8));
+  d->comment = new Ogg::XiphComment(commentHeaderData.mid(8), readOptions());
 
   if(readProperties)
     d->properties = new Properties(this, propertiesStyle);
@@ -60,7 +60,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 Speex::File::File(FileName file, bool readProperties,
-                   Properties::ReadStyle propertiesStyle) : Ogg::File(file)
+                   Properties::ReadStyle propertiesStyle,
+                   int readOptions) : Ogg::File(file, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -68,7 +69,8 @@ Speex::File::File(FileName file, bool readProperties,
 }
 
 Speex::File::File(IOStream *stream, bool readProperties,
-                   Properties::ReadStyle propertiesStyle) : Ogg::File(stream)
+                   Properties::ReadStyle propertiesStyle,
+                   int readOptions) : Ogg::File(stream, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -102,6 +104,11 @@ Speex::Properties *Speex::File::audioProperties() const
 
 bool Speex::File::save()
 {
+  if(readInPart()) {
+    debug("Speex::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   if(!d->comment)
     d->comment = new Ogg::XiphComment;
 
@@ -125,7 +132,7 @@ void Speex::File::read(bool readProperties, Properties::ReadStyle propertiesStyl
 
   ByteVector commentHeaderData = packet(1);
 
-  d->comment = new Ogg::XiphComment(commentHeaderData);
+  d->comment = new Ogg::XiphComment(commentHeaderData, readOptions());
 
   if(readProperties)
     d->properties = new Properties(this, propertiesStyle);
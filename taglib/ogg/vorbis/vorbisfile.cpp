@@ -64,7 +64,8 @@ namespace TagLib {
 ////////////////////////////////////////////////////////////////////////////////
 
 Vorbis::File::File(FileName file, bool readProperties,
-                   Properties::ReadStyle propertiesStyle) : Ogg::File(file)
+                   Properties::ReadStyle propertiesStyle,
+                   int readOptions) : Ogg::File(file, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -72,7 +73,8 @@ Vorbis::File::File(FileName file, bool readProperties,
 }
 
 Vorbis::File::File(IOStream *stream, bool readProperties,
-                   Properties::ReadStyle propertiesStyle) : Ogg::File(stream)
+                   Properties::ReadStyle propertiesStyle,
+                   int readOptions) : Ogg::File(stream, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -106,6 +108,11 @@ Vorbis::Properties *Vorbis::File::audioProperties() const
 
 bool Vorbis::File::save()
 {
+  if(readInPart()) {
+    debug("Vorbis::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   ByteVector v(vorbisCommentHeaderID);
 
   if(!d->comment)
@@ -131,7 +138,7 @@ void Vorbis::File::read(bool readProperties, Properties::ReadStyle propertiesSty
     return;
   }
 
-  d->comment = new Ogg::XiphComment(commentHeaderData.mid(7));
+  d->comment = new Ogg::XiphComment(commentHeaderData.mid(7), readOptions());
 
   if(readProperties)
     d->properties = new Properties(this, propertiesStyle);
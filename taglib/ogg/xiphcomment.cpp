@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include <tbytevector.h>
+#include <tbytevectorview.h>
 #include <tdebug.h>
 
 #include <xiphcomment.h>
@@ -31,9 +32,47 @@
 
 using namespace TagLib;
 
+namespace
+{
+  // The keys of the fields which carry the basic fields.
+
+  const struct {
+    const char *key;
+    int field;
+  } fieldKeys[] = {
+    { "TITLE",       File::ReadTitle },
+    { "ARTIST",      File::ReadArtist },
+    { "ALBUM",       File::ReadAlbum },
+    { "DESCRIPTION", File::ReadComment },
+    { "COMMENT",     File::ReadComment },
+    { "GENRE",       File::ReadGenre },
+    { "DATE",        File::ReadYear },
+    { "YEAR",        File::ReadYear },
+    { "TRACKNUMBER", File::ReadTrack },
+    { "TRACKNUM",    File::ReadTrack }
+  };
+
+  // Returns true if the field with the undecoded key carries one of the
+  // fields in readOptions.  Keys are ASCII, so they can be compared before
+  // they are decoded.
+
+  bool isRequestedField(const ByteVectorView &key, int readOptions)
+  {
+    for(size_t i = 0; i < sizeof(fieldKeys) / sizeof(fieldKeys[0]); ++i) {
+      if((readOptions & fieldKeys[i].field) && key.equalsIgnoreCase(fieldKeys[i].key))
+        return true;
+    }
+
+    return false;
+  }
+}
+
 class Ogg::XiphComment::XiphCommentPrivate
 {
 public:
+  XiphCommentPrivate() : readOptions(File::ReadAll) {}
+
+  int readOptions;
   FieldListMap fieldListMap;
   String vendorID;
   String commentField;
@@ -48,9 +87,10 @@ Ogg::XiphComment::XiphComment() : TagLib::Tag()
   d = new XiphCommentPrivate;
 }
 
-Ogg::XiphComment::XiphComment(const ByteVector &data) : TagLib::Tag()
+Ogg::XiphComment::XiphComment(const ByteVector &data, int readOptions) : TagLib::Tag()
 {
   d = new XiphCommentPrivate;
+  d->readOptions = readOptions;
   parse(data);
 }
 
@@ -335,23 +375,28 @@ ByteVector Ogg::XiphComment::render(bool addFramingBit) const
 
 void Ogg::XiphComment::parse(const ByteVector &data)
 {
+  // The fields are read through a view of the packet so that none of them
+  // needs a ByteVector of its own.
+
+  const ByteVectorView view(data);
+
   // The first thing in the comment data is the vendor ID length, followed by a
   // UTF8 string with the vendor ID.
 
   uint pos = 0;
 
-  const uint vendorLength = data.toUInt(0, false);
+  const uint vendorLength = view.toUInt(0, false);
   pos += 4;
 
-  d->vendorID = String(data.mid(pos, vendorLength), String::UTF8);
+  d->vendorID = String(view.mid(pos, vendorLength), String::UTF8);
   pos += vendorLength;
 
   // Next the number of fields in the comment vector.
 
-  const uint commentFields = data.toUInt(pos, false);
+  const uint commentFields = view.toUInt(pos, false);
   pos += 4;
 
-  if(commentFields > (data.size() - 8) / 4) {
+  if(commentFields > (view.size() - 8) / 4) {
     return;
   }
 
@@ -360,22 +405,31 @@ void Ogg::XiphComment::parse(const ByteVector &data)
     // Each comment field is in the format "KEY=value" in a UTF8 string and has
     // 4 bytes before the text starts that gives the length.
 
-    const uint commentLength = data.toUInt(pos, false);
+    const uint commentLength = view.toUInt(pos, false);
     pos += 4;
 
-    String comment = String(data.mid(pos, commentLength), String::UTF8);
+    const ByteVectorView comment = view.mid(pos, commentLength);
     pos += commentLength;
-    if(pos > data.size()) {
+    if(pos > view.size()) {
       break;
     }
 
-    int commentSeparatorPosition = comment.find("=");
+    // '=' can not be part of a multibyte UTF8 sequence, so the field can be
+    // split before it is decoded.
+
+    const int commentSeparatorPosition = comment.find('=');
     if(commentSeparatorPosition == -1) {
       break;
     }
 
-    String key = comment.substr(0, commentSeparatorPosition);
-    String value = comment.substr(commentSeparatorPosition + 1);
+    if((d->readOptions & File::ReadBasicFields) &&
+       !isRequestedField(comment.mid(0, commentSeparatorPosition), d->readOptions))
+    {
+      continue;
+    }
+
+    const String key(comment.mid(0, commentSeparatorPosition), String::UTF8);
+    const String value(comment.mid(commentSeparatorPosition + 1), String::UTF8);
 
     addField(key, value, false);
   }
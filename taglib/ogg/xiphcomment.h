@@ -32,6 +32,7 @@
 #include "tstring.h"
 #include "tstringlist.h"
 #include "tbytevector.h"
+#include "tfile.h"
 #include "taglib_export.h"
 
 namespace TagLib {
@@ -70,9 +71,12 @@ namespace TagLib {
       XiphComment();
 
       /*!
-       * Constructs a Vorbis comment from \a data.
+       * Constructs a Vorbis comment from \a data.  If \a readOptions requests
+       * some of the basic fields, the other fields are skipped.
+       *
+       * \see File::ReadOption
        */
-      XiphComment(const ByteVector &data);
+      XiphComment(const ByteVector &data, int readOptions = File::ReadAll);
 
       /*!
        * Destroys this instance of the XiphComment.
@@ -60,7 +60,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 RIFF::AIFF::File::File(FileName file, bool readProperties,
-                       Properties::ReadStyle propertiesStyle) : RIFF::File(file, BigEndian)
+                       Properties::ReadStyle propertiesStyle,
+                       int readOptions) : RIFF::File(file, BigEndian, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -68,7 +69,8 @@ RIFF::AIFF::File::File(FileName file, bool readProperties,
 }
 
 RIFF::AIFF::File::File(IOStream *stream, bool readProperties,
-                       Properties::ReadStyle propertiesStyle) : RIFF::File(stream, BigEndian)
+                       Properties::ReadStyle propertiesStyle,
+                       int readOptions) : RIFF::File(stream, BigEndian, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -113,6 +115,11 @@ bool RIFF::AIFF::File::save()
     return false;
   }
 
+  if(readInPart()) {
+    debug("RIFF::AIFF::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   if(!isValid()) {
     debug("RIFF::AIFF::File::save() -- Trying to save invalid file.");
     return false;
@@ -133,7 +140,8 @@ void RIFF::AIFF::File::read(bool readProperties, Properties::ReadStyle propertie
   for(uint i = 0; i < chunkCount(); i++) {
     if(chunkName(i) == "ID3 " || chunkName(i) == "id3 ") {
       d->tagChunkID = chunkName(i);
-      d->tag = new ID3v2::Tag(this, chunkOffset(i));
+      d->tag = new ID3v2::Tag(this, chunkOffset(i), ID3v2::FrameFactory::instance(),
+                              readOptions());
     }
     else if(chunkName(i) == "COMM" && readProperties)
       d->properties = new Properties(chunkData(i), propertiesStyle);
@@ -88,6 +88,26 @@ RIFF::File::File(IOStream *stream, Endianness endianness) : TagLib::File(stream)
     read();
 }
 
+RIFF::File::File(FileName file, Endianness endianness, int readOptions) :
+  TagLib::File(file, readOptions)
+{
+  d = new FilePrivate;
+  d->endianness = endianness;
+
+  if(isOpen())
+    read();
+}
+
+RIFF::File::File(IOStream *stream, Endianness endianness, int readOptions) :
+  TagLib::File(stream, readOptions)
+{
+  d = new FilePrivate;
+  d->endianness = endianness;
+
+  if(isOpen())
+    read();
+}
+
 TagLib::uint RIFF::File::riffSize() const
 {
   return d->size;
@@ -143,11 +163,12 @@ void RIFF::File::setChunkData(uint i, const ByteVector &data)
   // First we update the global size
 
   d->size += ((data.size() + 1) & ~1) - (d->chunks[i].size + d->chunks[i].padding);
-  insert(ByteVector::fromUInt(d->size, d->endianness == BigEndian), 4, 4);
+  queueInsert(ByteVector::fromUInt(d->size, d->endianness == BigEndian), 4, 4);
 
   // Now update the specific chunk
 
   writeChunk(chunkName(i), data, d->chunks[i].offset - 8, d->chunks[i].size + d->chunks[i].padding + 8);
+  commitEdits();
 
   d->chunks[i].size = data.size();
   d->chunks[i].padding = (data.size() & 0x01) ? 1 : 0;
@@ -192,11 +213,12 @@ void RIFF::File::setChunkData(const ByteVector &name, const ByteVector &data, bo
   // First we update the global size
 
   d->size += (offset & 1) + data.size() + 8;
-  insert(ByteVector::fromUInt(d->size, d->endianness == BigEndian), 4, 4);
+  queueInsert(ByteVector::fromUInt(d->size, d->endianness == BigEndian), 4, 4);
 
   // Now add the chunk to the file
 
   writeChunk(name, data, offset, std::max<long>(0, length() - offset), (offset & 1) ? 1 : 0);
+  commitEdits();
 
   // And update our internal structure
 
@@ -228,11 +250,12 @@ void RIFF::File::removeChunk(const ByteVector &name)
   std::vector<Chunk> newChunks;
   for(size_t i = 0; i < d->chunks.size(); ++i) {
     if(d->chunks[i].name == name)
-      removeBlock(d->chunks[i].offset - 8, d->chunks[i].size + 8);
+      queueRemoveBlock(d->chunks[i].offset - 8, d->chunks[i].size + 8);
     else
       newChunks.push_back(d->chunks[i]);
   }
 
+  commitEdits();
   d->chunks.swap(newChunks);
 }
 
@@ -316,5 +339,5 @@ void RIFF::File::writeChunk(const ByteVector &name, const ByteVector &data,
   if((data.size() & 0x01) != 0) {
     combined.append('\x00');
   }
-  insert(combined, offset, replace);
+  queueInsert(combined, offset, replace);
 }
@@ -58,6 +58,10 @@ namespace TagLib {
       File(FileName file, Endianness endianness);
       File(IOStream *stream, Endianness endianness);
 
+      // BIC: merge with the above
+      File(FileName file, Endianness endianness, int readOptions);
+      File(IOStream *stream, Endianness endianness, int readOptions);
+
       /*!
        * \return The size of the main RIFF chunk.
        */
@@ -71,7 +71,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 RIFF::WAV::File::File(FileName file, bool readProperties,
-                       Properties::ReadStyle propertiesStyle) : RIFF::File(file, LittleEndian)
+                       Properties::ReadStyle propertiesStyle,
+                       int readOptions) : RIFF::File(file, LittleEndian, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -79,7 +80,8 @@ RIFF::WAV::File::File(FileName file, bool readProperties,
 }
 
 RIFF::WAV::File::File(IOStream *stream, bool readProperties,
-                       Properties::ReadStyle propertiesStyle) : RIFF::File(stream, LittleEndian)
+                       Properties::ReadStyle propertiesStyle,
+                       int readOptions) : RIFF::File(stream, LittleEndian, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -138,6 +140,11 @@ bool RIFF::WAV::File::save(TagTypes tags, bool stripOthers, int id3v2Version)
     return false;
   }
 
+  if(readInPart()) {
+    debug("RIFF::WAV::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   if(!isValid()) {
     debug("RIFF::WAV::File::save() -- Trying to save invalid file.");
     return false;
@@ -192,7 +199,8 @@ void RIFF::WAV::File::read(bool readProperties, Properties::ReadStyle properties
     String name = chunkName(i);
     if(name == "ID3 " || name == "id3 ") {
       d->tagChunkID = chunkName(i);
-      d->tag.set(ID3v2Index, new ID3v2::Tag(this, chunkOffset(i)));
+      d->tag.set(ID3v2Index, new ID3v2::Tag(this, chunkOffset(i), ID3v2::FrameFactory::instance(),
+                                            readOptions()));
       d->hasID3v2 = true;
     }
     else if(name == "fmt " && readProperties)
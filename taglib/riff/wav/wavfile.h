@@ -74,9 +74,12 @@ namespace TagLib {
          * file's audio properties will also be read.
          *
          * \note In the current implementation, \a propertiesStyle is ignored.
+         *
+         * \a readOptions is a combination of File::ReadOption values.
          */
         File(FileName file, bool readProperties = true,
-             Properties::ReadStyle propertiesStyle = Properties::Average);
+             Properties::ReadStyle propertiesStyle = Properties::Average,
+             int readOptions = ReadAll);
 
         /*!
          * Constructs a WAV file from \a stream.  If \a readProperties is true the
@@ -86,9 +89,12 @@ namespace TagLib {
          * responsible for deleting it after the File object.
          *
          * \note In the current implementation, \a propertiesStyle is ignored.
+         *
+         * \a readOptions is a combination of File::ReadOption values.
          */
         File(IOStream *stream, bool readProperties = true,
-             Properties::ReadStyle propertiesStyle = Properties::Average);
+             Properties::ReadStyle propertiesStyle = Properties::Average,
+             int readOptions = ReadAll);
 
         /*!
          * Destroys this instance of the File.
@@ -129,15 +135,15 @@ namespace TagLib {
          * Implements the unified property interface -- export function.
          * This method forwards to ID3v2::Tag::properties().
          */
-        PropertyMap properties() const;
+        virtual PropertyMap properties() const;
 
-        void removeUnsupportedProperties(const StringList &properties);
+        virtual void removeUnsupportedProperties(const StringList &properties);
 
         /*!
          * Implements the unified property interface -- import function.
          * This method forwards to ID3v2::Tag::setProperties().
          */
-        PropertyMap setProperties(const PropertyMap &);
+        virtual PropertyMap setProperties(const PropertyMap &);
 
         /*!
          * Returns the WAV::Properties for this file.  If no audio properties
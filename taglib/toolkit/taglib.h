@@ -44,6 +44,12 @@
 #define TAGLIB_CONSTRUCT_BITSET(x) static_cast<unsigned long>(x)
 #endif
 
+// Rvalue references: the toolkit classes get move constructors, move
+// assignment and rvalue overloads of their insertion methods.
+#if __cplusplus >= 201103L || defined(__GXX_EXPERIMENTAL_CXX0X__) || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define TAGLIB_HAVE_RVALUE_REFERENCES
+#endif
+
 #include <string>
 
 //! A namespace for all TagLib related classes and functions
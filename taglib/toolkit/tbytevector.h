@@ -30,6 +30,7 @@
 #include "taglib_export.h"
 
 #include <vector>
+#include <iterator>
 #include <iostream>
 
 namespace TagLib {
@@ -46,10 +47,10 @@ namespace TagLib {
   {
   public:
 #ifndef DO_NOT_DOCUMENT
-    typedef std::vector<char>::iterator Iterator;
-    typedef std::vector<char>::const_iterator ConstIterator;
-    typedef std::vector<char>::reverse_iterator ReverseIterator;
-    typedef std::vector<char>::const_reverse_iterator ConstReverseIterator;
+    typedef char *Iterator;
+    typedef const char *ConstIterator;
+    typedef std::reverse_iterator<char *> ReverseIterator;
+    typedef std::reverse_iterator<const char *> ConstReverseIterator;
 #endif
 
     /*!
@@ -68,6 +69,14 @@ namespace TagLib {
      */
     ByteVector(const ByteVector &v);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Constructs a byte vector that takes over the data of \a v, leaving
+     * \a v empty.
+     */
+    ByteVector(ByteVector &&v);
+#endif
+
     /*!
      * Constructs a byte vector that is a copy of \a v.
      */
@@ -474,6 +483,13 @@ namespace TagLib {
      */
     ByteVector &operator=(const ByteVector &v);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Takes over the data of \a v, leaving \a v empty.
+     */
+    ByteVector &operator=(ByteVector &&v);
+#endif
+
     /*!
      * Copies ByteVector \a v.
      */
@@ -505,7 +521,35 @@ namespace TagLib {
 
   private:
     class ByteVectorPrivate;
-    ByteVectorPrivate *d;
+
+    /*!
+     * Takes over \a data, which holds a single reference, and covers all of
+     * its bytes.
+     */
+    explicit ByteVector(ByteVectorPrivate *data);
+
+    /*!
+     * Sets up the storage of a newly constructed vector for \a size bytes and
+     * returns it.
+     */
+    char *allocate(uint size);
+
+    /*!
+     * Vectors of up to this many bytes keep them in the object itself.
+     */
+    enum { InlineSize = 24 };
+
+    /*
+     * A larger buffer is shared between implicit copies and the results of
+     * mid(), which is why the part of it that this vector covers is kept
+     * here.  m_offset is 0xffffffff while the bytes are stored inline.
+     */
+    union {
+      ByteVectorPrivate *d;
+      char m_inline[InlineSize];
+    };
+    uint m_offset;
+    uint m_size;
   };
 }
 
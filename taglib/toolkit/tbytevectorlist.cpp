@@ -80,6 +80,27 @@ ByteVectorList::ByteVectorList(const ByteVectorList &l) : List<ByteVector>(l)
 
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+ByteVectorList::ByteVectorList(ByteVectorList &&l) : List<ByteVector>(std::move(l))
+{
+
+}
+
+ByteVectorList &ByteVectorList::operator=(const ByteVectorList &l)
+{
+  List<ByteVector>::operator=(l);
+  return *this;
+}
+
+ByteVectorList &ByteVectorList::operator=(ByteVectorList &&l)
+{
+  List<ByteVector>::operator=(std::move(l));
+  return *this;
+}
+
+#endif
+
 ByteVectorList::~ByteVectorList()
 {
 
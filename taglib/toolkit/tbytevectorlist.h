@@ -59,6 +59,23 @@ namespace TagLib {
      */
     ByteVectorList(const ByteVectorList &l);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Constructs a list that takes over the data of \a l.
+     */
+    ByteVectorList(ByteVectorList &&l);
+
+    /*!
+     * Make a shallow, implicitly shared, copy of \a l.
+     */
+    ByteVectorList &operator=(const ByteVectorList &l);
+
+    /*!
+     * Exchanges the data of this list with that of \a l.
+     */
+    ByteVectorList &operator=(ByteVectorList &&l);
+#endif
+
     /*!
      * Convert the ByteVectorList to a ByteVector separated by \a separator.  By
      * default a space is used.
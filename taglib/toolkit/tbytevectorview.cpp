@@ -0,0 +1,809 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#if defined(HAVE_SSE2)
+# include <emmintrin.h>
+#endif
+
+#if defined(HAVE_GCC_AVX2) || defined(HAVE_MSC_AVX2)
+# include <immintrin.h>
+#endif
+
+#if defined(HAVE_GCC_PCLMUL) || defined(HAVE_MSC_PCLMUL)
+# include <wmmintrin.h>
+# include <tmmintrin.h>
+#endif
+
+#include <tstring.h>
+#include <tdebug.h>
+#include "tutils.h"
+
+#include "tbytevector.h"
+#include "tbytevectorview.h"
+
+namespace TagLib {
+
+/*!
+  * A templatized straightforward find that works with the types 
+  * plain pointers and std::reverse_iterator.
+  */
+template <class TIterator>
+int findChar(
+  const TIterator dataBegin, const TIterator dataEnd,
+  char c, uint offset, int byteAlign)
+{
+  const size_t dataSize = dataEnd - dataBegin;
+  if(dataSize == 0 || offset > dataSize - 1)
+    return -1;
+
+  // n % 0 is invalid
+
+  if(byteAlign == 0)
+    return -1;
+
+  for(TIterator it = dataBegin + offset; it < dataEnd; it += byteAlign) {
+    if(*it == c)
+      return (it - dataBegin);
+  }
+
+  return -1;
+}
+
+/*!
+  * A templatized KMP find that works with the types 
+  * plain pointers and std::reverse_iterator.
+  */
+template <class TIterator>
+int findVector(
+  const TIterator dataBegin, const TIterator dataEnd,
+  const TIterator patternBegin, const TIterator patternEnd,
+  uint offset, int byteAlign)
+{
+  const size_t dataSize    = dataEnd    - dataBegin;
+  const size_t patternSize = patternEnd - patternBegin;
+  if(patternSize > dataSize || offset > dataSize - 1)
+    return -1;
+
+  // n % 0 is invalid
+
+  if(byteAlign == 0)
+    return -1;
+
+  // Special case that pattern contains just single char.
+
+  if(patternSize == 1)
+    return findChar(dataBegin, dataEnd, *patternBegin, offset, byteAlign);
+
+  size_t lastOccurrence[256];
+
+  for(size_t i = 0; i < 256; ++i)
+    lastOccurrence[i] = patternSize;
+
+  for(size_t i = 0; i < patternSize - 1; ++i)
+    lastOccurrence[static_cast<uchar>(*(patternBegin + i))] = patternSize - i - 1;
+
+  TIterator it = dataBegin + patternSize - 1 + offset;
+  while(true)
+  {
+    TIterator itBuffer = it;
+    TIterator itPattern = patternBegin + patternSize - 1;
+
+    while(*itBuffer == *itPattern)
+    {
+      if(itPattern == patternBegin)
+      {
+        if((itBuffer - dataBegin - offset) % byteAlign == 0)
+          return (itBuffer - dataBegin);
+        else
+          break;
+      }
+
+      --itBuffer;
+      --itPattern;
+    }
+
+    const size_t step = lastOccurrence[static_cast<uchar>(*it)];
+    if(dataEnd - step <= it)
+      break;
+
+    it += step;
+  }
+
+  return -1;
+}
+
+// The pointer based searches below are used for the common case of byteAlign
+// being 1.  Each of them looks for the first and the last byte of the pattern
+// at once in a block of candidate positions and only compares the whole
+// pattern where both of them match.
+
+namespace
+{
+  inline uint lowestBit(uint mask)
+  {
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    uint bit = 0;
+    while(!(mask & 1)) {
+      mask >>= 1;
+      ++bit;
+    }
+    return bit;
+#endif
+  }
+
+  inline uint highestBit(uint mask)
+  {
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(mask);
+#else
+    uint bit = 31;
+    while(!(mask & 0x80000000)) {
+      mask <<= 1;
+      --bit;
+    }
+    return bit;
+#endif
+  }
+
+  inline bool matchesAt(const char *data, const char *pattern, size_t patternSize)
+  {
+    return (patternSize <= 2 || ::memcmp(data + 1, pattern + 1, patternSize - 2) == 0);
+  }
+
+  // Each of these looks for \a pattern at the positions [begin, end) of
+  // \a data, and returns the position or -1.  The caller makes sure that the
+  // whole pattern fits into the data at all of the positions.
+
+  long findForwardScalar(const char *data, size_t begin, size_t end,
+                         const char *pattern, size_t patternSize)
+  {
+    const char first = pattern[0];
+    const char last  = pattern[patternSize - 1];
+
+    while(begin < end) {
+      const char *p = static_cast<const char *>(::memchr(data + begin, first, end - begin));
+      if(!p)
+        break;
+
+      begin = p - data;
+      if(p[patternSize - 1] == last && matchesAt(p, pattern, patternSize))
+        return begin;
+
+      ++begin;
+    }
+
+    return -1;
+  }
+
+  long findBackwardScalar(const char *data, size_t begin, size_t end,
+                          const char *pattern, size_t patternSize)
+  {
+    const char first = pattern[0];
+    const char last  = pattern[patternSize - 1];
+
+    while(end > begin) {
+      --end;
+      if(data[end] == first && data[end + patternSize - 1] == last
+         && matchesAt(data + end, pattern, patternSize))
+        return end;
+    }
+
+    return -1;
+  }
+
+#if defined(HAVE_SSE2)
+
+  long findForwardSSE2(const char *data, size_t begin, size_t end,
+                       const char *pattern, size_t patternSize)
+  {
+    const __m128i first = _mm_set1_epi8(pattern[0]);
+    const __m128i last  = _mm_set1_epi8(pattern[patternSize - 1]);
+
+    for(; begin + 16 <= end; begin += 16) {
+      const char *p = data + begin;
+      const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+      const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + patternSize - 1));
+
+      uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(x, first), _mm_cmpeq_epi8(y, last)));
+      while(mask != 0) {
+        const uint bit = lowestBit(mask);
+        if(matchesAt(p + bit, pattern, patternSize))
+          return begin + bit;
+        mask &= mask - 1;
+      }
+    }
+
+    return findForwardScalar(data, begin, end, pattern, patternSize);
+  }
+
+  long findBackwardSSE2(const char *data, size_t begin, size_t end,
+                        const char *pattern, size_t patternSize)
+  {
+    const __m128i first = _mm_set1_epi8(pattern[0]);
+    const __m128i last  = _mm_set1_epi8(pattern[patternSize - 1]);
+
+    for(; end >= begin + 16; end -= 16) {
+      const char *p = data + end - 16;
+      const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+      const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + patternSize - 1));
+
+      uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(x, first), _mm_cmpeq_epi8(y, last)));
+      while(mask != 0) {
+        const uint bit = highestBit(mask);
+        if(matchesAt(p + bit, pattern, patternSize))
+          return end - 16 + bit;
+        mask &= ~(1U << bit);
+      }
+    }
+
+    return findBackwardScalar(data, begin, end, pattern, patternSize);
+  }
+
+#endif
+
+#if defined(TAGLIB_TARGET_AVX2)
+
+  TAGLIB_TARGET_AVX2
+  long findForwardAVX2(const char *data, size_t begin, size_t end,
+                       const char *pattern, size_t patternSize)
+  {
+    const __m256i first = _mm256_set1_epi8(pattern[0]);
+    const __m256i last  = _mm256_set1_epi8(pattern[patternSize - 1]);
+
+    for(; begin + 32 <= end; begin += 32) {
+      const char *p = data + begin;
+      const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+      const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + patternSize - 1));
+
+      uint mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(x, first), _mm256_cmpeq_epi8(y, last)));
+      while(mask != 0) {
+        const uint bit = lowestBit(mask);
+        if(matchesAt(p + bit, pattern, patternSize))
+          return begin + bit;
+        mask &= mask - 1;
+      }
+    }
+
+    return findForwardScalar(data, begin, end, pattern, patternSize);
+  }
+
+  TAGLIB_TARGET_AVX2
+  long findBackwardAVX2(const char *data, size_t begin, size_t end,
+                        const char *pattern, size_t patternSize)
+  {
+    const __m256i first = _mm256_set1_epi8(pattern[0]);
+    const __m256i last  = _mm256_set1_epi8(pattern[patternSize - 1]);
+
+    for(; end >= begin + 32; end -= 32) {
+      const char *p = data + end - 32;
+      const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+      const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + patternSize - 1));
+
+      uint mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(x, first), _mm256_cmpeq_epi8(y, last)));
+      while(mask != 0) {
+        const uint bit = highestBit(mask);
+        if(matchesAt(p + bit, pattern, patternSize))
+          return end - 32 + bit;
+        mask &= ~(1U << bit);
+      }
+    }
+
+    return findBackwardScalar(data, begin, end, pattern, patternSize);
+  }
+
+#endif
+
+  long findForward(const char *data, size_t begin, size_t end,
+                   const char *pattern, size_t patternSize)
+  {
+    // A single byte is best left to memchr(), which is vectorized by most C
+    // libraries already.
+
+    if(patternSize == 1)
+      return findForwardScalar(data, begin, end, pattern, patternSize);
+
+#if defined(TAGLIB_TARGET_AVX2)
+    if(cpuSupportsAVX2())
+      return findForwardAVX2(data, begin, end, pattern, patternSize);
+#endif
+
+#if defined(HAVE_SSE2)
+    return findForwardSSE2(data, begin, end, pattern, patternSize);
+#else
+    return findForwardScalar(data, begin, end, pattern, patternSize);
+#endif
+  }
+
+  long findBackward(const char *data, size_t begin, size_t end,
+                    const char *pattern, size_t patternSize)
+  {
+#if defined(TAGLIB_TARGET_AVX2)
+    if(cpuSupportsAVX2())
+      return findBackwardAVX2(data, begin, end, pattern, patternSize);
+#endif
+
+#if defined(HAVE_SSE2)
+    return findBackwardSSE2(data, begin, end, pattern, patternSize);
+#else
+    return findBackwardScalar(data, begin, end, pattern, patternSize);
+#endif
+  }
+}
+
+template <class T>
+T toNumber(const ByteVectorView &v, size_t offset, size_t length, bool mostSignificantByteFirst)
+{
+  if(offset >= v.size()) {
+    debug("toNumber<T>() -- No data to convert. Returning 0.");
+    return 0;
+  }
+
+  length = std::min(length, v.size() - offset);
+
+  T sum = 0;
+  for(size_t i = 0; i < length; i++) {
+    const size_t shift = (mostSignificantByteFirst ? length - 1 - i : i) * 8;
+    sum |= static_cast<T>(static_cast<uchar>(v[offset + i])) << shift;
+  }
+
+  return sum;
+}
+
+template <class T>
+T toNumber(const ByteVectorView &v, size_t offset, bool mostSignificantByteFirst)
+{
+  if(offset + sizeof(T) > v.size()) 
+    return toNumber<T>(v, offset, v.size() - offset, mostSignificantByteFirst);
+
+  // Uses memcpy instead of reinterpret_cast to avoid an alignment exception.
+  T tmp;
+  ::memcpy(&tmp, v.data() + offset, sizeof(T));
+
+#if SYSTEM_BYTEORDER == 1
+  const bool swap = mostSignificantByteFirst;
+#else
+  const bool swap = !mostSignificantByteFirst;
+#endif
+  if(swap)
+    return byteSwap(tmp);
+  else
+    return tmp;
+}
+
+
+// The CRC used by Ogg: polynomial 0x04c11db7, not reflected, without initial
+// or final xor.  crcTable is the usual byte at a time table.
+
+static const uint crcTable[256] = {
+  0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9, 0x130476dc, 0x17c56b6b,
+  0x1a864db2, 0x1e475005, 0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61,
+  0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd, 0x4c11db70, 0x48d0c6c7,
+  0x4593e01e, 0x4152fda9, 0x5f15adac, 0x5bd4b01b, 0x569796c2, 0x52568b75,
+  0x6a1936c8, 0x6ed82b7f, 0x639b0da6, 0x675a1011, 0x791d4014, 0x7ddc5da3,
+  0x709f7b7a, 0x745e66cd, 0x9823b6e0, 0x9ce2ab57, 0x91a18d8e, 0x95609039,
+  0x8b27c03c, 0x8fe6dd8b, 0x82a5fb52, 0x8664e6e5, 0xbe2b5b58, 0xbaea46ef,
+  0xb7a96036, 0xb3687d81, 0xad2f2d84, 0xa9ee3033, 0xa4ad16ea, 0xa06c0b5d,
+  0xd4326d90, 0xd0f37027, 0xddb056fe, 0xd9714b49, 0xc7361b4c, 0xc3f706fb,
+  0xceb42022, 0xca753d95, 0xf23a8028, 0xf6fb9d9f, 0xfbb8bb46, 0xff79a6f1,
+  0xe13ef6f4, 0xe5ffeb43, 0xe8bccd9a, 0xec7dd02d, 0x34867077, 0x30476dc0,
+  0x3d044b19, 0x39c556ae, 0x278206ab, 0x23431b1c, 0x2e003dc5, 0x2ac12072,
+  0x128e9dcf, 0x164f8078, 0x1b0ca6a1, 0x1fcdbb16, 0x018aeb13, 0x054bf6a4,
+  0x0808d07d, 0x0cc9cdca, 0x7897ab07, 0x7c56b6b0, 0x71159069, 0x75d48dde,
+  0x6b93dddb, 0x6f52c06c, 0x6211e6b5, 0x66d0fb02, 0x5e9f46bf, 0x5a5e5b08,
+  0x571d7dd1, 0x53dc6066, 0x4d9b3063, 0x495a2dd4, 0x44190b0d, 0x40d816ba,
+  0xaca5c697, 0xa864db20, 0xa527fdf9, 0xa1e6e04e, 0xbfa1b04b, 0xbb60adfc,
+  0xb6238b25, 0xb2e29692, 0x8aad2b2f, 0x8e6c3698, 0x832f1041, 0x87ee0df6,
+  0x99a95df3, 0x9d684044, 0x902b669d, 0x94ea7b2a, 0xe0b41de7, 0xe4750050,
+  0xe9362689, 0xedf73b3e, 0xf3b06b3b, 0xf771768c, 0xfa325055, 0xfef34de2,
+  0xc6bcf05f, 0xc27dede8, 0xcf3ecb31, 0xcbffd686, 0xd5b88683, 0xd1799b34,
+  0xdc3abded, 0xd8fba05a, 0x690ce0ee, 0x6dcdfd59, 0x608edb80, 0x644fc637,
+  0x7a089632, 0x7ec98b85, 0x738aad5c, 0x774bb0eb, 0x4f040d56, 0x4bc510e1,
+  0x46863638, 0x42472b8f, 0x5c007b8a, 0x58c1663d, 0x558240e4, 0x51435d53,
+  0x251d3b9e, 0x21dc2629, 0x2c9f00f0, 0x285e1d47, 0x36194d42, 0x32d850f5,
+  0x3f9b762c, 0x3b5a6b9b, 0x0315d626, 0x07d4cb91, 0x0a97ed48, 0x0e56f0ff,
+  0x1011a0fa, 0x14d0bd4d, 0x19939b94, 0x1d528623, 0xf12f560e, 0xf5ee4bb9,
+  0xf8ad6d60, 0xfc6c70d7, 0xe22b20d2, 0xe6ea3d65, 0xeba91bbc, 0xef68060b,
+  0xd727bbb6, 0xd3e6a601, 0xdea580d8, 0xda649d6f, 0xc423cd6a, 0xc0e2d0dd,
+  0xcda1f604, 0xc960ebb3, 0xbd3e8d7e, 0xb9ff90c9, 0xb4bcb610, 0xb07daba7,
+  0xae3afba2, 0xaafbe615, 0xa7b8c0cc, 0xa379dd7b, 0x9b3660c6, 0x9ff77d71,
+  0x92b45ba8, 0x9675461f, 0x8832161a, 0x8cf30bad, 0x81b02d74, 0x857130c3,
+  0x5d8a9099, 0x594b8d2e, 0x5408abf7, 0x50c9b640, 0x4e8ee645, 0x4a4ffbf2,
+  0x470cdd2b, 0x43cdc09c, 0x7b827d21, 0x7f436096, 0x7200464f, 0x76c15bf8,
+  0x68860bfd, 0x6c47164a, 0x61043093, 0x65c52d24, 0x119b4be9, 0x155a565e,
+  0x18197087, 0x1cd86d30, 0x029f3d35, 0x065e2082, 0x0b1d065b, 0x0fdc1bec,
+  0x3793a651, 0x3352bbe6, 0x3e119d3f, 0x3ad08088, 0x2497d08d, 0x2056cd3a,
+  0x2d15ebe3, 0x29d4f654, 0xc5a92679, 0xc1683bce, 0xcc2b1d17, 0xc8ea00a0,
+  0xd6ad50a5, 0xd26c4d12, 0xdf2f6bcb, 0xdbee767c, 0xe3a1cbc1, 0xe760d676,
+  0xea23f0af, 0xeee2ed18, 0xf0a5bd1d, 0xf464a0aa, 0xf9278673, 0xfde69bc4,
+  0x89b8fd09, 0x8d79e0be, 0x803ac667, 0x84fbdbd0, 0x9abc8bd5, 0x9e7d9662,
+  0x933eb0bb, 0x97ffad0c, 0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668,
+  0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4
+};
+
+namespace
+{
+  // Entry i of table k is the checksum of the byte i followed by k zero bytes,
+  // which lets the "slicing by 8" loop below look up 8 bytes independently.
+
+  class CRCTables
+  {
+  public:
+    CRCTables()
+    {
+      for(int i = 0; i < 256; i++)
+        table[0][i] = crcTable[i];
+
+      for(int k = 1; k < 8; k++) {
+        for(int i = 0; i < 256; i++)
+          table[k][i] = (table[k - 1][i] << 8) ^ crcTable[table[k - 1][i] >> 24];
+      }
+    }
+
+    uint table[8][256];
+  };
+
+  const CRCTables crcTables;
+
+  uint checksumBytes(uint crc, const uchar *p, size_t length)
+  {
+    for(; length > 0; ++p, --length)
+      crc = (crc << 8) ^ crcTable[(crc >> 24) ^ *p];
+
+    return crc;
+  }
+
+  uint checksumSliced(uint crc, const uchar *p, size_t length)
+  {
+    const uint (*t)[256] = crcTables.table;
+
+    for(; length >= 8; p += 8, length -= 8) {
+      crc ^= (uint(p[0]) << 24) | (uint(p[1]) << 16) | (uint(p[2]) << 8) | uint(p[3]);
+      crc = t[7][crc >> 24] ^ t[6][(crc >> 16) & 0xff] ^ t[5][(crc >> 8) & 0xff] ^ t[4][crc & 0xff]
+        ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+    }
+
+    return checksumBytes(crc, p, length);
+  }
+
+#if defined(TAGLIB_TARGET_PCLMUL)
+
+  // The data is folded into a 128 bit value that leaves the same remainder
+  // when divided by the polynomial, as described in "Fast CRC Computation for
+  // Generic Polynomials Using PCLMULQDQ Instruction" by Intel.  The bytes are
+  // reversed on loading, so that bit n of a register is the coefficient of
+  // x^n.  The remaining 16 bytes of the folded value are left to the tables,
+  // which saves the Barrett reduction.
+
+  TAGLIB_TARGET_PCLMUL
+  inline __m128i foldBlock(__m128i x, __m128i k, __m128i next)
+  {
+    // x * x^n mod P as x.hi * (x^(n + 64) mod P) + x.lo * (x^n mod P), plus
+    // the next block.
+
+    return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11),
+                                       _mm_clmulepi64_si128(x, k, 0x00)), next);
+  }
+
+  TAGLIB_TARGET_PCLMUL
+  uint checksumPCLMUL(uint crc, const uchar *p, size_t length)
+  {
+    // The caller makes sure that there are at least 64 bytes.
+
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    // x^(512 + 64), x^512, x^(128 + 64) and x^128 modulo the polynomial.
+
+    const __m128i k512 = _mm_set_epi32(0, int(0x8833794c), 0, int(0xe6228b11));
+    const __m128i k128 = _mm_set_epi32(0, int(0xc5b9cd4c), 0, int(0xe8a45605));
+
+#define LOAD_BLOCK(i) _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p) + (i)), reverse)
+
+    // The checksum so far is added to the first 4 bytes, just like the byte
+    // at a time loop does.
+
+    __m128i x0 = _mm_xor_si128(LOAD_BLOCK(0), _mm_set_epi32(int(crc), 0, 0, 0));
+    __m128i x1 = LOAD_BLOCK(1);
+    __m128i x2 = LOAD_BLOCK(2);
+    __m128i x3 = LOAD_BLOCK(3);
+
+    for(p += 64, length -= 64; length >= 64; p += 64, length -= 64) {
+      x0 = foldBlock(x0, k512, LOAD_BLOCK(0));
+      x1 = foldBlock(x1, k512, LOAD_BLOCK(1));
+      x2 = foldBlock(x2, k512, LOAD_BLOCK(2));
+      x3 = foldBlock(x3, k512, LOAD_BLOCK(3));
+    }
+
+    x0 = foldBlock(x0, k128, x1);
+    x0 = foldBlock(x0, k128, x2);
+    x0 = foldBlock(x0, k128, x3);
+
+    for(; length >= 16; p += 16, length -= 16)
+      x0 = foldBlock(x0, k128, LOAD_BLOCK(0));
+
+#undef LOAD_BLOCK
+
+    uchar folded[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(folded), _mm_shuffle_epi8(x0, reverse));
+
+    return checksumSliced(checksumSliced(0, folded, 16), p, length);
+  }
+
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+ByteVectorView::ByteVectorView()
+  : m_data(0)
+  , m_size(0)
+{
+}
+
+ByteVectorView::ByteVectorView(const ByteVector &v)
+  : m_data(v.data())
+  , m_size(v.size())
+{
+}
+
+ByteVectorView::ByteVectorView(const char *data, uint length)
+  : m_data(data)
+  , m_size(length)
+{
+}
+
+ByteVectorView::ByteVectorView(const char *data)
+  : m_data(data)
+  , m_size(::strlen(data))
+{
+}
+
+const char *ByteVectorView::data() const
+{
+  return m_data;
+}
+
+TagLib::uint ByteVectorView::size() const
+{
+  return m_size;
+}
+
+bool ByteVectorView::isEmpty() const
+{
+  return (m_size == 0);
+}
+
+ByteVectorView ByteVectorView::mid(uint index, uint length) const
+{
+  index  = std::min(index, m_size);
+  length = std::min(length, m_size - index);
+
+  return ByteVectorView(m_data + index, length);
+}
+
+char ByteVectorView::at(uint index) const
+{
+  return index < m_size ? m_data[index] : 0;
+}
+
+ByteVector ByteVectorView::toByteVector() const
+{
+  return ByteVector(m_data, m_size);
+}
+
+int ByteVectorView::find(const ByteVectorView &pattern, uint offset, int byteAlign) const
+{
+  if(byteAlign == 1) {
+    if(pattern.isEmpty() || pattern.size() > size() || offset > size() - pattern.size())
+      return -1;
+
+    return findForward(data(), offset, size() - pattern.size() + 1, pattern.data(), pattern.size());
+  }
+
+  return findVector<const char *>(
+    m_data, m_data + m_size, pattern.m_data, pattern.m_data + pattern.m_size, offset, byteAlign);
+}
+
+int ByteVectorView::find(char c, uint offset, int byteAlign) const
+{
+  if(byteAlign == 1) {
+    if(offset >= size())
+      return -1;
+
+    return findForward(data(), offset, size(), &c, 1);
+  }
+
+  return findChar<const char *>(m_data, m_data + m_size, c, offset, byteAlign);
+}
+
+int ByteVectorView::rfind(const ByteVectorView &pattern, uint offset, int byteAlign) const
+{
+  if(offset > 0) {
+    offset = size() - offset - pattern.size();
+    if(offset >= size())
+      offset = 0;
+  }
+
+  // Here offset is the number of positions at the end to skip.
+
+  if(byteAlign == 1) {
+    if(pattern.isEmpty() || pattern.size() > size() || offset > size() - pattern.size())
+      return -1;
+
+    return findBackward(data(), 0, size() - pattern.size() - offset + 1, pattern.data(), pattern.size());
+  }
+
+  typedef std::reverse_iterator<const char *> ReverseIterator;
+
+  const int pos = findVector<ReverseIterator>(
+    ReverseIterator(m_data + m_size), ReverseIterator(m_data),
+    ReverseIterator(pattern.m_data + pattern.m_size), ReverseIterator(pattern.m_data),
+    offset, byteAlign);
+
+  if(pos == -1)
+    return -1;
+  else
+    return size() - pos - pattern.size();
+}
+
+bool ByteVectorView::containsAt(const ByteVectorView &pattern, uint offset, uint patternOffset, uint patternLength) const
+{
+  if(pattern.size() < patternLength)
+    patternLength = pattern.size();
+
+  // do some sanity checking -- all of these things are needed for the search to be valid
+  const uint compareLength = patternLength - patternOffset;
+  if(offset + compareLength > size() || patternOffset >= pattern.size() || patternLength == 0)
+    return false;
+
+  return (::memcmp(data() + offset, pattern.data() + patternOffset, compareLength) == 0);
+}
+
+bool ByteVectorView::startsWith(const ByteVectorView &pattern) const
+{
+  return containsAt(pattern, 0);
+}
+
+bool ByteVectorView::endsWith(const ByteVectorView &pattern) const
+{
+  return containsAt(pattern, size() - pattern.size());
+}
+
+bool ByteVectorView::equalsIgnoreCase(const ByteVectorView &v) const
+{
+  if(m_size != v.m_size)
+    return false;
+
+  for(uint i = 0; i < m_size; ++i) {
+    char c1 = m_data[i];
+    char c2 = v.m_data[i];
+    if(c1 >= 'a' && c1 <= 'z')
+      c1 -= 'a' - 'A';
+    if(c2 >= 'a' && c2 <= 'z')
+      c2 -= 'a' - 'A';
+    if(c1 != c2)
+      return false;
+  }
+
+  return true;
+}
+
+TagLib::uint ByteVectorView::toUInt(bool mostSignificantByteFirst) const
+{
+  return toNumber<uint>(*this, 0, mostSignificantByteFirst);
+}
+
+TagLib::uint ByteVectorView::toUInt(uint offset, bool mostSignificantByteFirst) const
+{
+  return toNumber<uint>(*this, offset, mostSignificantByteFirst);
+}
+
+TagLib::uint ByteVectorView::toUInt(uint offset, uint length, bool mostSignificantByteFirst) const
+{
+  return toNumber<uint>(*this, offset, length, mostSignificantByteFirst);
+}
+
+short ByteVectorView::toShort(bool mostSignificantByteFirst) const
+{
+  return toNumber<unsigned short>(*this, 0, mostSignificantByteFirst);
+}
+
+short ByteVectorView::toShort(uint offset, bool mostSignificantByteFirst) const
+{
+  return toNumber<unsigned short>(*this, offset, mostSignificantByteFirst);
+}
+
+unsigned short ByteVectorView::toUShort(bool mostSignificantByteFirst) const
+{
+  return toNumber<unsigned short>(*this, 0, mostSignificantByteFirst);
+}
+
+unsigned short ByteVectorView::toUShort(uint offset, bool mostSignificantByteFirst) const
+{
+  return toNumber<unsigned short>(*this, offset, mostSignificantByteFirst);
+}
+
+long long ByteVectorView::toLongLong(bool mostSignificantByteFirst) const
+{
+  return toNumber<unsigned long long>(*this, 0, mostSignificantByteFirst);
+}
+
+long long ByteVectorView::toLongLong(uint offset, bool mostSignificantByteFirst) const
+{
+  return toNumber<unsigned long long>(*this, offset, mostSignificantByteFirst);
+}
+
+TagLib::uint ByteVectorView::checksum(uint crc) const
+{
+  const uchar *p = reinterpret_cast<const uchar *>(m_data);
+
+#if defined(TAGLIB_TARGET_PCLMUL)
+  if(m_size >= 64 && cpuSupportsPCLMUL())
+    return checksumPCLMUL(crc, p, m_size);
+#endif
+
+  return checksumSliced(crc, p, m_size);
+}
+
+const char &ByteVectorView::operator[](int index) const
+{
+  return m_data[index];
+}
+
+bool ByteVectorView::operator==(const ByteVectorView &v) const
+{
+  if(m_size != v.m_size)
+    return false;
+
+  return (m_size == 0 || ::memcmp(m_data, v.m_data, m_size) == 0);
+}
+
+bool ByteVectorView::operator!=(const ByteVectorView &v) const
+{
+  return !operator==(v);
+}
+
+bool ByteVectorView::operator==(const char *s) const
+{
+  return operator==(ByteVectorView(s));
+}
+
+bool ByteVectorView::operator!=(const char *s) const
+{
+  return !operator==(s);
+}
+
+} // namespace TagLib
@@ -0,0 +1,234 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+
+#ifndef TAGLIB_BYTEVECTORVIEW_H
+#define TAGLIB_BYTEVECTORVIEW_H
+
+#include "taglib.h"
+#include "taglib_export.h"
+
+namespace TagLib {
+
+  class ByteVector;
+
+  //! A read only view of a range of bytes
+
+  /*!
+   * This class refers to bytes that are owned by someone else, usually a
+   * ByteVector, and provides the read only part of the ByteVector API on
+   * them.  Taking a view or a part of a view copies nothing and does not
+   * touch any reference count, which makes it suitable for walking through
+   * a buffer while parsing it.
+   *
+   * A view does not keep its bytes alive.  It must not be used after the
+   * ByteVector that it was taken from has been modified or destroyed.
+   */
+
+  class TAGLIB_EXPORT ByteVectorView
+  {
+  public:
+    /*!
+     * Constructs an empty view.
+     */
+    ByteVectorView();
+
+    /*!
+     * Constructs a view of the data of \a v.
+     */
+    ByteVectorView(const ByteVector &v);
+
+    /*!
+     * Constructs a view of \a length bytes starting at \a data.
+     */
+    ByteVectorView(const char *data, uint length);
+
+    /*!
+     * Constructs a view of \a data up to the first null byte.  The behavior is
+     * undefined if \a data is not null terminated.
+     */
+    ByteVectorView(const char *data);
+
+    /*!
+     * Returns a pointer to the first byte of the view.
+     */
+    const char *data() const;
+
+    /*!
+     * Returns the size of the view.
+     */
+    uint size() const;
+
+    /*!
+     * Returns true if the view is empty.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * Returns a view of the \a length bytes starting at \a index.  If
+     * \a length is not specified it will return the bytes from \a index to
+     * the end of the view.  Both are clamped to the size of the view.
+     */
+    ByteVectorView mid(uint index, uint length = 0xffffffff) const;
+
+    /*!
+     * Returns the byte at \a index, or 0 if \a index is out of range.
+     */
+    char at(uint index) const;
+
+    /*!
+     * Returns a ByteVector holding a copy of the bytes of the view.
+     */
+    ByteVector toByteVector() const;
+
+    /*!
+     * Searches for \a pattern starting at \a offset and returns the offset of
+     * the first match, or -1 if it is not found.  See ByteVector::find().
+     */
+    int find(const ByteVectorView &pattern, uint offset = 0, int byteAlign = 1) const;
+
+    /*!
+     * Searches for \a c starting at \a offset and returns the offset of the
+     * first match, or -1 if it is not found.
+     */
+    int find(char c, uint offset = 0, int byteAlign = 1) const;
+
+    /*!
+     * Searches backwards for \a pattern.  See ByteVector::rfind().
+     */
+    int rfind(const ByteVectorView &pattern, uint offset = 0, int byteAlign = 1) const;
+
+    /*!
+     * Checks to see if the view contains \a pattern at position \a offset.
+     * See ByteVector::containsAt().
+     */
+    bool containsAt(const ByteVectorView &pattern, uint offset, uint patternOffset = 0, uint patternLength = 0xffffffff) const;
+
+    /*!
+     * Returns true if the view starts with \a pattern.
+     */
+    bool startsWith(const ByteVectorView &pattern) const;
+
+    /*!
+     * Returns true if the view ends with \a pattern.
+     */
+    bool endsWith(const ByteVectorView &pattern) const;
+
+    /*!
+     * Returns true if the view holds the same bytes as \a v, ignoring the
+     * case of ASCII letters.  This is meant for comparing the keys of tag
+     * items before they are decoded.
+     */
+    bool equalsIgnoreCase(const ByteVectorView &v) const;
+
+    /*!
+     * Converts the first 4 bytes of the view to an unsigned integer.  See
+     * ByteVector::toUInt().
+     */
+    uint toUInt(bool mostSignificantByteFirst = true) const;
+
+    /*!
+     * Converts the 4 bytes at \a offset to an unsigned integer.
+     */
+    uint toUInt(uint offset, bool mostSignificantByteFirst = true) const;
+
+    /*!
+     * Converts the \a length bytes at \a offset to an unsigned integer.
+     * \a length must not be greater than 4.
+     */
+    uint toUInt(uint offset, uint length, bool mostSignificantByteFirst = true) const;
+
+    /*!
+     * Converts the first 2 bytes of the view to a short.
+     */
+    short toShort(bool mostSignificantByteFirst = true) const;
+
+    /*!
+     * Converts the 2 bytes at \a offset to a short.
+     */
+    short toShort(uint offset, bool mostSignificantByteFirst = true) const;
+
+    /*!
+     * Converts the first 2 bytes of the view to an unsigned short.
+     */
+    unsigned short toUShort(bool mostSignificantByteFirst = true) const;
+
+    /*!
+     * Converts the 2 bytes at \a offset to an unsigned short.
+     */
+    unsigned short toUShort(uint offset, bool mostSignificantByteFirst = true) const;
+
+    /*!
+     * Converts the first 8 bytes of the view to a long long.
+     */
+    long long toLongLong(bool mostSignificantByteFirst = true) const;
+
+    /*!
+     * Converts the 8 bytes at \a offset to a long long.
+     */
+    long long toLongLong(uint offset, bool mostSignificantByteFirst = true) const;
+
+    /*!
+     * Returns the CRC checksum of the bytes, the one used by Ogg.  \a crc is
+     * the checksum of any data before them, which allows to compute the
+     * checksum of data that is split up into several views.
+     *
+     * \see ByteVector::checksum()
+     */
+    uint checksum(uint crc = 0) const;
+
+    /*!
+     * Returns the byte at \a index.  No bounds checking is done.
+     */
+    const char &operator[](int index) const;
+
+    /*!
+     * Returns true if the view holds the same bytes as \a v.
+     */
+    bool operator==(const ByteVectorView &v) const;
+
+    /*!
+     * Returns true if the view does not hold the same bytes as \a v.
+     */
+    bool operator!=(const ByteVectorView &v) const;
+
+    /*!
+     * Returns true if the view holds the same bytes as the null terminated
+     * string \a s.
+     */
+    bool operator==(const char *s) const;
+
+    /*!
+     * Returns true if the view does not hold the same bytes as the null
+     * terminated string \a s.
+     */
+    bool operator!=(const char *s) const;
+
+  private:
+    const char *m_data;
+    uint m_size;
+  };
+}
+
+#endif
@@ -0,0 +1,310 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include <list>
+
+#include "tcachediostream.h"
+#include "tstring.h"
+#include "tdebug.h"
+
+using namespace TagLib;
+
+class CachedIOStream::CachedIOStreamPrivate
+{
+public:
+  CachedIOStreamPrivate(IOStream *stream, uint blockSize, uint blockCount)
+    : stream(stream)
+    , blockSize(blockSize > 0 ? blockSize : 1)
+    , blockCount(blockCount > 0 ? blockCount : 1)
+    , cachedBlocks(0)
+    , position(0)
+    , length(-1)
+    , hits(0)
+    , misses(0)
+  {
+  }
+
+  struct Block
+  {
+    long offset;
+    ByteVector data;
+  };
+
+  // Returns the block starting at \a offset, reading it from the underlying
+  // stream if it's not cached.  The most recently used block is kept at the
+  // front of the list and the least recently used one is dropped first.
+
+  ByteVector block(long offset)
+  {
+    for(std::list<Block>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+      if(it->offset == offset) {
+        ++hits;
+        if(it != blocks.begin())
+          blocks.splice(blocks.begin(), blocks, it);
+        return blocks.front().data;
+      }
+    }
+
+    ++misses;
+
+    Block b;
+    b.offset = offset;
+    stream->seek(offset);
+    b.data = stream->readBlock(blockSize);
+
+    blocks.push_front(b);
+    if(++cachedBlocks > blockCount) {
+      blocks.pop_back();
+      --cachedBlocks;
+    }
+
+    return blocks.front().data;
+  }
+
+  void invalidate()
+  {
+    blocks.clear();
+    cachedBlocks = 0;
+    length = -1;
+  }
+
+  IOStream *stream;
+  const uint blockSize;
+  const uint blockCount;
+
+  std::list<Block> blocks;
+  uint cachedBlocks;
+
+  long position;
+  long length;
+
+  ulong hits;
+  ulong misses;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+CachedIOStream::CachedIOStream(IOStream *stream, uint blockSize, uint blockCount)
+  : d(new CachedIOStreamPrivate(stream, blockSize, blockCount))
+{
+  // Scans then read whole cached blocks.
+
+  setBufferSize(d->blockSize);
+
+  if(isOpen())
+    d->position = d->stream->tell();
+}
+
+CachedIOStream::~CachedIOStream()
+{
+  delete d;
+}
+
+FileName CachedIOStream::name() const
+{
+  if(!d->stream)
+    return FileName("");
+
+  return d->stream->name();
+}
+
+ByteVector CachedIOStream::readBlock(ulong length)
+{
+  if(!isOpen()) {
+    debug("CachedIOStream::readBlock() -- invalid stream.");
+    return ByteVector::null;
+  }
+
+  const long streamLength = CachedIOStream::length();
+  if(length == 0 || d->position >= streamLength)
+    return ByteVector::null;
+
+  if(length > static_cast<ulong>(streamLength - d->position))
+    length = streamLength - d->position;
+
+  // Reads that would not fit into the cache anyway bypass it.
+
+  if(length > static_cast<ulong>(d->blockSize) * d->blockCount) {
+    ++d->misses;
+    d->stream->seek(d->position);
+    const ByteVector data = d->stream->readBlock(length);
+    d->position += data.size();
+    return data;
+  }
+
+  ByteVector data;
+
+  while(length > 0) {
+    const long blockOffset = d->position - d->position % d->blockSize;
+    const ByteVector block = d->block(blockOffset);
+
+    const uint offset = static_cast<uint>(d->position - blockOffset);
+    if(offset >= block.size())
+      break;
+
+    const uint count = static_cast<uint>(std::min<ulong>(length, block.size() - offset));
+
+    // A read that is served by a single block shares its data.
+
+    if(data.isEmpty())
+      data = block.mid(offset, count);
+    else
+      data.append(block.mid(offset, count));
+
+    d->position += count;
+    length -= count;
+
+    if(block.size() < d->blockSize)
+      break;
+  }
+
+  return data;
+}
+
+void CachedIOStream::writeBlock(const ByteVector &data)
+{
+  if(!isOpen()) {
+    debug("CachedIOStream::writeBlock() -- invalid stream.");
+    return;
+  }
+
+  d->stream->seek(d->position);
+  d->stream->writeBlock(data);
+  d->position += data.size();
+  d->invalidate();
+}
+
+void CachedIOStream::insert(const ByteVector &data, ulong start, ulong replace)
+{
+  if(!isOpen()) {
+    debug("CachedIOStream::insert() -- invalid stream.");
+    return;
+  }
+
+  d->stream->insert(data, start, replace);
+  d->invalidate();
+}
+
+void CachedIOStream::removeBlock(ulong start, ulong length)
+{
+  if(!isOpen()) {
+    debug("CachedIOStream::removeBlock() -- invalid stream.");
+    return;
+  }
+
+  d->stream->removeBlock(start, length);
+  d->invalidate();
+}
+
+bool CachedIOStream::readOnly() const
+{
+  return !d->stream || d->stream->readOnly();
+}
+
+bool CachedIOStream::isOpen() const
+{
+  return d->stream && d->stream->isOpen();
+}
+
+void CachedIOStream::seek(long offset, Position p)
+{
+  long position;
+  switch(p) {
+  case Beginning:
+    position = offset;
+    break;
+  case Current:
+    position = d->position + offset;
+    break;
+  case End:
+    position = length() + offset;
+    break;
+  default:
+    debug("CachedIOStream::seek() -- Invalid Position value.");
+    return;
+  }
+
+  if(position >= 0)
+    d->position = position;
+}
+
+void CachedIOStream::clear()
+{
+  if(d->stream)
+    d->stream->clear();
+}
+
+long CachedIOStream::tell() const
+{
+  return d->position;
+}
+
+long CachedIOStream::length()
+{
+  if(!isOpen()) {
+    debug("CachedIOStream::length() -- invalid stream.");
+    return 0;
+  }
+
+  if(d->length < 0)
+    d->length = d->stream->length();
+
+  return d->length;
+}
+
+void CachedIOStream::truncate(long length)
+{
+  if(!isOpen()) {
+    debug("CachedIOStream::truncate() -- invalid stream.");
+    return;
+  }
+
+  d->stream->truncate(length);
+  d->invalidate();
+}
+
+void CachedIOStream::setAccessHints(int hints)
+{
+  IOStream::setAccessHints(hints);
+
+  if(d->stream)
+    d->stream->setAccessHints(hints);
+}
+
+void CachedIOStream::invalidate()
+{
+  d->invalidate();
+}
+
+TagLib::ulong CachedIOStream::hits() const
+{
+  return d->hits;
+}
+
+TagLib::ulong CachedIOStream::misses() const
+{
+  return d->misses;
+}
@@ -0,0 +1,161 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_CACHEDIOSTREAM_H
+#define TAGLIB_CACHEDIOSTREAM_H
+
+#include "taglib_export.h"
+#include "taglib.h"
+#include "tbytevector.h"
+#include "tiostream.h"
+
+namespace TagLib {
+
+  //! An IOStream decorator that caches reads in aligned blocks
+
+  /*!
+   * This wraps another IOStream and keeps the most recently used blocks of it
+   * in memory.  Each block starts at a multiple of the block size, so the
+   * small, overlapping reads done while scanning for tags and frame headers
+   * are served from a few large reads of the underlying stream.
+   *
+   * Writes are passed through to the underlying stream and drop all cached
+   * blocks.
+   *
+   * \note TagLib will *not* take ownership of \a stream, the caller is
+   * responsible for deleting it after the CachedIOStream object.
+   */
+
+  class TAGLIB_EXPORT CachedIOStream : public IOStream
+  {
+  public:
+    /*!
+     * Constructs a cache in front of \a stream that holds up to \a blockCount
+     * blocks of \a blockSize bytes each.
+     */
+    CachedIOStream(IOStream *stream, uint blockSize = 65536, uint blockCount = 4);
+
+    /*!
+     * Destroys this CachedIOStream instance.
+     */
+    virtual ~CachedIOStream();
+
+    /*!
+     * Returns the name of the underlying stream.
+     */
+    FileName name() const;
+
+    /*!
+     * Reads a block of size \a length at the current get pointer.
+     */
+    ByteVector readBlock(ulong length);
+
+    /*!
+     * Writes the block \a data at the current get pointer of the underlying
+     * stream.
+     */
+    void writeBlock(const ByteVector &data);
+
+    /*!
+     * Insert \a data at position \a start in the file overwriting \a replace
+     * bytes of the original content.
+     */
+    void insert(const ByteVector &data, ulong start = 0, ulong replace = 0);
+
+    /*!
+     * Removes a block of the file starting a \a start and continuing for
+     * \a length bytes.
+     */
+    void removeBlock(ulong start = 0, ulong length = 0);
+
+    /*!
+     * Returns true if the underlying stream is read only.
+     */
+    bool readOnly() const;
+
+    /*!
+     * Returns true if the underlying stream is open.
+     */
+    bool isOpen() const;
+
+    /*!
+     * Move the I/O pointer to \a offset in the stream from position \a p.  This
+     * defaults to seeking from the beginning of the stream.
+     *
+     * \see Position
+     */
+    void seek(long offset, Position p = Beginning);
+
+    /*!
+     * Reset the end-of-stream and error flags on the underlying stream.
+     */
+    void clear();
+
+    /*!
+     * Returns the current offset within the stream.
+     */
+    long tell() const;
+
+    /*!
+     * Returns the length of the stream.
+     */
+    long length();
+
+    /*!
+     * Truncates the stream to a \a length.
+     */
+    void truncate(long length);
+
+    /*!
+     * Passes the access hints \a hints on to the underlying stream.
+     *
+     * \see IOStream::setAccessHints()
+     */
+    void setAccessHints(int hints);
+
+    /*!
+     * Drops all cached blocks.  This must be called if the underlying stream
+     * is modified other than through this object.
+     */
+    void invalidate();
+
+    /*!
+     * Returns the number of block lookups that were served from the cache.
+     */
+    ulong hits() const;
+
+    /*!
+     * Returns the number of block lookups that required a read of the
+     * underlying stream.
+     */
+    ulong misses() const;
+
+  private:
+    class CachedIOStreamPrivate;
+    CachedIOStreamPrivate *d;
+  };
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+
+#include "tdeferreddata.h"
+#include "tfile.h"
+#include "tdebug.h"
+
+using namespace TagLib;
+
+DeferredData::DeferredData() :
+  file(0),
+  offset(0),
+  length(0)
+{
+}
+
+DeferredData::~DeferredData()
+{
+  if(file)
+    file->removeDeferredData(this);
+}
+
+ByteVector DeferredData::data() const
+{
+  load();
+  return bytes;
+}
+
+void DeferredData::setData(const ByteVector &data)
+{
+  if(file) {
+    file->removeDeferredData(this);
+    file = 0;
+  }
+
+  bytes = data;
+}
+
+void DeferredData::defer(File *file, long offset, uint length)
+{
+  setData(ByteVector::null);
+
+  if(!file || length == 0)
+    return;
+
+  this->file = file;
+  this->offset = offset;
+  this->length = length;
+
+  file->addDeferredData(this);
+}
+
+uint DeferredData::size() const
+{
+  return file ? length : bytes.size();
+}
+
+bool DeferredData::isDeferred() const
+{
+  return (file != 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// private members
+////////////////////////////////////////////////////////////////////////////////
+
+void DeferredData::load() const
+{
+  if(!file)
+    return;
+
+  File *f = file;
+  file = 0;
+  f->removeDeferredData(const_cast<DeferredData *>(this));
+
+  const long position = f->tell();
+  f->seek(offset);
+  bytes = f->readBlock(length);
+  f->seek(position);
+
+  if(bytes.size() != length)
+    debug("DeferredData::load() -- The data could not be read completely.");
+}
+
+void DeferredData::detach()
+{
+  file = 0;
+  length = 0;
+}
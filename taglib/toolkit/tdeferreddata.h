@@ -0,0 +1,94 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+
+#ifndef TAGLIB_DEFERREDDATA_H
+#define TAGLIB_DEFERREDDATA_H
+
+// THIS FILE IS NOT A PART OF THE TAGLIB API
+
+#ifndef DO_NOT_DOCUMENT  // tell Doxygen not to document this header
+
+#include "tbytevector.h"
+
+namespace TagLib
+{
+  class File;
+
+  /*
+   * Binary data, such as a picture, which may be left in the file until it
+   * is used.  Deferred data is read by the first call to data(), or by the
+   * file before it is modified, so its offset never becomes stale.  It is
+   * lost if the file is closed before that.
+   */
+  class DeferredData
+  {
+  public:
+    DeferredData();
+    ~DeferredData();
+
+    /*
+     * Returns the data, reading it from the file if it is deferred.
+     */
+    ByteVector data() const;
+
+    /*
+     * Replaces the data.  It is no longer read from the file.
+     */
+    void setData(const ByteVector &data);
+
+    /*
+     * Makes the data the \a length bytes at \a offset in \a file, which are
+     * read when they are used.
+     */
+    void defer(File *file, long offset, uint length);
+
+    /*
+     * Returns the size of the data without reading it.
+     */
+    uint size() const;
+
+    /*
+     * Returns true if the data has not been read from the file yet.
+     */
+    bool isDeferred() const;
+
+  private:
+    friend class File;
+
+    DeferredData(const DeferredData &);
+    DeferredData &operator=(const DeferredData &);
+
+    void load() const;
+    void detach();
+
+    mutable File *file;
+    long offset;
+    uint length;
+    mutable ByteVector bytes;
+  };
+}
+
+#endif
+#endif
@@ -28,6 +28,10 @@
 #include "tstring.h"
 #include "tdebug.h"
 #include "tpropertymap.h"
+#include "tdeferreddata.h"
+
+#include <algorithm>
+#include <vector>
 
 #ifdef _WIN32
 # include <windows.h>
@@ -44,51 +48,73 @@
 # define W_OK 2
 #endif
 
-#include "asffile.h"
-#include "mpegfile.h"
-#include "vorbisfile.h"
-#include "flacfile.h"
-#include "oggflacfile.h"
-#include "mpcfile.h"
-#include "mp4file.h"
-#include "wavpackfile.h"
-#include "speexfile.h"
-#include "opusfile.h"
-#include "trueaudiofile.h"
-#include "aifffile.h"
-#include "wavfile.h"
-#include "apefile.h"
-#include "modfile.h"
-#include "s3mfile.h"
-#include "itfile.h"
-#include "xmfile.h"
-#include "mp4file.h"
-
 using namespace TagLib;
 
 namespace
 {
-#ifdef _WIN32
-  const TagLib::uint BufferSize = 8192;
-#else
   const TagLib::uint BufferSize = 1024;
-#endif
+
+  const TagLib::uint DefaultSearchWindowSize = 256 * 1024;
+
+  // The size of the blocks in which commitEdits() moves data.
+
+  const TagLib::uint MoveBufferSize = 64 * 1024;
+
+  struct Edit
+  {
+    Edit(const ByteVector &data, ulong start, ulong replace) :
+      data(data), start(start), replace(replace) {}
+
+    ByteVector data;
+    ulong start;
+    ulong replace;
+  };
+
+  // Pure insertions go before a replaced range starting at the same offset.
+
+  bool editBefore(const Edit &a, const Edit &b)
+  {
+    if(a.start != b.start)
+      return a.start < b.start;
+    else
+      return (a.replace == 0 && b.replace != 0);
+  }
+
+  // A part of the file between two edits, which is moved by shift bytes.
+
+  struct Segment
+  {
+    Segment(long offset, long length, long shift) :
+      offset(offset), length(length), shift(shift) {}
+
+    long offset;
+    long length;
+    long shift;
+  };
 }
 
 class File::FilePrivate
 {
 public:
-  FilePrivate(IOStream *stream, bool owner);
+  FilePrivate(IOStream *stream, bool owner, int readOptions);
 
   IOStream *stream;
   bool streamOwner;
+  int readOptions;
   bool valid;
+  uint searchWindowSize;
+  SaveStrategy saveStrategy;
+  std::vector<Edit> edits;
+  std::vector<DeferredData *> deferredData;
 };
 
-File::FilePrivate::FilePrivate(IOStream *stream, bool owner) :
+File::FilePrivate::FilePrivate(IOStream *stream, bool owner, int readOptions) :
   stream(stream),
   streamOwner(owner),
-  valid(true)
+  readOptions(readOptions),
+  valid(true),
+  searchWindowSize(DefaultSearchWindowSize),
+  saveStrategy(InPlace)
 {
 }
 
@@ -96,19 +122,15 @@ File::FilePrivate::FilePrivate(IOStream *stream, bool owner) :
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-File::File(FileName fileName)
-{
-  IOStream *stream = new FileStream(fileName);
-  d = new FilePrivate(stream, true);
-}
-
-File::File(IOStream *stream)
-{
-  d = new FilePrivate(stream, false);
-}
 
 File::~File()
 {
+  for(std::vector<DeferredData *>::iterator it = d->deferredData.begin();
+      it != d->deferredData.end(); ++it)
+  {
+    (*it)->detach();
+  }
+
   if(d->stream && d->streamOwner)
     delete d->stream;
   delete d;
@@ -121,116 +143,17 @@ FileName File::name() const
 
 PropertyMap File::properties() const
 {
-  // ugly workaround until this method is virtual
-  if(dynamic_cast<const APE::File* >(this))
-    return dynamic_cast<const APE::File* >(this)->properties();
-  if(dynamic_cast<const FLAC::File* >(this))
-    return dynamic_cast<const FLAC::File* >(this)->properties();
-  if(dynamic_cast<const IT::File* >(this))
-    return dynamic_cast<const IT::File* >(this)->properties();
-  if(dynamic_cast<const Mod::File* >(this))
-    return dynamic_cast<const Mod::File* >(this)->properties();
-  if(dynamic_cast<const MPC::File* >(this))
-    return dynamic_cast<const MPC::File* >(this)->properties();
-  if(dynamic_cast<const MPEG::File* >(this))
-    return dynamic_cast<const MPEG::File* >(this)->properties();
-  if(dynamic_cast<const Ogg::FLAC::File* >(this))
-    return dynamic_cast<const Ogg::FLAC::File* >(this)->properties();
-  if(dynamic_cast<const Ogg::Speex::File* >(this))
-    return dynamic_cast<const Ogg::Speex::File* >(this)->properties();
-  if(dynamic_cast<const Ogg::Opus::File* >(this))
-    return dynamic_cast<const Ogg::Opus::File* >(this)->properties();
-  if(dynamic_cast<const Ogg::Vorbis::File* >(this))
-    return dynamic_cast<const Ogg::Vorbis::File* >(this)->properties();
-  if(dynamic_cast<const RIFF::AIFF::File* >(this))
-    return dynamic_cast<const RIFF::AIFF::File* >(this)->properties();
-  if(dynamic_cast<const RIFF::WAV::File* >(this))
-    return dynamic_cast<const RIFF::WAV::File* >(this)->properties();
-  if(dynamic_cast<const S3M::File* >(this))
-    return dynamic_cast<const S3M::File* >(this)->properties();
-  if(dynamic_cast<const TrueAudio::File* >(this))
-    return dynamic_cast<const TrueAudio::File* >(this)->properties();
-  if(dynamic_cast<const WavPack::File* >(this))
-    return dynamic_cast<const WavPack::File* >(this)->properties();
-  if(dynamic_cast<const XM::File* >(this))
-    return dynamic_cast<const XM::File* >(this)->properties();
-  if(dynamic_cast<const MP4::File* >(this))
-    return dynamic_cast<const MP4::File* >(this)->properties();
-  if(dynamic_cast<const ASF::File* >(this))
-    return dynamic_cast<const ASF::File* >(this)->properties();
   return tag()->properties();
 }
 
 void File::removeUnsupportedProperties(const StringList &properties)
 {
-  // here we only consider those formats that could possibly contain
-  // unsupported properties
-  if(dynamic_cast<APE::File* >(this))
-    dynamic_cast<APE::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<FLAC::File* >(this))
-    dynamic_cast<FLAC::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<MPC::File* >(this))
-    dynamic_cast<MPC::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<MPEG::File* >(this))
-    dynamic_cast<MPEG::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<Ogg::Vorbis::File* >(this))
-    dynamic_cast<Ogg::Vorbis::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<RIFF::AIFF::File* >(this))
-    dynamic_cast<RIFF::AIFF::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<RIFF::WAV::File* >(this))
-    dynamic_cast<RIFF::WAV::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<TrueAudio::File* >(this))
-    dynamic_cast<TrueAudio::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<WavPack::File* >(this))
-    dynamic_cast<WavPack::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<MP4::File* >(this))
-    dynamic_cast<MP4::File* >(this)->removeUnsupportedProperties(properties);
-  else if(dynamic_cast<ASF::File* >(this))
-    dynamic_cast<ASF::File* >(this)->removeUnsupportedProperties(properties);
-  else
-    tag()->removeUnsupportedProperties(properties);
+  tag()->removeUnsupportedProperties(properties);
 }
 
 PropertyMap File::setProperties(const PropertyMap &properties)
 {
-  if(dynamic_cast<APE::File* >(this))
-    return dynamic_cast<APE::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<FLAC::File* >(this))
-    return dynamic_cast<FLAC::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<IT::File* >(this))
-    return dynamic_cast<IT::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Mod::File* >(this))
-    return dynamic_cast<Mod::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<MPC::File* >(this))
-    return dynamic_cast<MPC::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<MPEG::File* >(this))
-    return dynamic_cast<MPEG::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Ogg::FLAC::File* >(this))
-    return dynamic_cast<Ogg::FLAC::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Ogg::Speex::File* >(this))
-    return dynamic_cast<Ogg::Speex::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Ogg::Opus::File* >(this))
-    return dynamic_cast<Ogg::Opus::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<Ogg::Vorbis::File* >(this))
-    return dynamic_cast<Ogg::Vorbis::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<RIFF::AIFF::File* >(this))
-    return dynamic_cast<RIFF::AIFF::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<RIFF::WAV::File* >(this))
-    return dynamic_cast<RIFF::WAV::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<S3M::File* >(this))
-    return dynamic_cast<S3M::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<TrueAudio::File* >(this))
-    return dynamic_cast<TrueAudio::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<WavPack::File* >(this))
-    return dynamic_cast<WavPack::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<XM::File* >(this))
-    return dynamic_cast<XM::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<MP4::File* >(this))
-    return dynamic_cast<MP4::File* >(this)->setProperties(properties);
-  else if(dynamic_cast<ASF::File* >(this))
-    return dynamic_cast<ASF::File* >(this)->setProperties(properties);
-  else
-    return tag()->setProperties(properties);
+  return tag()->setProperties(properties);
 }
 
 ByteVector File::readBlock(ulong length)
@@ -240,180 +163,172 @@ ByteVector File::readBlock(ulong length)
 
 void File::writeBlock(const ByteVector &data)
 {
+  loadDeferredData();
   d->stream->writeBlock(data);
 }
 
 long File::find(const ByteVector &pattern, long fromOffset, const ByteVector &before)
 {
-  if(!d->stream || pattern.size() > bufferSize())
-      return -1;
+  return find(pattern, fromOffset, before, -1);
+}
 
-  // The position in the file that the current buffer starts at.
+long File::find(const ByteVector &pattern, long fromOffset, const ByteVector &before, long limit)
+{
+  if(!d->stream || pattern.isEmpty() || fromOffset < 0)
+    return -1;
 
-  long bufferOffset = fromOffset;
-  ByteVector buffer;
+  // Save the location of the current read pointer.  We will restore the
+  // position using seek() before returning.
 
-  // These variables are used to keep track of a partial match that happens at
-  // the end of a buffer.
+  const long originalPosition = tell();
 
-  int previousPartialMatch = -1;
-  int beforePreviousPartialMatch = -1;
+  long end = length();
+  if(limit >= 0 && limit < end)
+    end = limit;
 
-  // Save the location of the current read pointer.  We will restore the
-  // position using seek() before all returns.
-
-  long originalPosition = tell();
-
-  // Start the search at the offset.
-
-  seek(fromOffset);
-
-  // This loop is the crux of the find method.  There are three cases that we
-  // want to account for:
-  //
-  // (1) The previously searched buffer contained a partial match of the search
-  // pattern and we want to see if the next one starts with the remainder of
-  // that pattern.
-  //
-  // (2) The search pattern is wholly contained within the current buffer.
-  //
-  // (3) The current buffer ends with a partial match of the pattern.  We will
-  // note this for use in the next itteration, where we will check for the rest
-  // of the pattern.
-  //
-  // All three of these are done in two steps.  First we check for the pattern
-  // and do things appropriately if a match (or partial match) is found.  We
-  // then check for "before".  The order is important because it gives priority
-  // to "real" matches.
-
-  for(buffer = readBlock(bufferSize()); buffer.size() > 0; buffer = readBlock(bufferSize())) {
-
-    // (1) previous partial match
-
-    if(previousPartialMatch >= 0 && int(bufferSize()) > previousPartialMatch) {
-      const int patternOffset = (bufferSize() - previousPartialMatch);
-      if(buffer.containsAt(pattern, 0, patternOffset)) {
-        seek(originalPosition);
-        return bufferOffset - bufferSize() + previousPartialMatch;
-      }
-    }
+  // Consecutive windows overlap by this many bytes, so that a match across
+  // the boundary of two windows is entirely contained in the second one.
 
-    if(!before.isNull() && beforePreviousPartialMatch >= 0 && int(bufferSize()) > beforePreviousPartialMatch) {
-      const int beforeOffset = (bufferSize() - beforePreviousPartialMatch);
-      if(buffer.containsAt(before, 0, beforeOffset)) {
-        seek(originalPosition);
-        return -1;
-      }
-    }
+  const uint overlap = std::max(pattern.size(), before.size()) - 1;
 
-    // (2) pattern contained in current buffer
+  // The windows start small, since most searches end close to where they
+  // begin, and grow up to searchWindowSize() for long scans.
 
-    long location = buffer.find(pattern);
-    if(location >= 0) {
-      seek(originalPosition);
-      return bufferOffset + location;
-    }
+  uint windowSize = streamBufferSize() + overlap;
+  long windowOffset = fromOffset;
+  long result = -1;
 
-    if(!before.isNull() && buffer.find(before) >= 0) {
-      seek(originalPosition);
-      return -1;
-    }
+  while(end - windowOffset >= long(pattern.size())) {
 
-    // (3) partial match
+    seek(windowOffset);
+    const ByteVector window = readBlock(std::min<long>(windowSize, end - windowOffset));
+    if(window.size() < pattern.size())
+      break;
 
-    previousPartialMatch = buffer.endsWithPartialMatch(pattern);
+    // A match of "before" only stops the search if it comes first.
 
-    if(!before.isNull())
-      beforePreviousPartialMatch = buffer.endsWithPartialMatch(before);
+    const int location = window.find(pattern);
 
-    bufferOffset += bufferSize();
-  }
+    if(!before.isEmpty()) {
+      const int beforeLocation = window.find(before);
+      if(beforeLocation >= 0 && (location < 0 || beforeLocation < location))
+        break;
+    }
 
-  // Since we hit the end of the file, reset the status before continuing.
+    if(location >= 0) {
+      result = windowOffset + location;
+      break;
+    }
 
-  clear();
+    if(windowOffset + long(window.size()) >= end)
+      break;
 
+    windowOffset += window.size() - overlap;
+    windowSize = std::max(std::min(windowSize * 2, searchWindowSize()), windowSize);
+  }
+
+  clear();
   seek(originalPosition);
 
-  return -1;
+  return result;
 }
 
-
 long File::rfind(const ByteVector &pattern, long fromOffset, const ByteVector &before)
 {
-  if(!d->stream || pattern.size() > bufferSize())
-      return -1;
+  return rfind(pattern, fromOffset, before, 0);
+}
 
-  // The position in the file that the current buffer starts at.
+long File::rfind(const ByteVector &pattern, long fromOffset, const ByteVector &before, long limit)
+{
+  if(!d->stream || pattern.isEmpty() || fromOffset < 0)
+    return -1;
 
-  ByteVector buffer;
+  // Save the location of the current read pointer.  We will restore the
+  // position using seek() before returning.
 
-  // These variables are used to keep track of a partial match that happens at
-  // the end of a buffer.
+  const long originalPosition = tell();
 
-  /*
-  int previousPartialMatch = -1;
-  int beforePreviousPartialMatch = -1;
-  */
+  long end = length();
+  if(fromOffset > 0 && fromOffset < end)
+    end = fromOffset;
 
-  // Save the location of the current read pointer.  We will restore the
-  // position using seek() before all returns.
+  const long begin = std::max<long>(limit, 0);
 
-  long originalPosition = tell();
+  // See the notes in find() for an explanation of the window sizes.
 
-  // Start the search at the offset.
+  const uint overlap = std::max(pattern.size(), before.size()) - 1;
 
-  long bufferOffset;
-  if(fromOffset == 0) {
-    seek(-1 * int(bufferSize()), End);
-    bufferOffset = tell();
-  }
-  else {
-    seek(fromOffset + -1 * int(bufferSize()), Beginning);
-    bufferOffset = tell();
-  }
+  uint windowSize = streamBufferSize() + overlap;
+  long result = -1;
 
-  // See the notes in find() for an explanation of this algorithm.
+  while(end - begin >= long(pattern.size())) {
 
-  for(buffer = readBlock(bufferSize()); buffer.size() > 0; buffer = readBlock(bufferSize())) {
+    const long windowOffset = std::max(begin, end - long(windowSize));
 
-    // TODO: (1) previous partial match
+    seek(windowOffset);
+    const ByteVector window = readBlock(end - windowOffset);
+    if(window.size() < pattern.size())
+      break;
 
-    // (2) pattern contained in current buffer
+    const int location = window.rfind(pattern);
 
-    long location = buffer.rfind(pattern);
-    if(location >= 0) {
-      seek(originalPosition);
-      return bufferOffset + location;
+    if(!before.isEmpty()) {
+      const int beforeLocation = window.rfind(before);
+      if(beforeLocation >= 0 && (location < 0 || beforeLocation > location))
+        break;
     }
 
-    if(!before.isNull() && buffer.find(before) >= 0) {
-      seek(originalPosition);
-      return -1;
+    if(location >= 0) {
+      result = windowOffset + location;
+      break;
     }
 
-    // TODO: (3) partial match
+    if(windowOffset == begin)
+      break;
 
-    bufferOffset -= bufferSize();
-    seek(bufferOffset);
+    end = windowOffset + overlap;
+    windowSize = std::max(std::min(windowSize * 2, searchWindowSize()), windowSize);
   }
 
-  // Since we hit the end of the file, reset the status before continuing.
-
   clear();
-
   seek(originalPosition);
 
-  return -1;
+  return result;
+}
+
+void File::setSaveStrategy(SaveStrategy strategy)
+{
+  d->saveStrategy = strategy;
+}
+
+File::SaveStrategy File::saveStrategy() const
+{
+  return d->saveStrategy;
 }
 
 void File::insert(const ByteVector &data, ulong start, ulong replace)
 {
+  loadDeferredData();
+
+  if(d->saveStrategy == ReplaceFile) {
+    FileStream *stream = dynamic_cast<FileStream *>(d->stream);
+    if(stream && stream->rewrite(data, start, replace))
+      return;
+  }
+
   d->stream->insert(data, start, replace);
 }
 
 void File::removeBlock(ulong start, ulong length)
 {
+  loadDeferredData();
+
+  if(d->saveStrategy == ReplaceFile) {
+    FileStream *stream = dynamic_cast<FileStream *>(d->stream);
+    if(stream && stream->rewrite(ByteVector::null, start, length))
+      return;
+  }
+
   d->stream->removeBlock(start, length);
 }
 
@@ -439,6 +354,7 @@ void File::seek(long offset, Position p)
 
 void File::truncate(long length)
 {
+  loadDeferredData();
   d->stream->truncate(length);
 }
 
@@ -491,13 +407,239 @@ bool File::isWritable(const char *file)
 // protected members
 ////////////////////////////////////////////////////////////////////////////////
 
+File::File(FileName fileName)
+{
+  IOStream *stream = new FileStream(fileName);
+  d = new FilePrivate(stream, true, ReadAll);
+}
+
+File::File(IOStream *stream)
+{
+  d = new FilePrivate(stream, false, ReadAll);
+}
+
+File::File(FileName fileName, int readOptions)
+{
+  IOStream *stream = new FileStream(fileName);
+  d = new FilePrivate(stream, true, readOptions);
+}
+
+File::File(IOStream *stream, int readOptions)
+{
+  d = new FilePrivate(stream, false, readOptions);
+}
+
+int File::readOptions() const
+{
+  return d->readOptions;
+}
+
+void File::setSearchWindowSize(uint size)
+{
+  d->searchWindowSize = size;
+}
+
+TagLib::uint File::searchWindowSize() const
+{
+  return d->searchWindowSize;
+}
+
 TagLib::uint File::bufferSize()
 {
   return BufferSize;
 }
 
+TagLib::uint File::streamBufferSize() const
+{
+  return d->stream->bufferSize();
+}
+
 void File::setValid(bool valid)
 {
   d->valid = valid;
 }
 
+bool File::readInPart() const
+{
+  return (d->readOptions & ReadBasicFields) != 0;
+}
+
+void File::queueInsert(const ByteVector &data, ulong start, ulong replace)
+{
+  d->edits.push_back(Edit(data, start, replace));
+}
+
+void File::queueRemoveBlock(ulong start, ulong length)
+{
+  d->edits.push_back(Edit(ByteVector::null, start, length));
+}
+
+void File::commitEdits()
+{
+  std::vector<Edit> edits;
+  edits.swap(d->edits);
+
+  if(edits.empty())
+    return;
+
+  std::stable_sort(edits.begin(), edits.end(), editBefore);
+
+  const long fileLength = length();
+
+  for(std::vector<Edit>::iterator it = edits.begin(); it != edits.end(); ++it) {
+    it->start   = std::min<ulong>(it->start, fileLength);
+    it->replace = std::min<ulong>(it->replace, fileLength - it->start);
+  }
+
+  for(size_t i = 1; i < edits.size(); ++i) {
+    if(edits[i].start < edits[i - 1].start + edits[i - 1].replace) {
+      debug("File::commitEdits() -- Dropping an edit which overlaps another one.");
+      edits.erase(edits.begin() + i--);
+    }
+  }
+
+  // With the ReplaceFile strategy all edits go into a single new file, so
+  // that a crash leaves either the old or the new file.
+
+  std::vector<Edit> resizing;
+  for(std::vector<Edit>::const_iterator it = edits.begin(); it != edits.end(); ++it) {
+    if(it->data.size() != it->replace)
+      resizing.push_back(*it);
+  }
+
+  if(!resizing.empty() && d->saveStrategy == ReplaceFile) {
+    FileStream *stream = dynamic_cast<FileStream *>(d->stream);
+    if(stream) {
+      List<FileStream::Change> changes;
+      for(std::vector<Edit>::const_iterator it = edits.begin(); it != edits.end(); ++it)
+        changes.append(FileStream::Change(it->data, it->start, it->replace));
+
+      loadDeferredData();
+      if(stream->rewrite(changes))
+        return;
+    }
+  }
+
+  // Edits which keep their size are simply overwritten.  They are done first,
+  // so that their offsets are still those of the original file.
+
+  if(resizing.size() < 2) {
+    for(std::vector<Edit>::const_iterator it = edits.begin(); it != edits.end(); ++it) {
+      if(it->data.size() == it->replace) {
+        seek(it->start);
+        writeBlock(it->data);
+      }
+    }
+
+    // A single edit which changes the size may be done faster by the stream.
+
+    if(resizing.size() == 1) {
+      if(resizing[0].data.isEmpty())
+        removeBlock(resizing[0].start, resizing[0].replace);
+      else
+        insert(resizing[0].data, resizing[0].start, resizing[0].replace);
+    }
+
+    return;
+  }
+
+  // Split the rest of the file into the segments between the edits.
+
+  std::vector<Segment> segments;
+  std::vector<long> newStarts;
+
+  long offset = 0;
+  long shift = 0;
+
+  for(std::vector<Edit>::const_iterator it = edits.begin(); it != edits.end(); ++it) {
+    segments.push_back(Segment(offset, it->start - offset, shift));
+    newStarts.push_back(it->start + shift);
+    shift += static_cast<long>(it->data.size()) - static_cast<long>(it->replace);
+    offset = it->start + it->replace;
+  }
+
+  segments.push_back(Segment(offset, fileLength - offset, shift));
+
+  // A segment that moves backwards can only overwrite parts of the segments
+  // in front of it that have already been moved, and one that moves forwards
+  // only parts of the ones behind it.  So move the former front to back, and
+  // then the latter back to front.  Every byte is moved at most once.
+
+  std::vector<Segment> forward;
+
+  for(std::vector<Segment>::const_iterator it = segments.begin(); it != segments.end(); ++it) {
+    if(it->shift < 0)
+      moveBlock(it->offset, it->offset + it->shift, it->length);
+    else if(it->shift > 0)
+      forward.push_back(*it);
+  }
+
+  for(std::vector<Segment>::reverse_iterator it = forward.rbegin(); it != forward.rend(); ++it)
+    moveBlock(it->offset, it->offset + it->shift, it->length);
+
+  for(size_t i = 0; i < edits.size(); ++i) {
+    if(!edits[i].data.isEmpty()) {
+      seek(newStarts[i]);
+      writeBlock(edits[i].data);
+    }
+  }
+
+  if(shift < 0)
+    truncate(fileLength + shift);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// private members
+////////////////////////////////////////////////////////////////////////////////
+
+void File::moveBlock(long from, long to, long length)
+{
+  ByteVector buffer;
+
+  if(to < from) {
+    for(long offset = 0; offset < length; offset += buffer.size()) {
+      seek(from + offset);
+      buffer = readBlock(std::min<long>(MoveBufferSize, length - offset));
+      if(buffer.isEmpty())
+        break;
+      seek(to + offset);
+      writeBlock(buffer);
+    }
+  }
+  else if(to > from) {
+    for(long end = length; end > 0; end -= buffer.size()) {
+      const long offset = std::max<long>(0, end - MoveBufferSize);
+      seek(from + offset);
+      buffer = readBlock(end - offset);
+      if(buffer.isEmpty())
+        break;
+      seek(to + offset);
+      writeBlock(buffer);
+    }
+  }
+}
+
+void File::addDeferredData(DeferredData *data)
+{
+  d->deferredData.push_back(data);
+}
+
+void File::removeDeferredData(DeferredData *data)
+{
+  std::vector<DeferredData *>::iterator it
+    = std::find(d->deferredData.begin(), d->deferredData.end(), data);
+
+  if(it != d->deferredData.end())
+    d->deferredData.erase(it);
+}
+
+void File::loadDeferredData()
+{
+  // Loading removes the data from the list, so take it over first.
+
+  std::vector<DeferredData *> data;
+  data.swap(d->deferredData);
+
+  for(std::vector<DeferredData *>::const_iterator it = data.begin(); it != data.end(); ++it)
+    (*it)->load();
+}
@@ -38,6 +38,7 @@ namespace TagLib {
   class Tag;
   class AudioProperties;
   class PropertyMap;
+  class DeferredData;
 
   //! A file class with some useful methods for tag manipulation
 
@@ -62,6 +63,54 @@ namespace TagLib {
       End
     };
 
+    /*!
+     * How insert() and removeBlock() change the file when it is saved.
+     */
+    enum SaveStrategy {
+      //! Shift the rest of the file in place.
+      InPlace,
+      //! Write a new file and rename it over the original one.
+      ReplaceFile
+    };
+
+    /*!
+     * Options for reading a file, which are combined and passed to the
+     * constructors of the subclasses.  Subclasses ignore the options they do
+     * not support.
+     *
+     * If any of ReadTitle to ReadTrack is given, only the parts of the tags
+     * which carry one of the given fields are read, such as ID3v2 frames, MP4
+     * atoms, Vorbis comment fields and APE items.  The others are skipped
+     * without being decoded.  A file read this way cannot be saved.
+     */
+    enum ReadOption {
+      //! Read everything when the file is opened.
+      ReadAll = 0x0000,
+      /*!
+       * Read large binary data, such as pictures, only when it is used.  It
+       * is read before the file is modified, but is lost if the file is
+       * destroyed first.  Together with not reading the audio properties this
+       * reads only the tags.
+       */
+      DeferBinaryData = 0x0001,
+      //! Read the title of the tags.
+      ReadTitle = 0x0100,
+      //! Read the artist of the tags.
+      ReadArtist = 0x0200,
+      //! Read the album of the tags.
+      ReadAlbum = 0x0400,
+      //! Read the comment of the tags.
+      ReadComment = 0x0800,
+      //! Read the genre of the tags.
+      ReadGenre = 0x1000,
+      //! Read the year of the tags.
+      ReadYear = 0x2000,
+      //! Read the track number of the tags.
+      ReadTrack = 0x4000,
+      //! Read all of the above fields, but nothing else of the tags.
+      ReadBasicFields = 0x7f00
+    };
+
     /*!
      * Destroys this File instance.
      */
@@ -88,17 +137,17 @@ namespace TagLib {
      * to remove (a subset of) them.
      * For files that contain more than one tag (e.g. an MP3 with both an ID3v2 and an ID3v2
      * tag) only the most "modern" one will be exported (ID3v2 in this case).
-     * BIC: Will be made virtual in future releases.
+     * The default implementation returns the properties of tag().
      */
-    PropertyMap properties() const;
+    virtual PropertyMap properties() const;
 
     /*!
      * Removes unsupported properties, or a subset of them, from the file's metadata.
      * The parameter \a properties must contain only entries from
      * properties().unsupportedData().
-     * BIC: Will be mad virtual in future releases.
+     * The default implementation forwards to tag().
      */
-    void removeUnsupportedProperties(const StringList& properties);
+    virtual void removeUnsupportedProperties(const StringList& properties);
 
     /*!
      * Sets the tags of this File to those specified in \a properties. Calls the
@@ -112,9 +161,9 @@ namespace TagLib {
      * (ID3v2 for MP3 files). Older formats will be updated as well, if they exist, but won't
      * be taken into account for the return value of this function.
      * See the documentation of the subclass implementations for detailed descriptions.
-     * BIC: will become pure virtual in the future
+     * The default implementation forwards to tag().
      */
-    PropertyMap setProperties(const PropertyMap &properties);
+    virtual PropertyMap setProperties(const PropertyMap &properties);
     
     /*!
      * Returns a pointer to this file's audio properties.  This should be
@@ -160,13 +209,22 @@ namespace TagLib {
      * Searching starts at \a fromOffset, which defaults to the beginning of the
      * file.
      *
-     * \note This has the practial limitation that \a pattern can not be longer
-     * than the buffer size used by readBlock().  Currently this is 1024 bytes.
+     * \see searchWindowSize()
      */
     long find(const ByteVector &pattern,
               long fromOffset = 0,
               const ByteVector &before = ByteVector::null);
 
+    /*!
+     * This is the same as the above, but only searches up to the offset
+     * \a limit; \a pattern has to end at or before it.  A negative \a limit
+     * searches up to the end of the file.
+     */
+    long find(const ByteVector &pattern,
+              long fromOffset,
+              const ByteVector &before,
+              long limit);
+
     /*!
      * Returns the offset in the file that \a pattern occurs at or -1 if it can
      * not be found.  If \a before is set, the search will only continue until the
@@ -176,13 +234,61 @@ namespace TagLib {
      * Searching starts at \a fromOffset and proceeds from the that point to the
      * beginning of the file and defaults to the end of the file.
      *
-     * \note This has the practial limitation that \a pattern can not be longer
-     * than the buffer size used by readBlock().  Currently this is 1024 bytes.
+     * \see searchWindowSize()
      */
     long rfind(const ByteVector &pattern,
                long fromOffset = 0,
                const ByteVector &before = ByteVector::null);
 
+    /*!
+     * This is the same as the above, but only searches back to the offset
+     * \a limit; \a pattern has to start at or after it.
+     */
+    long rfind(const ByteVector &pattern,
+               long fromOffset,
+               const ByteVector &before,
+               long limit);
+
+    /*!
+     * Sets the size of the largest block that find() and rfind() read at once
+     * to \a size.  The searches start with small blocks and double their size
+     * up to this, so that a search for a missing pattern costs a few large
+     * reads.  The default is 256 KiB.
+     */
+    void setSearchWindowSize(uint size);
+
+    /*!
+     * Returns the size of the largest block that find() and rfind() read at
+     * once.
+     *
+     * \see setSearchWindowSize()
+     */
+    uint searchWindowSize() const;
+
+    /*!
+     * Sets the way in which save() changes the size of parts of the file to
+     * \a strategy.  The default is InPlace.
+     *
+     * With ReplaceFile, every insert() and removeBlock() writes a new file and
+     * renames it over the original, sharing or copying the unchanged data in
+     * the kernel (see FileStream::rewrite()).  A crash during save() then can
+     * not leave a file with partly shifted audio data.  If the file is not
+     * read through a FileStream, or the new file can not be created, the
+     * file is changed in place.
+     *
+     * \note Only the changes that move data are covered.  Parts of the file
+     * that keep their size, such as an ID3v1 tag or a tag with enough
+     * padding, are still overwritten in place with writeBlock().
+     */
+    void setSaveStrategy(SaveStrategy strategy);
+
+    /*!
+     * Returns the way in which save() changes the file.
+     *
+     * \see setSaveStrategy()
+     */
+    SaveStrategy saveStrategy() const;
+
     /*!
      * Insert \a data at position \a start in the file overwriting \a replace
      * bytes of the original content.
@@ -276,6 +382,27 @@ namespace TagLib {
      */
     File(IOStream *stream);
 
+    /*!
+     * Constructs a File object from \a file, as above, which is read with
+     * \a readOptions, a combination of ReadOption values.
+     */
+    // BIC: merge with the above
+    File(FileName file, int readOptions);
+
+    /*!
+     * Constructs a File object from \a stream, as above, which is read with
+     * \a readOptions, a combination of ReadOption values.
+     */
+    // BIC: merge with the above
+    File(IOStream *stream, int readOptions);
+
+    /*!
+     * Returns the options the file has been read with.
+     *
+     * \see ReadOption
+     */
+    int readOptions() const;
+
     /*!
      * Marks the file as valid or invalid.
      *
@@ -290,13 +417,70 @@ namespace TagLib {
 
     /*!
      * Returns the buffer size that is used for internal buffering.
+     *
+     * \deprecated Use streamBufferSize(), which follows the file's stream.
      */
     static uint bufferSize();
 
+    /*!
+     * Returns the buffer size that is used for internal buffering.  This is
+     * the buffer size of the file's stream.
+     *
+     * \see IOStream::bufferSize()
+     */
+    uint streamBufferSize() const;
+
+    /*!
+     * Returns true if the file has been read with any of the ReadBasicFields
+     * options, which leave out the other fields of the tags.  save() must not
+     * write such tags back, as that would remove the fields that were left
+     * out.
+     */
+    bool readInPart() const;
+
+    /*!
+     * Queues replacing \a replace bytes at \a start with \a data, like
+     * insert() does, until commitEdits() is called.  \a start refers to the
+     * file as it is before any of the queued edits are done, and the replaced
+     * ranges of the queued edits must not overlap.
+     *
+     * This lets a save() that changes several parts of the file move the data
+     * in between only once, instead of once per change.
+     */
+    void queueInsert(const ByteVector &data, ulong start, ulong replace = 0);
+
+    /*!
+     * Queues removing \a length bytes at \a start until commitEdits() is
+     * called.
+     *
+     * \see queueInsert()
+     */
+    void queueRemoveBlock(ulong start, ulong length);
+
+    /*!
+     * Does all queued edits in a single pass over the file, in which every
+     * byte that has to be moved is moved only once.  Edits which keep the
+     * size of their part of the file are written in place, and if only one
+     * edit changes the size, it is passed to insert() or removeBlock().  With
+     * the ReplaceFile save strategy, all edits are written to a single new
+     * file by FileStream::rewrite().
+     *
+     * The file must not be read between queueing the edits and committing
+     * them, since the edits are not visible until then.
+     */
+    void commitEdits();
+
   private:
     File(const File &);
     File &operator=(const File &);
 
+    void moveBlock(long from, long to, long length);
+
+    friend class DeferredData;
+    void addDeferredData(DeferredData *data);
+    void removeDeferredData(DeferredData *data);
+    void loadDeferredData();
+
     class FilePrivate;
     FilePrivate *d;
   };
@@ -23,15 +23,34 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
 #include "tfilestream.h"
 #include "tstring.h"
 #include "tdebug.h"
 
+#include <algorithm>
+
 #ifdef _WIN32
 # include <windows.h>
 #else
-# include <stdio.h>
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <fcntl.h>
 # include <unistd.h>
+# include <errno.h>
+# ifdef HAVE_FALLOCATE_RANGE
+#  include <linux/falloc.h>
+# endif
+# ifdef HAVE_FICLONERANGE
+#  include <sys/ioctl.h>
+#  include <linux/fs.h>
+# endif
+# include <stdlib.h>
+# include <stdio.h>
+# include <vector>
 #endif
 
 using namespace TagLib;
@@ -91,32 +110,211 @@ namespace
     operator FileName () const { return c_str(); }
   };
 
-  typedef FILE* FileHandle;
+  // Uses a raw file descriptor and positional I/O instead of a FILE*.  The
+  // stream keeps its own logical position, so each read or write is a single
+  // pread() or pwrite() call without stdio buffering, and several streams can
+  // share one open file description.
+
+  typedef int FileHandle;
 
   const TagLib::uint BufferSize = 8192;
-  const FileHandle InvalidFileHandle = 0;
+  const FileHandle InvalidFileHandle = -1;
 
   inline FileHandle openFile(const FileName &path, bool readOnly)
   {
-    return fopen(path, readOnly ? "rb" : "rb+");
+    return ::open(path, readOnly ? O_RDONLY : O_RDWR);
+  }
+
+  inline FileHandle openFile(int fileDescriptor, bool readOnly)
+  {
+    const int flags = ::fcntl(fileDescriptor, F_GETFL);
+    if(flags == -1)
+      return InvalidFileHandle;
+
+    const int mode = flags & O_ACCMODE;
+    if(readOnly ? (mode == O_WRONLY) : (mode != O_RDWR))
+      return InvalidFileHandle;
+
+    return ::dup(fileDescriptor);
   }
 
   inline void closeFile(FileHandle file)
   {
-    fclose(file);
+    ::close(file);
   }
 
-  inline size_t readFile(FileHandle file, ByteVector &buffer)
+  inline size_t readFile(FileHandle file, ByteVector &buffer, long offset)
   {
-    return fread(buffer.data(), sizeof(char), buffer.size(), file);
+    size_t count = 0;
+    while(count < buffer.size()) {
+      const ssize_t n = ::pread(file, buffer.data() + count, buffer.size() - count, offset + count);
+      if(n > 0)
+        count += n;
+      else if(n == 0 || errno != EINTR)
+        break;
+    }
+    return count;
   }
 
-  inline size_t writeFile(FileHandle file, const ByteVector &buffer)
+  inline size_t writeFile(FileHandle file, const ByteVector &buffer, long offset)
+  {
+    size_t count = 0;
+    while(count < buffer.size()) {
+      const ssize_t n = ::pwrite(file, buffer.data() + count, buffer.size() - count, offset + count);
+      if(n > 0)
+        count += n;
+      else if(n == 0 || errno != EINTR)
+        break;
+    }
+    return count;
+  }
+
+  // Copies length bytes at fromOffset in one file to toOffset in another.
+  // Where the filesystem supports it the blocks are shared instead of copied,
+  // otherwise the kernel copies them, and only if neither is possible they
+  // go through a buffer here.
+
+  bool copyRange(FileHandle from, long fromOffset, FileHandle to, long toOffset, long length)
+  {
+#ifdef HAVE_FICLONERANGE
+
+    // Fails unless the offsets are block aligned, and the length too unless
+    // the range extends to the end of the file.
+
+    struct file_clone_range range;
+    range.src_fd      = from;
+    range.src_offset  = fromOffset;
+    range.src_length  = length;
+    range.dest_offset = toOffset;
+
+    if(length == 0 || ::ioctl(to, FICLONERANGE, &range) == 0)
+      return true;
+
+#endif
+
+#ifdef HAVE_COPY_FILE_RANGE
+
+    while(length > 0) {
+      off_t in = fromOffset;
+      off_t out = toOffset;
+      const ssize_t n = ::copy_file_range(from, &in, to, &out, length, 0);
+      if(n > 0) {
+        fromOffset += n;
+        toOffset   += n;
+        length     -= n;
+      }
+      else if(n == 0 || errno != EINTR)
+        break;
+    }
+
+#endif
+
+    ByteVector buffer;
+    while(length > 0) {
+      buffer.resize(static_cast<uint>(std::min<long>(length, 65536)));
+      const size_t count = readFile(from, buffer, fromOffset);
+      if(count == 0)
+        return false;
+
+      buffer.resize(static_cast<uint>(count));
+      if(writeFile(to, buffer, toOffset) != count)
+        return false;
+
+      fromOffset += count;
+      toOffset   += count;
+      length     -= count;
+    }
+
+    return true;
+  }
+
+  // Creates a file from the template in name, which is not inherited by
+  // child processes.
+
+  FileHandle createTempFile(char *name)
+  {
+#ifdef HAVE_MKOSTEMP
+    return ::mkostemp(name, O_CLOEXEC);
+#else
+    const FileHandle file = ::mkstemp(name);
+    if(file != InvalidFileHandle)
+      ::fcntl(file, F_SETFD, FD_CLOEXEC);
+    return file;
+#endif
+  }
+
+  // Flushes the directory that contains the file name, so that a file renamed
+  // into it is still there after a crash.
+
+  bool syncDirectory(const std::string &name)
   {
-    return fwrite(buffer.data(), sizeof(char), buffer.size(), file);
+    const std::string::size_type slash = name.rfind('/');
+    const std::string directory
+      = (slash == std::string::npos) ? "." : name.substr(0, std::max<size_t>(slash, 1));
+
+    int flags = O_RDONLY;
+#ifdef O_DIRECTORY
+    flags |= O_DIRECTORY;
+#endif
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+
+    const int file = ::open(directory.c_str(), flags);
+    if(file == -1)
+      return false;
+
+    const bool synced = (::fsync(file) == 0);
+    ::close(file);
+    return synced;
   }
 
 #endif  // _WIN32
+
+#ifdef HAVE_FALLOCATE_RANGE
+
+  // Inserts a hole of delta bytes into the file, or collapses delta bytes of
+  // it, somewhere within the range [start, start + replace) that the caller is
+  // going to overwrite anyway.  The tail of the file is shifted by the
+  // filesystem's extent map and no data is copied.
+  //
+  // The filesystem requires the offset and the delta to be multiples of its
+  // block size, so this fails on most calls unless the caller has rounded the
+  // delta, and on filesystems that don't support the operation at all.  The
+  // file is left untouched if it fails.
+
+  bool shiftRange(FileHandle file, long start, long replace, long delta, bool grow)
+  {
+    struct stat st;
+    if(::fstat(file, &st) != 0 || st.st_blksize <= 0)
+      return false;
+
+    const long blockSize = static_cast<long>(st.st_blksize);
+    if(delta <= 0 || delta % blockSize != 0)
+      return false;
+
+    const long offset = (start + blockSize - 1) / blockSize * blockSize;
+    if(grow) {
+      if(offset > start + replace || offset >= static_cast<long>(st.st_size))
+        return false;
+    }
+    else {
+      if(offset + delta > start + replace || offset + delta >= static_cast<long>(st.st_size))
+        return false;
+    }
+
+    const int mode = grow ? FALLOC_FL_INSERT_RANGE : FALLOC_FL_COLLAPSE_RANGE;
+    return (::fallocate(file, mode, offset, delta) == 0);
+  }
+
+#else
+
+  inline bool shiftRange(FileHandle, long, long, long, bool)
+  {
+    return false;
+  }
+
+#endif  // HAVE_FALLOCATE_RANGE
 }
 
 class FileStream::FileStreamPrivate
@@ -126,12 +324,48 @@ public:
     : file(InvalidFileHandle)
     , name(fileName)
     , readOnly(true)
+#ifndef _WIN32
+    , position(0)
+#endif
+  {
+  }
+
+  // Reads or writes at the current position and advances it.
+
+  size_t read(ByteVector &buffer)
+  {
+#ifdef _WIN32
+    return readFile(file, buffer);
+#else
+    const size_t count = readFile(file, buffer, position);
+    position += static_cast<long>(count);
+    return count;
+#endif
+  }
+
+  size_t write(const ByteVector &buffer)
   {
+#ifdef _WIN32
+    return writeFile(file, buffer);
+#else
+    const size_t count = writeFile(file, buffer, position);
+    position += static_cast<long>(count);
+    return count;
+#endif
   }
 
   FileHandle file;
   FileNameHandle name;
   bool readOnly;
+
+#ifndef _WIN32
+
+  // The logical read/write position.  The position of the file description
+  // itself is never used.
+
+  long position;
+
+#endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -141,6 +375,8 @@ public:
 FileStream::FileStream(FileName fileName, bool openReadOnly)
   : d(new FileStreamPrivate(fileName))
 {
+  setBufferSize(BufferSize);
+
   // First try with read / write mode, if that fails, fall back to read only.
 
   if(!openReadOnly)
@@ -161,6 +397,29 @@ FileStream::FileStream(FileName fileName, bool openReadOnly)
   }
 }
 
+#ifndef _WIN32
+
+FileStream::FileStream(int fileDescriptor, bool openReadOnly)
+  : d(new FileStreamPrivate(""))
+{
+  setBufferSize(BufferSize);
+
+  // First try with read / write mode, if that fails, fall back to read only.
+
+  if(!openReadOnly)
+    d->file = openFile(fileDescriptor, false);
+
+  if(d->file != InvalidFileHandle)
+    d->readOnly = false;
+  else
+    d->file = openFile(fileDescriptor, true);
+
+  if(d->file == InvalidFileHandle)
+    debug("Could not open file using file descriptor " + String::number(fileDescriptor));
+}
+
+#endif
+
 FileStream::~FileStream()
 {
   if(isOpen())
@@ -190,7 +449,7 @@ ByteVector FileStream::readBlock(ulong length)
 
   ByteVector buffer(static_cast<uint>(length));
 
-  const size_t count = readFile(d->file, buffer);
+  const size_t count = d->read(buffer);
   buffer.resize(static_cast<uint>(count));
   
   return buffer;
@@ -208,7 +467,7 @@ void FileStream::writeBlock(const ByteVector &data)
     return;
   }
 
-  writeFile(d->file, data);
+  d->write(data);
 }
 
 void FileStream::insert(const ByteVector &data, ulong start, ulong replace)
@@ -229,9 +488,24 @@ void FileStream::insert(const ByteVector &data, ulong start, ulong replace)
     return;
   }
   else if(data.size() < replace) {
+    if(shiftRange(d->file, start, replace, replace - data.size(), false)) {
+      seek(start);
+      writeBlock(data);
+    }
+    else {
+      seek(start);
+      writeBlock(data);
+      removeBlock(start + data.size(), replace - data.size());
+    }
+    return;
+  }
+
+  // If the filesystem can insert whole blocks into the file, we're done after
+  // overwriting the old data.
+
+  if(shiftRange(d->file, start, replace, data.size() - replace, true)) {
     seek(start);
     writeBlock(data);
-    removeBlock(start + data.size(), replace - data.size());
     return;
   }
 
@@ -264,7 +538,7 @@ void FileStream::insert(const ByteVector &data, ulong start, ulong replace)
     // to overwrite.  Appropriately increment the readPosition.
     
     seek(readPosition);
-    const size_t bytesRead = readFile(d->file, aboutToOverwrite);
+    const size_t bytesRead = d->read(aboutToOverwrite);
     aboutToOverwrite.resize(bytesRead);
     readPosition += bufferLength;
 
@@ -300,6 +574,9 @@ void FileStream::removeBlock(ulong start, ulong length)
     return;
   }
 
+  if(shiftRange(d->file, start, length, length, false))
+    return;
+
   ulong bufferLength = bufferSize();
 
   long readPosition = start + length;
@@ -310,7 +587,7 @@ void FileStream::removeBlock(ulong start, ulong length)
   for(size_t bytesRead = -1; bytesRead != 0;)
   {
     seek(readPosition);
-    bytesRead = readFile(d->file, buffer);
+    bytesRead = d->read(buffer);
     readPosition += bytesRead;
 
     // Check to see if we just read the last block.  We need to call clear()
@@ -322,7 +599,7 @@ void FileStream::removeBlock(ulong start, ulong length)
     }
 
     seek(writePosition);
-    writeFile(d->file, buffer);
+    d->write(buffer);
 
     writePosition += bytesRead;
   }
@@ -330,6 +607,103 @@ void FileStream::removeBlock(ulong start, ulong length)
   truncate(writePosition);
 }
 
+bool FileStream::rewrite(const ByteVector &data, ulong start, ulong replace)
+{
+  List<Change> changes;
+  changes.append(Change(data, start, replace));
+  return rewrite(changes);
+}
+
+bool FileStream::rewrite(const List<Change> &changes)
+{
+#ifdef _WIN32
+
+  return false;
+
+#else
+
+  if(!isOpen() || readOnly())
+    return false;
+
+  // Replacing a symbolic link or one of several hard links with a new file
+  // would change more than the file's content.
+
+  struct stat st;
+  const std::string &name = d->name;
+  if(name.empty()
+     || ::lstat(name.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_nlink != 1
+     || ::fstat(d->file, &st) != 0)
+  {
+    return false;
+  }
+
+  const long fileLength = static_cast<long>(st.st_size);
+
+  long previousEnd = 0;
+  for(List<Change>::ConstIterator it = changes.begin(); it != changes.end(); ++it) {
+    if(static_cast<long>(it->start) < previousEnd || static_cast<long>(it->start) > fileLength)
+      return false;
+    previousEnd = it->start + std::min<ulong>(it->replace, fileLength - it->start);
+  }
+
+  std::vector<char> tempName(name.begin(), name.end());
+  const char suffix[] = ".XXXXXX";
+  tempName.insert(tempName.end(), suffix, suffix + sizeof(suffix));
+
+  const FileHandle temp = createTempFile(&tempName[0]);
+  if(temp == InvalidFileHandle) {
+    debug("FileStream::rewrite() -- Could not create a temporary file.");
+    return false;
+  }
+
+  // The owner can only be kept if we are allowed to change it.
+
+  ::fchmod(temp, st.st_mode & 07777);
+  if(::fchown(temp, st.st_uid, st.st_gid) != 0) {
+    // Keep the temporary file's owner.
+  }
+
+  // Copy the parts in front of each change and the change itself, then the
+  // rest of the file behind the last change.
+
+  long readOffset = 0;
+  long writeOffset = 0;
+  bool copied = true;
+
+  for(List<Change>::ConstIterator it = changes.begin(); copied && it != changes.end(); ++it) {
+    const long length = it->start - readOffset;
+    copied = copyRange(d->file, readOffset, temp, writeOffset, length)
+      && writeFile(temp, it->data, writeOffset + length) == it->data.size();
+
+    readOffset  = it->start + std::min<ulong>(it->replace, fileLength - it->start);
+    writeOffset += length + it->data.size();
+  }
+
+  copied = copied
+    && copyRange(d->file, readOffset, temp, writeOffset, fileLength - readOffset)
+    && ::fsync(temp) == 0;
+
+  if(!copied || ::rename(&tempName[0], name.c_str()) != 0) {
+    debug("FileStream::rewrite() -- Could not replace the file.");
+    ::unlink(&tempName[0]);
+    closeFile(temp);
+    return false;
+  }
+
+  closeFile(d->file);
+  d->file = temp;
+
+  if(!syncDirectory(name))
+    debug("FileStream::rewrite() -- Could not flush the directory of the file.");
+
+  if(accessHints() != NormalAccess)
+    setAccessHints(accessHints());
+
+  return true;
+
+#endif
+}
+
 bool FileStream::readOnly() const
 {
   return d->readOnly;
@@ -372,23 +746,27 @@ void FileStream::seek(long offset, Position p)
 
 #else
 
-  int whence;
+  long position;
   switch(p) {
   case Beginning:
-    whence = SEEK_SET;
+    position = offset;
     break;
   case Current:
-    whence = SEEK_CUR;
+    position = d->position + offset;
     break;
   case End:
-    whence = SEEK_END;
+    position = length() + offset;
     break;
   default:
     debug("FileStream::seek() -- Invalid Position value.");
     return;
   }
 
-  fseek(d->file, offset, whence);
+  // Like fseek(), seeking before the beginning of the file fails and leaves
+  // the position unchanged.
+
+  if(position >= 0)
+    d->position = position;
 
 #endif
 }
@@ -401,7 +779,7 @@ void FileStream::clear()
 
 #else
 
-  clearerr(d->file);
+  // NOP, there are no end-of-file or error flags to reset.
 
 #endif
 }
@@ -421,7 +799,7 @@ long FileStream::tell() const
 
 #else
 
-  return ftell(d->file);
+  return d->position;
 
 #endif
 }
@@ -446,14 +824,14 @@ long FileStream::length()
 
 #else
 
-  const long curpos = tell();
-
-  seek(0, End);
-  const long endpos = tell();
-
-  seek(curpos, Beginning);
-
-  return endpos;
+  struct stat st;
+  if(::fstat(d->file, &st) == 0) {
+    return static_cast<long>(st.st_size);
+  }
+  else {
+    debug("File::length() -- Failed to get the file size.");
+    return 0;
+  }
 
 #endif
 }
@@ -478,7 +856,7 @@ void FileStream::truncate(long length)
 
 #else
 
-  const int error = ftruncate(fileno(d->file), length);
+  const int error = ::ftruncate(d->file, length);
   if(error != 0) {
     debug("FileStream::truncate() -- Coundn't truncate the file.");
   }
@@ -486,7 +864,25 @@ void FileStream::truncate(long length)
 #endif
 }
 
-TagLib::uint FileStream::bufferSize()
+void FileStream::setAccessHints(int hints)
 {
-  return BufferSize;
+  IOStream::setAccessHints(hints);
+
+#ifdef HAVE_POSIX_FADVISE
+
+  if(!isOpen())
+    return;
+
+  int advice = POSIX_FADV_NORMAL;
+  if(hints & SequentialAccess)
+    advice = POSIX_FADV_SEQUENTIAL;
+  else if(hints & RandomAccess)
+    advice = POSIX_FADV_RANDOM;
+
+  ::posix_fadvise(d->file, 0, 0, advice);
+
+  if(hints & NoReuse)
+    ::posix_fadvise(d->file, 0, 0, POSIX_FADV_NOREUSE);
+
+#endif
 }
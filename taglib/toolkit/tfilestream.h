@@ -29,6 +29,7 @@
 #include "taglib_export.h"
 #include "taglib.h"
 #include "tbytevector.h"
+#include "tlist.h"
 #include "tiostream.h"
 
 namespace TagLib {
@@ -48,12 +49,42 @@ namespace TagLib {
   class TAGLIB_EXPORT FileStream : public IOStream
   {
   public:
+    /*!
+     * A change for rewrite(): \a data replaces \a replace bytes at \a start.
+     */
+    struct Change
+    {
+      Change(const ByteVector &data, ulong start, ulong replace) :
+        data(data), start(start), replace(replace) {}
+
+      ByteVector data;
+      ulong start;
+      ulong replace;
+    };
+
     /*!
      * Construct a File object and opens the \a file.  \a file should be a
      * be a C-string in the local file system encoding.
      */
     FileStream(FileName file, bool openReadOnly = false);
 
+#ifndef _WIN32
+
+    /*!
+     * Construct a File object using the open file descriptor \a fileDescriptor.
+     * The descriptor is duplicated, so the caller keeps ownership of
+     * \a fileDescriptor and may close it at any time.
+     *
+     * Reads and writes use positional I/O and never move the offset of the
+     * underlying open file description.  Several FileStream objects, one per
+     * thread, may therefore be created from the same descriptor and used
+     * concurrently for reading.  A single FileStream must still not be used
+     * from more than one thread at a time.
+     */
+    FileStream(int fileDescriptor, bool openReadOnly = false);
+
+#endif
+
     /*!
      * Destroys this FileStream instance.
      */
@@ -85,7 +116,11 @@ namespace TagLib {
      * bytes of the original content.
      *
      * \note This method is slow since it requires rewriting all of the file
-     * after the insertion point.
+     * after the insertion point.  On Linux filesystems which support
+     * FALLOC_FL_INSERT_RANGE and FALLOC_FL_COLLAPSE_RANGE, a size difference
+     * which is a multiple of the filesystem block size is done by shifting the
+     * file's extents instead, provided that \a start is block aligned or the
+     * replaced range spans a block boundary.
      */
     void insert(const ByteVector &data, ulong start = 0, ulong replace = 0);
 
@@ -94,10 +129,37 @@ namespace TagLib {
      * \a length bytes.
      *
      * \note This method is slow since it involves rewriting all of the file
-     * after the removed portion.
+     * after the removed portion, unless \a start and \a length are multiples
+     * of the filesystem block size and the filesystem can collapse the range.
      */
     void removeBlock(ulong start = 0, ulong length = 0);
 
+    /*!
+     * Does the same as insert(), but writes the result to a new file next to
+     * the original one, which then atomically replaces it.  The parts of the
+     * file that are not changed are cloned by the filesystem where possible
+     * (e.g. on Btrfs or XFS), or copied within the kernel.  The new file and
+     * its directory entry are flushed to disk, so if the process or system
+     * crashes while this is going on, the file keeps either its old or its new
+     * content.
+     *
+     * Returns false, and leaves the file unchanged, if this is not possible:
+     * when the stream was not opened by name, the file is a symbolic link or
+     * has several hard links, the directory is not writable, or on Windows.
+     * The replaced file keeps its permissions, and its owner if the process
+     * is allowed to set it.
+     *
+     * \see File::setSaveStrategy()
+     */
+    bool rewrite(const ByteVector &data, ulong start = 0, ulong replace = 0);
+
+    /*!
+     * Does the same as rewrite() for all of \a changes at once, so that the
+     * file is replaced only once.  The changes must be sorted by their start
+     * in the original file and must not overlap, otherwise false is returned.
+     */
+    bool rewrite(const List<Change> &changes);
+
     /*!
      * Returns true if the file is read only (or if the file can not be opened).
      */
@@ -137,12 +199,15 @@ namespace TagLib {
      */
     void truncate(long length);
 
-  protected:
-
     /*!
-     * Returns the buffer size that is used for internal buffering.
+     * Sets the access hints of the stream to \a hints.  On POSIX systems
+     * they are passed to posix_fadvise(): SequentialAccess doubles the
+     * kernel's read-ahead, RandomAccess disables it, and NoReuse asks it not
+     * to keep the file's pages cached at the expense of other files.
+     *
+     * \see IOStream::setAccessHints()
      */
-    static uint bufferSize();
+    void setAccessHints(int hints);
 
   private:
     class FileStreamPrivate;
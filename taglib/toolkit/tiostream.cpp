@@ -132,19 +132,58 @@ String FileName::toString() const
 
 #endif  // _WIN32
 
+namespace
+{
+  const TagLib::uint DefaultBufferSize = 1024;
+}
+
+class IOStream::IOStreamPrivate
+{
+public:
+  IOStreamPrivate() :
+    bufferSize(DefaultBufferSize),
+    accessHints(NormalAccess) {}
+
+  uint bufferSize;
+  int accessHints;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-IOStream::IOStream()
+IOStream::IOStream() :
+  d(new IOStreamPrivate())
 {
 }
 
 IOStream::~IOStream()
 {
+  delete d;
 }
 
 void IOStream::clear()
 {
 }
 
+TagLib::uint IOStream::bufferSize() const
+{
+  return d->bufferSize;
+}
+
+void IOStream::setBufferSize(uint size)
+{
+  if(size > 0)
+    d->bufferSize = size;
+}
+
+int IOStream::accessHints() const
+{
+  return d->accessHints;
+}
+
+void IOStream::setAccessHints(int hints)
+{
+  d->accessHints = hints;
+}
+
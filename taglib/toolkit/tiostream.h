@@ -74,6 +74,21 @@ namespace TagLib {
       End
     };
 
+    /*!
+     * Hints about how the stream is going to be read, which may be OR-ed
+     * together.  Streams may use them to tune read-ahead and caching.
+     */
+    enum AccessHint {
+      //! No particular access pattern.
+      NormalAccess     = 0x00,
+      //! The stream will be read from the beginning to the end.
+      SequentialAccess = 0x01,
+      //! The stream will be read in small blocks at random offsets.
+      RandomAccess     = 0x02,
+      //! The data will be read only once and need not be kept cached.
+      NoReuse          = 0x04
+    };
+
     IOStream();
 
     /*!
@@ -159,9 +174,44 @@ namespace TagLib {
      */
     virtual void truncate(long length) = 0;
 
+    /*!
+     * Returns the size of the blocks in which the stream is read when it is
+     * scanned, e.g. by File::find() or when looking for MPEG frames, and in
+     * which data is moved by insert() and removeBlock().
+     *
+     * The default depends on the kind of stream.
+     */
+    virtual uint bufferSize() const;
+
+    /*!
+     * Sets the size of the blocks in which the stream is scanned to \a size.
+     * Bulk scanners may use large blocks to make fewer and larger reads.
+     *
+     * \see bufferSize()
+     */
+    virtual void setBufferSize(uint size);
+
+    /*!
+     * Returns the access hints, OR-ed AccessHint values, given for the stream.
+     * The default is NormalAccess.
+     */
+    int accessHints() const;
+
+    /*!
+     * Sets the access hints of the stream to \a hints, OR-ed AccessHint
+     * values.  FileStream passes them on to the operating system, so that a
+     * scan over many files does not evict the page cache of other processes.
+     *
+     * \see accessHints()
+     */
+    virtual void setAccessHints(int hints);
+
   private:
     IOStream(const IOStream &);
     IOStream &operator=(const IOStream &);
+
+    class IOStreamPrivate;
+    IOStreamPrivate *d;
   };
 
 }
@@ -28,14 +28,14 @@
 
 #include "taglib.h"
 
-#include <list>
+#include <vector>
 
 namespace TagLib {
 
   //! A generic, implicitly shared list.
 
   /*!
-   * This is basic generic list that's somewhere between a std::list and a
+   * This is basic generic list that's somewhere between a std::vector and a
    * QValueList.  This class is implicitly shared.  For example:
    *
    * \code
@@ -48,14 +48,19 @@ namespace TagLib {
    * return types of functions.  The above example will just copy a pointer rather
    * than copying the data in the list.  When your \e shared list's data changes,
    * only \e then will the data be copied.
+   *
+   * The items are stored contiguously, so accessing an item by its index is
+   * cheap.  As with std::vector, inserting or erasing items invalidates the
+   * iterators and references to the items after them, and appending may
+   * invalidate all of them.
    */
 
   template <class T> class List
   {
   public:
 #ifndef DO_NOT_DOCUMENT
-    typedef typename std::list<T>::iterator Iterator;
-    typedef typename std::list<T>::const_iterator ConstIterator;
+    typedef typename std::vector<T>::iterator Iterator;
+    typedef typename std::vector<T>::const_iterator ConstIterator;
 #endif
 
     /*!
@@ -70,6 +75,14 @@ namespace TagLib {
      */
     List(const List<T> &l);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Constructs a list that takes over the data of \a l, which is left
+     * empty.
+     */
+    List(List<T> &&l);
+#endif
+
     /*!
      * Destroys this List instance.  If auto deletion is enabled and this list
      * contains a pointer type all of the memebers are also deleted.
@@ -78,25 +91,25 @@ namespace TagLib {
 
     /*!
      * Returns an STL style iterator to the beginning of the list.  See
-     * std::list::const_iterator for the semantics.
+     * std::vector::const_iterator for the semantics.
      */
     Iterator begin();
 
     /*!
      * Returns an STL style constant iterator to the beginning of the list.  See
-     * std::list::iterator for the semantics.
+     * std::vector::iterator for the semantics.
      */
     ConstIterator begin() const;
 
     /*!
      * Returns an STL style iterator to the end of the list.  See
-     * std::list::iterator for the semantics.
+     * std::vector::iterator for the semantics.
      */
     Iterator end();
 
     /*!
      * Returns an STL style constant iterator to the end of the list.  See
-     * std::list::const_iterator for the semantics.
+     * std::vector::const_iterator for the semantics.
      */
     ConstIterator end() const;
 
@@ -105,6 +118,13 @@ namespace TagLib {
      */
     Iterator insert(Iterator it, const T &value);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Moves \a value into the list before \a it.
+     */
+    Iterator insert(Iterator it, T &&value);
+#endif
+
     /*!
      * Inserts the \a value into the list.  This assumes that the list is
      * currently sorted.  If \a unique is true then the value will not
@@ -118,6 +138,14 @@ namespace TagLib {
      */
     List<T> &append(const T &item);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Moves \a item to the end of the list and returns a reference to the
+     * list.
+     */
+    List<T> &append(T &&item);
+#endif
+
     /*!
      * Appends all of the values in \a l to the end of the list and returns a
      * reference to the list.
@@ -130,6 +158,14 @@ namespace TagLib {
      */
     List<T> &prepend(const T &item);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Moves \a item to the beginning of the list and returns a reference to
+     * the list.
+     */
+    List<T> &prepend(T &&item);
+#endif
+
     /*!
      * Prepends all of the items in \a l to the beginning list and returns a
      * reference to the list.
@@ -202,15 +238,11 @@ namespace TagLib {
 
     /*!
      * Returns a reference to item \a i in the list.
-     *
-     * \warning This method is slow.  Use iterators to loop through the list.
      */
     T &operator[](uint i);
 
     /*!
      * Returns a const reference to item \a i in the list.
-     *
-     * \warning This method is slow.  Use iterators to loop through the list.
      */
     const T &operator[](uint i) const;
 
@@ -221,6 +253,14 @@ namespace TagLib {
      */
     List<T> &operator=(const List<T> &l);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Exchanges the data of this list with that of \a l, which releases it
+     * when it goes out of scope.
+     */
+    List<T> &operator=(List<T> &&l);
+#endif
+
     /*!
      * Compares this list with \a l and returns true if all of the elements are
      * the same.
@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <utility>
 #include "trefcounter.h"
 
 namespace TagLib {
@@ -53,11 +54,11 @@ template <class TP> class List<T>::ListPrivate  : public ListPrivateBase
 {
 public:
   ListPrivate() : ListPrivateBase() {}
-  ListPrivate(const std::list<TP> &l) : ListPrivateBase(), list(l) {}
+  ListPrivate(const std::vector<TP> &l) : ListPrivateBase(), list(l) {}
   void clear() {
     list.clear();
   }
-  std::list<TP> list;
+  std::vector<TP> list;
 };
 
 // A partial specialization for all pointer types that implements the
@@ -68,19 +69,19 @@ template <class TP> class List<T>::ListPrivate<TP *>  : public ListPrivateBase
 {
 public:
   ListPrivate() : ListPrivateBase() {}
-  ListPrivate(const std::list<TP *> &l) : ListPrivateBase(), list(l) {}
+  ListPrivate(const std::vector<TP *> &l) : ListPrivateBase(), list(l) {}
   ~ListPrivate() {
     clear();
   }
   void clear() {
     if(autoDelete) {
-      typename std::list<TP *>::const_iterator it = list.begin();
+      typename std::vector<TP *>::const_iterator it = list.begin();
       for(; it != list.end(); ++it)
         delete *it;
     }
     list.clear();
   }
-  std::list<TP *> list;
+  std::vector<TP *> list;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -99,6 +100,16 @@ List<T>::List(const List<T> &l) : d(l.d)
   d->ref();
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+template <class T>
+List<T>::List(List<T> &&l) : d(l.d)
+{
+  l.d = new ListPrivate<T>;
+}
+
+#endif
+
 template <class T>
 List<T>::~List()
 {
@@ -139,16 +150,25 @@ typename List<T>::Iterator List<T>::insert(Iterator it, const T &item)
   return d->list.insert(it, item);
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+template <class T>
+typename List<T>::Iterator List<T>::insert(Iterator it, T &&item)
+{
+  detach();
+  return d->list.insert(it, std::move(item));
+}
+
+#endif
+
 template <class T>
 List<T> &List<T>::sortedInsert(const T &value, bool unique)
 {
   detach();
-  Iterator it = begin();
-  while(it != end() && *it < value)
-    ++it;
-  if(unique && it != end() && *it == value)
+  Iterator it = std::lower_bound(d->list.begin(), d->list.end(), value);
+  if(unique && it != d->list.end() && *it == value)
     return *this;
-  insert(it, value);
+  d->list.insert(it, value);
   return *this;
 }
 
@@ -160,11 +180,27 @@ List<T> &List<T>::append(const T &item)
   return *this;
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+template <class T>
+List<T> &List<T>::append(T &&item)
+{
+  detach();
+  d->list.push_back(std::move(item));
+  return *this;
+}
+
+#endif
+
 template <class T>
 List<T> &List<T>::append(const List<T> &l)
 {
+  // Holding a reference to the items of l makes detach() copy them if l is
+  // this list, since a vector can not insert a range of itself.
+
+  const List<T> items(l);
   detach();
-  d->list.insert(d->list.end(), l.begin(), l.end());
+  d->list.insert(d->list.end(), items.begin(), items.end());
   return *this;
 }
 
@@ -172,15 +208,28 @@ template <class T>
 List<T> &List<T>::prepend(const T &item)
 {
   detach();
-  d->list.push_front(item);
+  d->list.insert(d->list.begin(), item);
   return *this;
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+template <class T>
+List<T> &List<T>::prepend(T &&item)
+{
+  detach();
+  d->list.insert(d->list.begin(), std::move(item));
+  return *this;
+}
+
+#endif
+
 template <class T>
 List<T> &List<T>::prepend(const List<T> &l)
 {
+  const List<T> items(l);
   detach();
-  d->list.insert(d->list.begin(), l.begin(), l.end());
+  d->list.insert(d->list.begin(), items.begin(), items.end());
   return *this;
 }
 
@@ -207,6 +256,7 @@ bool List<T>::isEmpty() const
 template <class T>
 typename List<T>::Iterator List<T>::find(const T &value)
 {
+  detach();
   return std::find(d->list.begin(), d->list.end(), value);
 }
 
@@ -263,23 +313,14 @@ T &List<T>::back()
 template <class T>
 T &List<T>::operator[](uint i)
 {
-  Iterator it = d->list.begin();
-
-  for(uint j = 0; j < i; j++)
-    ++it;
-
-  return *it;
+  detach();
+  return d->list[i];
 }
 
 template <class T>
 const T &List<T>::operator[](uint i) const
 {
-  ConstIterator it = d->list.begin();
-
-  for(uint j = 0; j < i; j++)
-    ++it;
-
-  return *it;
+  return d->list[i];
 }
 
 template <class T>
@@ -295,6 +336,17 @@ List<T> &List<T>::operator=(const List<T> &l)
   return *this;
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+template <class T>
+List<T> &List<T>::operator=(List<T> &&l)
+{
+  std::swap(d, l.d);
+  return *this;
+}
+
+#endif
+
 template <class T>
 bool List<T>::operator==(const List<T> &l) const
 {
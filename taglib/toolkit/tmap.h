@@ -26,7 +26,8 @@
 #ifndef TAGLIB_MAP_H
 #define TAGLIB_MAP_H
 
-#include <map>
+#include <vector>
+#include <utility>
 
 #include "taglib.h"
 
@@ -38,6 +39,11 @@ namespace TagLib {
    * This implements a standard map container that associates a key with a value
    * and has fast key-based lookups.  This map is also implicitly shared making
    * it suitable for pass-by-value usage.
+   *
+   * The items are kept in a vector sorted by their keys, which are compared
+   * with operator<().  This makes lookups and iteration cheap, but inserting
+   * or erasing an item invalidates all iterators and references to the
+   * items.  As with std::map, the items are of type std::pair<const Key, T>.
    */
 
   template <class Key, class T> class Map
@@ -53,11 +59,11 @@ namespace TagLib {
     // Not all the specializations of Map can use the class keyword
     // (when T is not actually a class type), so don't apply this
     // generally.
-    typedef typename std::map<class Key, class T>::iterator Iterator;
-    typedef typename std::map<class Key, class T>::const_iterator ConstIterator;
+    typedef typename std::vector<std::pair<const class Key, class T> >::iterator Iterator;
+    typedef typename std::vector<std::pair<const class Key, class T> >::const_iterator ConstIterator;
 #else
-    typedef typename std::map<Key, T>::iterator Iterator;
-    typedef typename std::map<Key, T>::const_iterator ConstIterator;
+    typedef typename std::vector<std::pair<const Key, T> >::iterator Iterator;
+    typedef typename std::vector<std::pair<const Key, T> >::const_iterator ConstIterator;
 #endif
 #endif
 
@@ -73,6 +79,14 @@ namespace TagLib {
      */
     Map(const Map<Key, T> &m);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Constructs a map that takes over the data of \a m, which is left
+     * empty.
+     */
+    Map(Map<Key, T> &&m);
+#endif
+
     /*!
      * Destroys this instance of the Map.
      */
@@ -108,6 +122,14 @@ namespace TagLib {
      */
     Map<Key, T> &insert(const Key &key, const T &value);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Moves \a value into the map under \a key.  If a value for \a key
+     * already exists it will be overwritten.
+     */
+    Map<Key, T> &insert(const Key &key, T &&value);
+#endif
+
     /*!
      * Removes all of the elements from elements from the map.  This however
      * will not delete pointers if the mapped type is a pointer type.
@@ -156,7 +178,8 @@ namespace TagLib {
     /*!
      * Returns a reference to the value associated with \a key.
      *
-     * \note This has undefined behavior if the key is not present in the map.
+     * \note If the key is not present in the map, a reference to a default
+     * constructed value is returned, which must not be modified.
      */
     const T &operator[](const Key &key) const;
 
@@ -174,6 +197,14 @@ namespace TagLib {
      */
     Map<Key, T> &operator=(const Map<Key, T> &m);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Exchanges the data of this map with that of \a m, which releases it
+     * when it goes out of scope.
+     */
+    Map<Key, T> &operator=(Map<Key, T> &&m);
+#endif
+
   protected:
     /*
      * If this List is being shared via implicit sharing, do a deep copy of the
@@ -23,6 +23,8 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <algorithm>
+#include <utility>
 #include "trefcounter.h"
 
 namespace TagLib {
@@ -36,14 +38,128 @@ template <class KeyP, class TP>
 class Map<Key, T>::MapPrivate : public RefCounter
 {
 public:
-  MapPrivate() : RefCounter() {}
 #ifdef WANT_CLASS_INSTANTIATION_OF_MAP
-  MapPrivate(const std::map<class KeyP, class TP>& m) : RefCounter(), map(m) {}
-  std::map<class KeyP, class TP> map;
+  typedef std::vector<std::pair<const class KeyP, class TP> > Container;
+#else
+  typedef std::vector<std::pair<const KeyP, TP> > Container;
+#endif
+
+  MapPrivate() : RefCounter() {}
+  MapPrivate(const Container &m) : RefCounter(), map(m) {}
+
+  struct KeyLess
+  {
+    bool operator()(const typename Container::value_type &item, const KeyP &key) const
+    {
+      return item.first < key;
+    }
+  };
+
+  /*!
+   * Returns the position of \a key, or where it would have to be inserted.
+   */
+  typename Container::iterator lowerBound(const KeyP &key)
+  {
+    return std::lower_bound(map.begin(), map.end(), key, KeyLess());
+  }
+
+  typename Container::const_iterator lowerBound(const KeyP &key) const
+  {
+    return std::lower_bound(map.begin(), map.end(), key, KeyLess());
+  }
+
+  typename Container::iterator find(const KeyP &key)
+  {
+    typename Container::iterator it = lowerBound(key);
+    return (it != map.end() && !(key < it->first)) ? it : map.end();
+  }
+
+  typename Container::const_iterator find(const KeyP &key) const
+  {
+    typename Container::const_iterator it = lowerBound(key);
+    return (it != map.end() && !(key < it->first)) ? it : map.end();
+  }
+
+  /*!
+   * Returns the value of \a key, inserting a default constructed one first if
+   * there is none.
+   */
+  TP &value(const KeyP &key)
+  {
+    typename Container::iterator it = lowerBound(key);
+    if(it == map.end() || key < it->first)
+      it = insert(it, typename Container::value_type(key, TP()));
+    return it->second;
+  }
+
+  /*!
+   * Inserts \a item before \a pos.  The items can't be assigned, as their
+   * keys are const, so unless the item goes at the end, the vector is rebuilt
+   * around it.
+   */
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  typename Container::iterator insert(typename Container::iterator pos,
+                                      typename Container::value_type &&item)
+#else
+  typename Container::iterator insert(typename Container::iterator pos,
+                                      const typename Container::value_type &item)
+#endif
+  {
+    const size_t index = pos - map.begin();
+
+    if(index == map.size()) {
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+      map.push_back(std::move(item));
+#else
+      map.push_back(item);
+#endif
+    }
+    else {
+      Container items;
+      items.reserve(map.size() < map.capacity() ? map.capacity() : map.size() * 2);
+      append(items, map.begin(), pos);
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+      items.push_back(std::move(item));
 #else
-  MapPrivate(const std::map<KeyP, TP>& m) : RefCounter(), map(m) {}
-  std::map<KeyP, TP> map;
+      items.push_back(item);
 #endif
+      append(items, pos, map.end());
+      map.swap(items);
+    }
+
+    return map.begin() + index;
+  }
+
+  /*!
+   * Removes the item at \a pos, rebuilding the vector as insert() does.
+   */
+  void erase(typename Container::iterator pos)
+  {
+    if(pos + 1 == map.end()) {
+      map.pop_back();
+    }
+    else {
+      Container items;
+      items.reserve(map.capacity());
+      append(items, map.begin(), pos);
+      append(items, pos + 1, map.end());
+      map.swap(items);
+    }
+  }
+
+  static void append(Container &items, typename Container::iterator first,
+                     typename Container::iterator last)
+  {
+    for(; first != last; ++first) {
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+      items.push_back(std::move(*first));
+#else
+      items.push_back(*first);
+#endif
+    }
+  }
+
+  Container map;
 };
 
 template <class Key, class T>
@@ -58,6 +174,16 @@ Map<Key, T>::Map(const Map<Key, T> &m) : d(m.d)
   d->ref();
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+template <class Key, class T>
+Map<Key, T>::Map(Map<Key, T> &&m) : d(m.d)
+{
+  m.d = new MapPrivate<Key, T>;
+}
+
+#endif
+
 template <class Key, class T>
 Map<Key, T>::~Map()
 {
@@ -75,7 +201,8 @@ typename Map<Key, T>::Iterator Map<Key, T>::begin()
 template <class Key, class T>
 typename Map<Key, T>::ConstIterator Map<Key, T>::begin() const
 {
-  return d->map.begin();
+  const MapPrivate<Key, T> *data = d;
+  return data->map.begin();
 }
 
 template <class Key, class T>
@@ -88,17 +215,38 @@ typename Map<Key, T>::Iterator Map<Key, T>::end()
 template <class Key, class T>
 typename Map<Key, T>::ConstIterator Map<Key, T>::end() const
 {
-  return d->map.end();
+  const MapPrivate<Key, T> *data = d;
+  return data->map.end();
 }
 
 template <class Key, class T>
 Map<Key, T> &Map<Key, T>::insert(const Key &key, const T &value)
 {
   detach();
-  d->map[key] = value;
+  typename MapPrivate<Key, T>::Container::iterator it = d->lowerBound(key);
+  if(it == d->map.end() || key < it->first)
+    d->insert(it, typename MapPrivate<Key, T>::Container::value_type(key, value));
+  else
+    it->second = value;
   return *this;
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+template <class Key, class T>
+Map<Key, T> &Map<Key, T>::insert(const Key &key, T &&value)
+{
+  detach();
+  typename MapPrivate<Key, T>::Container::iterator it = d->lowerBound(key);
+  if(it == d->map.end() || key < it->first)
+    d->insert(it, typename MapPrivate<Key, T>::Container::value_type(key, std::move(value)));
+  else
+    it->second = std::move(value);
+  return *this;
+}
+
+#endif
+
 template <class Key, class T>
 Map<Key, T> &Map<Key, T>::clear()
 {
@@ -117,26 +265,27 @@ template <class Key, class T>
 typename Map<Key, T>::Iterator Map<Key, T>::find(const Key &key)
 {
   detach();
-  return d->map.find(key);
+  return d->find(key);
 }
 
 template <class Key, class T>
 typename Map<Key,T>::ConstIterator Map<Key, T>::find(const Key &key) const
 {
-  return d->map.find(key);
+  const MapPrivate<Key, T> *data = d;
+  return data->find(key);
 }
 
 template <class Key, class T>
 bool Map<Key, T>::contains(const Key &key) const
 {
-  return d->map.find(key) != d->map.end();
+  return d->find(key) != d->map.end();
 }
 
 template <class Key, class T>
 Map<Key, T> &Map<Key,T>::erase(Iterator it)
 {
   detach();
-  d->map.erase(it);
+  d->erase(it);
   return *this;
 }
 
@@ -144,9 +293,9 @@ template <class Key, class T>
 Map<Key, T> &Map<Key,T>::erase(const Key &key)
 {
   detach();
-  Iterator it = d->map.find(key);
+  typename MapPrivate<Key, T>::Container::iterator it = d->find(key);
   if(it != d->map.end())
-    d->map.erase(it);
+    d->erase(it);
   return *this;
 }
 
@@ -159,14 +308,19 @@ TagLib::uint Map<Key, T>::size() const
 template <class Key, class T>
 const T &Map<Key, T>::operator[](const Key &key) const
 {
-  return d->map[key];
+  typename MapPrivate<Key, T>::Container::const_iterator it = d->find(key);
+  if(it != d->map.end())
+    return it->second;
+
+  static const T empty = T();
+  return empty;
 }
 
 template <class Key, class T>
 T &Map<Key, T>::operator[](const Key &key)
 {
   detach();
-  return d->map[key];
+  return d->value(key);
 }
 
 template <class Key, class T>
@@ -182,6 +336,17 @@ Map<Key, T> &Map<Key, T>::operator=(const Map<Key, T> &m)
   return *this;
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+template <class Key, class T>
+Map<Key, T> &Map<Key, T>::operator=(Map<Key, T> &&m)
+{
+  std::swap(d, m.d);
+  return *this;
+}
+
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // protected members
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,320 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "tmmapstream.h"
+#include "tstring.h"
+#include "tdebug.h"
+
+#ifdef _WIN32
+# include <windows.h>
+#elif defined(HAVE_MMAP)
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/mman.h>
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+using namespace TagLib;
+
+namespace
+{
+  const TagLib::uint MMapBufferSize = 64 * 1024;
+
+#ifdef _WIN32
+
+  typedef FileName FileNameHandle;
+
+  // Maps the whole file and returns the address of the view, or a null pointer
+  // if the file could not be opened or mapped.  Empty files can not be mapped
+  // on Windows, so they are reported as open with a zero length.
+
+  const char *mapFile(const FileName &path, size_t &size, bool &opened)
+  {
+    HANDLE file;
+    if(!path.wstr().empty())
+      file = CreateFileW(path.wstr().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+    else if(!path.str().empty())
+      file = CreateFileA(path.str().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+    else
+      file = INVALID_HANDLE_VALUE;
+
+    if(file == INVALID_HANDLE_VALUE)
+      return 0;
+
+    const char *data = 0;
+
+    LARGE_INTEGER fileSize;
+    if(GetFileSizeEx(file, &fileSize)) {
+      size = static_cast<size_t>(fileSize.QuadPart);
+      opened = true;
+
+      if(size > 0) {
+        HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(mapping != NULL) {
+          data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+          CloseHandle(mapping);
+        }
+        opened = (data != 0);
+      }
+    }
+
+    CloseHandle(file);
+    return data;
+  }
+
+  void unmapFile(const char *data, size_t)
+  {
+    UnmapViewOfFile(data);
+  }
+
+#else
+
+  struct FileNameHandle : public std::string
+  {
+    FileNameHandle(FileName name) : std::string(name) {}
+    operator FileName () const { return c_str(); }
+  };
+
+# ifdef HAVE_MMAP
+
+  const char *mapFile(const FileName &path, size_t &size, bool &opened)
+  {
+    const int fd = ::open(path, O_RDONLY);
+    if(fd == -1)
+      return 0;
+
+    const char *data = 0;
+
+    struct stat st;
+    if(::fstat(fd, &st) == 0) {
+      size = static_cast<size_t>(st.st_size);
+      opened = true;
+
+      if(size > 0) {
+        void *p = ::mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(p != MAP_FAILED)
+          data = static_cast<const char *>(p);
+        opened = (data != 0);
+      }
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+
+    ::close(fd);
+    return data;
+  }
+
+  void unmapFile(const char *data, size_t size)
+  {
+    ::munmap(const_cast<char *>(data), size);
+  }
+
+# else
+
+  const char *mapFile(const FileName &, size_t &, bool &)
+  {
+    debug("MMapStream -- Memory mapped files are not supported on this system.");
+    return 0;
+  }
+
+  void unmapFile(const char *, size_t)
+  {
+  }
+
+# endif
+
+#endif
+}
+
+class MMapStream::MMapStreamPrivate
+{
+public:
+  MMapStreamPrivate(const FileName &fileName)
+    : name(fileName)
+    , data(0)
+    , size(0)
+    , position(0)
+    , opened(false)
+  {
+  }
+
+  FileNameHandle name;
+  const char *data;
+  size_t size;
+  long position;
+  bool opened;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+MMapStream::MMapStream(FileName fileName)
+  : d(new MMapStreamPrivate(fileName))
+{
+  // Scanning a mapping costs no system calls, so use large blocks.
+
+  setBufferSize(MMapBufferSize);
+
+  d->data = mapFile(fileName, d->size, d->opened);
+
+  if(!d->opened) {
+    d->size = 0;
+# ifdef _WIN32
+    debug("Could not map file " + fileName.toString());
+# else
+    debug("Could not map file " + String(static_cast<const char *>(d->name)));
+# endif
+  }
+}
+
+MMapStream::~MMapStream()
+{
+  if(d->data)
+    unmapFile(d->data, d->size);
+
+  delete d;
+}
+
+FileName MMapStream::name() const
+{
+  return d->name;
+}
+
+ByteVector MMapStream::readBlock(ulong length)
+{
+  if(!isOpen()) {
+    debug("MMapStream::readBlock() -- invalid file.");
+    return ByteVector::null;
+  }
+
+  if(length == 0 || d->position >= static_cast<long>(d->size))
+    return ByteVector::null;
+
+  const ulong available = static_cast<ulong>(d->size - d->position);
+  if(length > available)
+    length = available;
+
+  ByteVector buffer(d->data + d->position, static_cast<uint>(length));
+  d->position += length;
+
+  return buffer;
+}
+
+void MMapStream::writeBlock(const ByteVector &)
+{
+  debug("MMapStream::writeBlock() -- read only stream.");
+}
+
+void MMapStream::insert(const ByteVector &, ulong, ulong)
+{
+  debug("MMapStream::insert() -- read only stream.");
+}
+
+void MMapStream::removeBlock(ulong, ulong)
+{
+  debug("MMapStream::removeBlock() -- read only stream.");
+}
+
+bool MMapStream::readOnly() const
+{
+  return true;
+}
+
+bool MMapStream::isOpen() const
+{
+  return d->opened;
+}
+
+void MMapStream::seek(long offset, Position p)
+{
+  if(!isOpen()) {
+    debug("MMapStream::seek() -- invalid file.");
+    return;
+  }
+
+  long position;
+  switch(p) {
+  case Beginning:
+    position = offset;
+    break;
+  case Current:
+    position = d->position + offset;
+    break;
+  case End:
+    position = static_cast<long>(d->size) + offset;
+    break;
+  default:
+    debug("MMapStream::seek() -- Invalid Position value.");
+    return;
+  }
+
+  // Like fseek(), seeking before the beginning of the file fails and leaves
+  // the position unchanged.
+
+  if(position < 0)
+    return;
+
+  d->position = position;
+}
+
+long MMapStream::tell() const
+{
+  return d->position;
+}
+
+long MMapStream::length()
+{
+  return static_cast<long>(d->size);
+}
+
+void MMapStream::truncate(long)
+{
+  debug("MMapStream::truncate() -- read only stream.");
+}
+
+void MMapStream::setAccessHints(int hints)
+{
+  IOStream::setAccessHints(hints);
+
+#if !defined(_WIN32) && defined(HAVE_MMAP)
+
+  if(!d->data || d->size == 0)
+    return;
+
+  int advice = MADV_NORMAL;
+  if(hints & SequentialAccess)
+    advice = MADV_SEQUENTIAL;
+  else if(hints & RandomAccess)
+    advice = MADV_RANDOM;
+
+  ::madvise(const_cast<char *>(d->data), d->size, advice);
+
+#endif
+}
@@ -0,0 +1,136 @@
+/***************************************************************************
+    copyright            : (C) 2013 by TagLib developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_MMAPSTREAM_H
+#define TAGLIB_MMAPSTREAM_H
+
+#include "taglib_export.h"
+#include "taglib.h"
+#include "tbytevector.h"
+#include "tiostream.h"
+
+namespace TagLib {
+
+  //! A read only stream that serves its data from a memory mapped file.
+
+  /*!
+   * This maps the whole file into the address space of the process once and
+   * serves readBlock(), seek() and tell() without any further system calls.
+   * This is useful for scanning large numbers of files where only the tags
+   * and audio properties are read.
+   *
+   * The stream is always read only.  All methods that would modify the file
+   * fail and print a debug message.
+   *
+   * \see FileStream
+   */
+
+  class TAGLIB_EXPORT MMapStream : public IOStream
+  {
+  public:
+    /*!
+     * Opens and maps \a file.  \a file should be a C-string in the local file
+     * system encoding.
+     */
+    MMapStream(FileName file);
+
+    /*!
+     * Unmaps and closes the file.
+     */
+    virtual ~MMapStream();
+
+    /*!
+     * Returns the file name in the local file system encoding.
+     */
+    FileName name() const;
+
+    /*!
+     * Reads a block of size \a length at the current get pointer.
+     */
+    ByteVector readBlock(ulong length);
+
+    /*!
+     * Does nothing since the stream is read only.
+     */
+    void writeBlock(const ByteVector &data);
+
+    /*!
+     * Does nothing since the stream is read only.
+     */
+    void insert(const ByteVector &data, ulong start = 0, ulong replace = 0);
+
+    /*!
+     * Does nothing since the stream is read only.
+     */
+    void removeBlock(ulong start = 0, ulong length = 0);
+
+    /*!
+     * Always returns true.
+     */
+    bool readOnly() const;
+
+    /*!
+     * Returns true if the file has been opened and mapped successfully.
+     */
+    bool isOpen() const;
+
+    /*!
+     * Move the I/O pointer to \a offset in the file from position \a p.  This
+     * defaults to seeking from the beginning of the file.
+     *
+     * \see Position
+     */
+    void seek(long offset, Position p = Beginning);
+
+    /*!
+     * Returns the current offset within the file.
+     */
+    long tell() const;
+
+    /*!
+     * Returns the length of the file.
+     */
+    long length();
+
+    /*!
+     * Does nothing since the stream is read only.
+     */
+    void truncate(long length);
+
+    /*!
+     * Sets the access hints of the stream to \a hints.  Where available they
+     * are passed to madvise() for the mapping.
+     *
+     * \see IOStream::setAccessHints()
+     */
+    void setAccessHints(int hints);
+
+  private:
+    class MMapStreamPrivate;
+    MMapStreamPrivate *d;
+  };
+
+}
+
+#endif
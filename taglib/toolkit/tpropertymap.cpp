@@ -31,6 +31,29 @@ PropertyMap::PropertyMap(const PropertyMap &m) : SimplePropertyMap(m), unsupport
 {
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+PropertyMap::PropertyMap(PropertyMap &&m) :
+  SimplePropertyMap(std::move(m)), unsupported(std::move(m.unsupported))
+{
+}
+
+PropertyMap &PropertyMap::operator=(const PropertyMap &m)
+{
+  SimplePropertyMap::operator=(m);
+  unsupported = m.unsupported;
+  return *this;
+}
+
+PropertyMap &PropertyMap::operator=(PropertyMap &&m)
+{
+  SimplePropertyMap::operator=(std::move(m));
+  unsupported = std::move(m.unsupported);
+  return *this;
+}
+
+#endif
+
 PropertyMap::PropertyMap(const SimplePropertyMap &m)
 {
   for(SimplePropertyMap::ConstIterator it = m.begin(); it != m.end(); ++it){
@@ -53,10 +76,25 @@ bool PropertyMap::insert(const String &key, const StringList &values)
   if(result == end())
     SimplePropertyMap::insert(realKey, values);
   else
-    SimplePropertyMap::operator[](realKey).append(values);
+    result->second.append(values);
   return true;
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+bool PropertyMap::insert(const String &key, StringList &&values)
+{
+  String realKey = key.upper();
+  Iterator result = SimplePropertyMap::find(realKey);
+  if(result == end())
+    SimplePropertyMap::insert(realKey, std::move(values));
+  else
+    result->second.append(values);
+  return true;
+}
+
+#endif
+
 bool PropertyMap::replace(const String &key, const StringList &values)
 {
   String realKey = key.upper();
@@ -65,6 +103,18 @@ bool PropertyMap::replace(const String &key, const StringList &values)
   return true;
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+bool PropertyMap::replace(const String &key, StringList &&values)
+{
+  String realKey = key.upper();
+  SimplePropertyMap::erase(realKey);
+  SimplePropertyMap::insert(realKey, std::move(values));
+  return true;
+}
+
+#endif
+
 PropertyMap::Iterator PropertyMap::find(const String &key)
 {
   return SimplePropertyMap::find(key.upper());
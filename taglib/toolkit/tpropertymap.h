@@ -112,6 +112,14 @@ namespace TagLib {
 
     PropertyMap(const PropertyMap &m);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    PropertyMap(PropertyMap &&m);
+
+    PropertyMap &operator=(const PropertyMap &m);
+
+    PropertyMap &operator=(PropertyMap &&m);
+#endif
+
     /*!
      * Creates a PropertyMap initialized from a SimplePropertyMap. Copies all
      * entries from \a m that have valid keys.
@@ -129,6 +137,14 @@ namespace TagLib {
      */
     bool insert(const String &key, const StringList &values);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Same as above, but moves \a values into the map if \a key does not
+     * exist yet.
+     */
+    bool insert(const String &key, StringList &&values);
+#endif
+
     /*!
      * Replaces any existing values for \a key with the given \a values,
      * and simply insert them if \a key did not exist before.
@@ -137,6 +153,13 @@ namespace TagLib {
      */
     bool replace(const String &key, const StringList &values);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Same as above, but moves \a values into the map.
+     */
+    bool replace(const String &key, StringList &&values);
+#endif
+
     /*!
      * Find the first occurrence of \a key.
      */
@@ -23,8 +23,6 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
-// This class assumes that std::basic_string<T> has a contiguous and null-terminated buffer.
-
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
@@ -32,182 +30,608 @@
 #include "tstring.h"
 #include "tdebug.h"
 #include "tstringlist.h"
-#include "trefcounter.h"
 #include "tutils.h"
 
 #include <iostream>
+#include <algorithm>
+#include <new>
 #include <cstdio>
 #include <cstring>
 
-#ifdef HAVE_STD_CODECVT
-# include <codecvt>
-#else
-# include "unicode.h"
+#if defined(HAVE_SSE2)
+# include <emmintrin.h>
 #endif
 
-namespace 
+namespace
 {
+  using namespace TagLib;
 
-  inline unsigned short combine(unsigned char c1, unsigned char c2)
+  inline bool isLowerCase(wchar c)
   {
-    return (c1 << 8) | c2;
+    return c >= 'a' && c <= 'z';
   }
 
-  void UTF16toUTF8(const wchar_t *src, size_t srcLength, char *dst, size_t dstLength)
+  // The transcoders below work on whole runs of ASCII characters at once,
+  // which covers most of the text found in tags, and fall back to decoding
+  // one character at a time only where it is needed.  The SSE2 versions
+  // handle both a 2 and a 4 byte wchar_t.
+
+  const uint ReplacementCharacter = 0xfffd;
+
+  /*!
+   * Returns the number of leading bytes of \a s which are neither null nor
+   * greater than 0x7f.
+   */
+  size_t asciiLength(const char *s, size_t length)
   {
-#ifdef HAVE_STD_CODECVT
+    size_t i = 0;
+
+#if defined(HAVE_SSE2)
+
+    const __m128i zero = _mm_setzero_si128();
+    for(; i + 16 <= length; i += 16) {
+      const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+      if(_mm_movemask_epi8(_mm_or_si128(x, _mm_cmpeq_epi8(x, zero))) != 0)
+        break;
+    }
 
-    typedef std::codecvt_utf8_utf16<wchar_t> utf8_utf16_t;
+#endif
 
-    using namespace TagLib;
+    while(i < length && static_cast<signed char>(s[i]) > 0)
+      ++i;
 
-    const wchar_t *srcBegin = src;
-    const wchar_t *srcEnd   = srcBegin + srcLength;
+    return i;
+  }
 
-    char *dstBegin = dst;
-    char *dstEnd   = dstBegin + dstLength;
+  /*!
+   * Returns the number of leading characters of \a s which are less than 0x80.
+   */
+  size_t asciiLength(const wchar *s, size_t length)
+  {
+    size_t i = 0;
 
-    std::mbstate_t st;
-    const wchar_t *source;
-    char *target;
-    memset(&st, 0, sizeof(st));
-    std::codecvt_base::result result = utf8_utf16_t().out(
-      st, srcBegin, srcEnd, source, dstBegin, dstEnd, target);
+#if defined(HAVE_SSE2)
 
-    if(result != utf8_utf16_t::ok) {
-      debug("String::copyFromUTF8() - Unicode conversion error.");
+    if(sizeof(wchar) == 2 || sizeof(wchar) == 4) {
+      const size_t step = 16 / sizeof(wchar);
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i high = (sizeof(wchar) == 2)
+        ? _mm_set1_epi16(static_cast<short>(0xff80))
+        : _mm_set1_epi32(static_cast<int>(0xffffff80));
+
+      for(; i + step <= length; i += step) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(x, high), zero)) != 0xffff)
+          break;
+      }
     }
 
-#else
+#endif
 
-    using namespace Unicode;
-    using namespace TagLib;
+    while(i < length && static_cast<uint>(s[i]) < 0x80)
+      ++i;
 
-    const Unicode::UTF16 *srcBegin = src;
-    const Unicode::UTF16 *srcEnd   = srcBegin + srcLength;
+    return i;
+  }
+
+  void widenLatin1(const char *s, size_t length, wchar *target)
+  {
+    size_t i = 0;
+
+#if defined(HAVE_SSE2)
+
+    if(sizeof(wchar) == 2 || sizeof(wchar) == 4) {
+      const __m128i zero = _mm_setzero_si128();
+      for(; i + 16 <= length; i += 16) {
+        const __m128i x  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        const __m128i lo = _mm_unpacklo_epi8(x, zero);
+        const __m128i hi = _mm_unpackhi_epi8(x, zero);
+
+        __m128i *p = reinterpret_cast<__m128i *>(target + i);
+        if(sizeof(wchar) == 2) {
+          _mm_storeu_si128(p,     lo);
+          _mm_storeu_si128(p + 1, hi);
+        }
+        else {
+          _mm_storeu_si128(p,     _mm_unpacklo_epi16(lo, zero));
+          _mm_storeu_si128(p + 1, _mm_unpackhi_epi16(lo, zero));
+          _mm_storeu_si128(p + 2, _mm_unpacklo_epi16(hi, zero));
+          _mm_storeu_si128(p + 3, _mm_unpackhi_epi16(hi, zero));
+        }
+      }
+    }
+
+#endif
+
+    for(; i < length; ++i)
+      target[i] = static_cast<uchar>(s[i]);
+  }
 
-    Unicode::UTF8 *dstBegin = reinterpret_cast<Unicode::UTF8*>(dst);
-    Unicode::UTF8 *dstEnd   = dstBegin + dstLength;
+  /*!
+   * Keeps the low byte of each character, as a static_cast<char> does.
+   */
+  void narrowToLatin1(const wchar *s, size_t length, char *target)
+  {
+    size_t i = 0;
+
+#if defined(HAVE_SSE2)
+
+    if(sizeof(wchar) == 2 || sizeof(wchar) == 4) {
+      const __m128i lowByte = (sizeof(wchar) == 2) ? _mm_set1_epi16(0xff) : _mm_set1_epi32(0xff);
+      for(; i + 16 <= length; i += 16) {
+        const __m128i *p = reinterpret_cast<const __m128i *>(s + i);
+
+        __m128i lo, hi;
+        if(sizeof(wchar) == 2) {
+          lo = _mm_and_si128(_mm_loadu_si128(p),     lowByte);
+          hi = _mm_and_si128(_mm_loadu_si128(p + 1), lowByte);
+        }
+        else {
+          lo = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128(p),     lowByte),
+                               _mm_and_si128(_mm_loadu_si128(p + 1), lowByte));
+          hi = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128(p + 2), lowByte),
+                               _mm_and_si128(_mm_loadu_si128(p + 3), lowByte));
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(target + i), _mm_packus_epi16(lo, hi));
+      }
+    }
 
-    Unicode::ConversionResult result = Unicode::ConvertUTF16toUTF8(
-      &srcBegin, srcEnd, &dstBegin, dstEnd, Unicode::lenientConversion);
+#endif
+
+    for(; i < length; ++i)
+      target[i] = static_cast<char>(s[i]);
+  }
 
-    if(result != Unicode::conversionOK) {
-      debug("String::to8Bit() - Unicode conversion error.");
+  /*!
+   * Reads \a length UTF-16 characters from \a s, swapping the bytes of each
+   * of them if \a swap is true.  \a s need not be aligned.
+   */
+  void readUTF16(const char *s, size_t length, wchar *target, bool swap)
+  {
+    size_t i = 0;
+
+#if defined(HAVE_SSE2)
+
+    if(sizeof(wchar) == 2 || sizeof(wchar) == 4) {
+      const __m128i zero = _mm_setzero_si128();
+      for(; i + 8 <= length; i += 8) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i * 2));
+        if(swap)
+          x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+
+        __m128i *p = reinterpret_cast<__m128i *>(target + i);
+        if(sizeof(wchar) == 2) {
+          _mm_storeu_si128(p, x);
+        }
+        else {
+          _mm_storeu_si128(p,     _mm_unpacklo_epi16(x, zero));
+          _mm_storeu_si128(p + 1, _mm_unpackhi_epi16(x, zero));
+        }
+      }
     }
 
 #endif
+
+    for(; i < length; ++i) {
+      ushort c;
+      ::memcpy(&c, s + i * 2, 2);
+      target[i] = swap ? byteSwap(c) : c;
+    }
   }
 
-  void UTF8toUTF16(const char *src, size_t srcLength, wchar_t *dst, size_t dstLength)
+  /*!
+   * The reverse of readUTF16().  Only the low 16 bits of each character are
+   * written.
+   */
+  void writeUTF16(const wchar *s, size_t length, char *target, bool swap)
   {
-#ifdef HAVE_STD_CODECVT
+    size_t i = 0;
 
-    typedef std::codecvt_utf8_utf16<wchar_t> utf8_utf16_t;
+#if defined(HAVE_SSE2)
 
-    using namespace TagLib;
+    if(sizeof(wchar) == 2 || sizeof(wchar) == 4) {
+      for(; i + 8 <= length; i += 8) {
+        const __m128i *p = reinterpret_cast<const __m128i *>(s + i);
 
-    const char *srcBegin = src;
-    const char *srcEnd   = srcBegin + srcLength;
+        __m128i x;
+        if(sizeof(wchar) == 2) {
+          x = _mm_loadu_si128(p);
+        }
+        else {
+          // Sign extend the low halves so that the saturating pack keeps them.
 
-    wchar_t *dstBegin = dst;
-    wchar_t *dstEnd   = dstBegin + dstLength;
+          const __m128i lo = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128(p),     16), 16);
+          const __m128i hi = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128(p + 1), 16), 16);
+          x = _mm_packs_epi32(lo, hi);
+        }
 
-    std::mbstate_t st;
-    const char *source;
-    wchar_t *target;
-    memset(&st, 0, sizeof(st));
-    std::codecvt_base::result result = utf8_utf16_t().in(
-      st, srcBegin, srcEnd, source, dstBegin, dstEnd, target);
+        if(swap)
+          x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
 
-    if(result != utf8_utf16_t::ok) {
-      debug("String::copyFromUTF8() - Unicode conversion error.");
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(target + i * 2), x);
+      }
     }
 
-#else
+#endif
+
+    for(; i < length; ++i) {
+      ushort c = static_cast<ushort>(s[i]);
+      if(swap)
+        c = byteSwap(c);
+      ::memcpy(target + i * 2, &c, 2);
+    }
+  }
+
+  /*!
+   * Returns the code point starting at \a s[i] and moves \a i past it.  A
+   * surrogate without its counterpart gives U+FFFD.  A 4 byte wchar_t may
+   * hold a code point above U+FFFF by itself.
+   */
+  uint nextCodePoint(const wchar *s, size_t length, size_t &i)
+  {
+    const uint c = static_cast<uint>(s[i++]);
+
+    if(c >= 0xd800 && c <= 0xdbff && i < length) {
+      const uint c2 = static_cast<uint>(s[i]);
+      if(c2 >= 0xdc00 && c2 <= 0xdfff) {
+        ++i;
+        return 0x10000 + ((c - 0xd800) << 10) + (c2 - 0xdc00);
+      }
+    }
 
-    using namespace Unicode;
-    using namespace TagLib;
+    if((c >= 0xd800 && c <= 0xdfff) || c > 0x10ffff)
+      return ReplacementCharacter;
 
-    const Unicode::UTF8 *srcBegin = reinterpret_cast<const Unicode::UTF8*>(src);
-    const Unicode::UTF8 *srcEnd   = srcBegin + srcLength;
+    return c;
+  }
+
+  inline size_t utf8Length(uint c)
+  {
+    if(c < 0x80)
+      return 1;
+    else if(c < 0x800)
+      return 2;
+    else if(c < 0x10000)
+      return 3;
+    else
+      return 4;
+  }
+
+  /*!
+   * Returns the exact number of bytes UTF16toUTF8() writes for \a s.
+   */
+  size_t UTF8Length(const wchar *s, size_t length)
+  {
+    size_t i = 0;
+    size_t n = 0;
 
-    Unicode::UTF16 *dstBegin = dst;
-    Unicode::UTF16 *dstEnd   = dstBegin + dstLength;
+    while(true) {
+      const size_t run = asciiLength(s + i, length - i);
+      i += run;
+      n += run;
 
-    Unicode::ConversionResult result = Unicode::ConvertUTF8toUTF16(
-      &srcBegin, srcEnd, &dstBegin, dstEnd, Unicode::lenientConversion);
+      if(i == length)
+        break;
 
-    if(result != Unicode::conversionOK) {
-      debug("String::copyFromUTF8() - Unicode conversion error.");
+      n += utf8Length(nextCodePoint(s, length, i));
     }
 
-#endif 
+    return n;
+  }
+
+  void UTF16toUTF8(const wchar *s, size_t length, char *target)
+  {
+    size_t i = 0;
+    bool replaced = false;
+
+    while(true) {
+      const size_t run = asciiLength(s + i, length - i);
+      narrowToLatin1(s + i, run, target);
+      i += run;
+      target += run;
+
+      if(i == length)
+        break;
+
+      const uint c = nextCodePoint(s, length, i);
+      if(c == ReplacementCharacter)
+        replaced = true;
+
+      if(c < 0x800) {
+        *target++ = static_cast<char>(0xc0 | (c >> 6));
+      }
+      else if(c < 0x10000) {
+        *target++ = static_cast<char>(0xe0 | (c >> 12));
+        *target++ = static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+      }
+      else {
+        *target++ = static_cast<char>(0xf0 | (c >> 18));
+        *target++ = static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+        *target++ = static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+      }
+      *target++ = static_cast<char>(0x80 | (c & 0x3f));
+    }
+
+    if(replaced)
+      debug("String::to8Bit() - Unpaired surrogate replaced with U+FFFD.");
+  }
+
+  /*!
+   * Returns the length of the valid UTF-8 sequence at the beginning of \a s
+   * and stores its code point in \a c, or returns 0 if the sequence is
+   * malformed, overlong, truncated or encodes a surrogate.
+   */
+  size_t decodeUTF8Sequence(const uchar *s, size_t length, uint &c)
+  {
+    size_t n;
+    if(s[0] >= 0xc2 && s[0] <= 0xdf) {
+      n = 2;
+      c = s[0] & 0x1f;
+    }
+    else if(s[0] >= 0xe0 && s[0] <= 0xef) {
+      n = 3;
+      c = s[0] & 0x0f;
+    }
+    else if(s[0] >= 0xf0 && s[0] <= 0xf4) {
+      n = 4;
+      c = s[0] & 0x07;
+    }
+    else
+      return 0;
+
+    if(n > length)
+      return 0;
+
+    for(size_t i = 1; i < n; ++i) {
+      if((s[i] & 0xc0) != 0x80)
+        return 0;
+      c = (c << 6) | (s[i] & 0x3f);
+    }
+
+    if(n == 3 && (c < 0x800 || (c >= 0xd800 && c <= 0xdfff)))
+      return 0;
+    if(n == 4 && (c < 0x10000 || c > 0x10ffff))
+      return 0;
+
+    return n;
+  }
+
+  /*!
+   * Decodes \a s into \a target, which must have room for \a length
+   * characters, and returns the number of characters written.  As before,
+   * the string ends at a null byte, and at the first malformed sequence.
+   * \a bytesRead is set to the number of bytes decoded.
+   */
+  size_t UTF8toUTF16(const char *s, size_t length, wchar *target, size_t &bytesRead)
+  {
+    const uchar *source = reinterpret_cast<const uchar *>(s);
+
+    size_t i = 0;
+    size_t n = 0;
+
+    while(true) {
+      const size_t run = asciiLength(s + i, length - i);
+      widenLatin1(s + i, run, target + n);
+      i += run;
+      n += run;
+
+      if(i == length || source[i] == 0)
+        break;
+
+      uint c;
+      const size_t sequenceLength = decodeUTF8Sequence(source + i, length - i, c);
+      if(sequenceLength == 0) {
+        debug("String::copyFromUTF8() - Unicode conversion error.");
+        break;
+      }
+
+      i += sequenceLength;
+
+      if(c >= 0x10000) {
+        c -= 0x10000;
+        target[n++] = static_cast<wchar>(0xd800 + (c >> 10));
+        target[n++] = static_cast<wchar>(0xdc00 + (c & 0x3ff));
+      }
+      else {
+        target[n++] = static_cast<wchar>(c);
+      }
+    }
+
+    bytesRead = i;
+    return n;
   }
 }
 
 namespace TagLib {
 
-class String::StringPrivate : public RefCounter
+/*
+ * The reference count, the length, the 8-bit forms and the characters share
+ * a single allocation.  The characters follow the header directly and are
+ * always null-terminated.
+ */
+class String::StringPrivate
 {
 public:
-  StringPrivate() 
-    : RefCounter() 
+  static StringPrivate *create(size_t length)
   {
+    void *p = ::operator new(sizeof(StringPrivate) + (length + 1) * sizeof(wchar));
+    return new(p) StringPrivate(length);
   }
 
-  StringPrivate(const wstring &s) 
-    : RefCounter()
-    , data(s) 
+  static StringPrivate *create(const wchar *s, size_t length)
   {
+    StringPrivate *p = create(length);
+    ::memcpy(p->data(), s, length * sizeof(wchar));
+    return p;
   }
-  
-  StringPrivate(uint n, wchar_t c) 
-    : RefCounter()
-    , data(static_cast<size_t>(n), c) 
+
+  wchar *data()
   {
+    return reinterpret_cast<wchar *>(this + 1);
   }
 
   /*!
-   * Stores string in UTF-16. The byte order depends on the CPU endian. 
+   * Shortens the string to \a l characters, which must not exceed the
+   * capacity.
    */
-  TagLib::wstring data;
+  void setLength(size_t l)
+  {
+    length = l;
+    data()[l] = 0;
+    dropSource();
+  }
+
+  size_t eightBitLength(bool unicode)
+  {
+    return unicode ? UTF8Length(data(), length) : length;
+  }
+
+  void toEightBit(bool unicode, char *target)
+  {
+    if(unicode)
+      UTF16toUTF8(data(), length, target);
+    else
+      narrowToLatin1(data(), length, target);
+  }
 
   /*!
-   * This is only used to hold the the most recent value of toCString().
+   * Returns the source UTF-8 form of the string if \a unicode is true,
+   * otherwise the Latin-1 form, or null if it is not kept.
+   */
+  const std::string *sourceEightBit(bool unicode) const
+  {
+    if(exposed)
+      return 0;
+
+    return (unicode ? sourceIsUTF8 : sourceIsLatin1) ? &source : 0;
+  }
+
+  /*!
+   * Keeps \a s, the Latin-1 or UTF-8 the string has been decoded from.  Only
+   * called while the string is being constructed.
+   */
+  void keepSource(const char *s, size_t size, bool unicode)
+  {
+    source.assign(s, size);
+
+    // Both forms are the same if the string is all ASCII.
+
+    sourceIsLatin1 = !unicode || size == length;
+    sourceIsUTF8   = unicode || asciiLength(s, size) == size;
+  }
+
+  /*!
+   * Has to be called whenever the characters change.
+   */
+  void dropSource()
+  {
+    sourceIsLatin1 = false;
+    sourceIsUTF8   = false;
+  }
+
+  void ref()
+  {
+    ATOMIC_INC(refCount);
+  }
+
+  void deref()
+  {
+    if(ATOMIC_DEC(refCount) == 0) {
+      this->~StringPrivate();
+      ::operator delete(this);
+    }
+  }
+
+  bool isShared() const
+  {
+    return refCount > 1;
+  }
+
+  volatile ATOMIC_INT refCount;
+
+  /*!
+   * Stores the length of the string in UTF-16 code units.  The byte order
+   * depends on the CPU endian.
+   */
+  size_t length;
+  const size_t capacity;
+
+  /*!
+   * Holds the Latin-1 or UTF-8 the string has been decoded from, or both if
+   * they are the same, as marked by the flags below, so that encoding it
+   * back needs no conversion.  It is written only while the string is being
+   * constructed, so copies of the string may read it from several threads.
+   */
+  std::string source;
+  bool sourceIsLatin1;
+  bool sourceIsUTF8;
+
+  /*!
+   * Holds the value of toCString() if it is not the same as the above.
    */
   std::string cstring;
+
+  /*!
+   * Set once a non-const iterator or reference to the characters has been
+   * handed out.  The characters may then change at any time without notice,
+   * so the source is never used again.
+   */
+  bool exposed;
+
+private:
+  StringPrivate(size_t l) :
+    refCount(1),
+    length(l),
+    capacity(l),
+    sourceIsLatin1(false),
+    sourceIsUTF8(false),
+    exposed(false)
+  {
+    data()[l] = 0;
+  }
 };
 
-String String::null;
+String String::null(StringPrivate::create(0));
 
 ////////////////////////////////////////////////////////////////////////////////
 
-String::String() 
-  : d(new StringPrivate())
+String::String()
+  : d(0)
+{
+}
+
+String::String(const String &s)
+  : d(s.d)
 {
+  if(d)
+    d->ref();
 }
 
-String::String(const String &s) 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+String::String(String &&s)
   : d(s.d)
 {
-  d->ref();
+  s.d = 0;
 }
 
+#endif
+
 String::String(const std::string &s, Type t)
-  : d(new StringPrivate())
+  : d(0)
 {
   if(t == Latin1)
-    copyFromLatin1(&s[0], s.length());
+    copyFromLatin1(s.c_str(), s.length());
   else if(t == String::UTF8)
-    copyFromUTF8(&s[0], s.length());
+    copyFromUTF8(s.c_str(), s.length());
   else {
     debug("String::String() -- A std::string should not contain UTF16.");
   }
 }
 
 String::String(const wstring &s, Type t)
-  : d(new StringPrivate())
+  : d(0)
 {
   if(t == UTF16 || t == UTF16BE || t == UTF16LE)
     copyFromUTF16(s.c_str(), s.length(), t);
@@ -217,7 +641,7 @@ String::String(const wstring &s, Type t)
 }
 
 String::String(const wchar_t *s, Type t)
-  : d(new StringPrivate())
+  : d(0)
 {
   if(t == UTF16 || t == UTF16BE || t == UTF16LE)
     copyFromUTF16(s, ::wcslen(s), t);
@@ -227,7 +651,7 @@ String::String(const wchar_t *s, Type t)
 }
 
 String::String(const char *s, Type t)
-  : d(new StringPrivate())
+  : d(0)
 {
   if(t == Latin1)
     copyFromLatin1(s, ::strlen(s));
@@ -239,7 +663,7 @@ String::String(const char *s, Type t)
 }
 
 String::String(wchar_t c, Type t)
-  : d(new StringPrivate())
+  : d(0)
 {
   if(t == UTF16 || t == UTF16BE || t == UTF16LE)
     copyFromUTF16(&c, 1, t);
@@ -249,24 +673,40 @@ String::String(wchar_t c, Type t)
 }
 
 String::String(char c, Type t)
-  : d(new StringPrivate(1, static_cast<uchar>(c)))
+  : d(StringPrivate::create(1))
 {
+  d->data()[0] = static_cast<uchar>(c);
+
   if(t != Latin1 && t != UTF8) {
     debug("String::String() -- A char should not contain UTF16.");
   }
 }
 
 String::String(const ByteVector &v, Type t)
-  : d(new StringPrivate())
+  : d(0)
 {
   if(v.isEmpty())
     return;
 
-  if(t == Latin1) 
+  if(t == Latin1)
     copyFromLatin1(v.data(), v.size());
-  else if(t == UTF8) 
+  else if(t == UTF8)
     copyFromUTF8(v.data(), v.size());
-  else 
+  else
+    copyFromUTF16(v.data(), v.size(), t);
+}
+
+String::String(const ByteVectorView &v, Type t)
+  : d(0)
+{
+  if(v.isEmpty())
+    return;
+
+  if(t == Latin1)
+    copyFromLatin1(v.data(), v.size());
+  else if(t == UTF8)
+    copyFromUTF8(v.data(), v.size());
+  else
     copyFromUTF16(v.data(), v.size(), t);
 }
 
@@ -274,77 +714,99 @@ String::String(const ByteVector &v, Type t)
 
 String::~String()
 {
-  if(d->deref())
-    delete d;
+  if(d)
+    d->deref();
 }
 
 std::string String::to8Bit(bool unicode) const
 {
-  std::string s;
+  if(isEmpty())
+    return std::string();
 
-  if(!unicode) {
-    s.resize(d->data.size());
+  const std::string *source = d->sourceEightBit(unicode);
+  if(source)
+    return *source;
 
-    std::string::iterator targetIt = s.begin();
-    for(wstring::const_iterator it = d->data.begin(); it != d->data.end(); it++) {
-      *targetIt = static_cast<char>(*it);
-      ++targetIt;
-    }
-  }
-  else {
-    s.resize(d->data.size() * 4 + 1);
-
-    UTF16toUTF8(&d->data[0], d->data.size(), &s[0], s.size());
-    s.resize(::strlen(s.c_str()));
-  }
+  std::string s(d->eightBitLength(unicode), '\0');
+  d->toEightBit(unicode, &s[0]);
 
   return s;
 }
 
 TagLib::wstring String::toWString() const
 {
-  return d->data;
+  return wstring(begin(), end());
 }
 
 const char *String::toCString(bool unicode) const
 {
+  if(!d)
+    return "";
+
+  const std::string *source = d->sourceEightBit(unicode);
+  if(source)
+    return source->c_str();
+
   d->cstring = to8Bit(unicode);
   return d->cstring.c_str();
 }
 
 const wchar_t *String::toCWString() const
 {
-  return d->data.c_str();
+  return d ? d->data() : L"";
 }
 
 String::Iterator String::begin()
 {
-  return d->data.begin();
+  detach();
+  return d ? d->data() : 0;
 }
 
 String::ConstIterator String::begin() const
 {
-  return d->data.begin();
+  return d ? d->data() : 0;
 }
 
 String::Iterator String::end()
 {
-  return d->data.end();
+  return begin() + size();
 }
 
 String::ConstIterator String::end() const
 {
-  return d->data.end();
+  return begin() + size();
 }
 
 int String::find(const String &s, int offset) const
 {
-  return d->data.find(s.d->data, offset);
+  if(offset < 0 || uint(offset) > size() || s.size() > size() - offset)
+    return -1;
+
+  const ConstIterator it = std::search(begin() + offset, end(), s.begin(), s.end());
+  if(it == end() && !s.isEmpty())
+    return -1;
+
+  return it - begin();
 }
 
 int String::rfind(const String &s, int offset) const
 {
-  return d->data.rfind(s.d->data, offset);
+  if(s.size() > size())
+    return -1;
+
+  // A negative offset searches from the end, as does std::wstring::npos.
+
+  size_t i = size() - s.size();
+  if(offset >= 0 && uint(offset) < i)
+    i = offset;
+
+  for(;;) {
+    if(std::equal(s.begin(), s.end(), begin() + i))
+      return i;
+    if(i == 0)
+      return -1;
+    --i;
+  }
 }
 
 StringList String::split(const String &separator) const
@@ -372,32 +834,57 @@ bool String::startsWith(const String &s) const
   if(s.length() > length())
     return false;
 
-  return substr(0, s.length()) == s;
+  return std::equal(s.begin(), s.end(), begin());
 }
 
 String String::substr(uint position, uint n) const
 {
-  return String(d->data.substr(position, n));
+  if(position >= size())
+    return String();
+
+  n = std::min<uint>(n, size() - position);
+
+  if(n == size())
+    return *this;
+
+  String s;
+  if(n > 0)
+    s.d = StringPrivate::create(begin() + position, n);
+  return s;
 }
 
 String &String::append(const String &s)
 {
-  detach();
-  d->data += s.d->data;
+  if(isEmpty())
+    *this = s;
+  else
+    appendData(s.begin(), s.size());
+
   return *this;
 }
 
 String String::upper() const
 {
-  String s;
+  static const int shift = 'A' - 'a';
 
-  static int shift = 'A' - 'a';
+  if(isEmpty())
+    return String();
 
-  for(wstring::const_iterator it = d->data.begin(); it != d->data.end(); ++it) {
-    if(*it >= 'a' && *it <= 'z')
-      s.d->data.push_back(*it + shift);
+  // Keys such as those of a PropertyMap are mostly upper case already, and
+  // are shared instead of copied then.
+
+  ConstIterator it = std::find_if(begin(), end(), isLowerCase);
+  if(it == end())
+    return *this;
+
+  String s(StringPrivate::create(size()));
+  wchar *target = std::copy(begin(), it, s.d->data());
+
+  for(; it != end(); ++it) {
+    if(isLowerCase(*it))
+      *target++ = *it + shift;
     else
-      s.d->data.push_back(*it);
+      *target++ = *it;
   }
 
   return s;
@@ -405,7 +892,7 @@ String String::upper() const
 
 TagLib::uint String::size() const
 {
-  return d->data.size();
+  return d ? d->length : 0;
 }
 
 TagLib::uint String::length() const
@@ -415,7 +902,7 @@ TagLib::uint String::length() const
 
 bool String::isEmpty() const
 {
-  return d->data.size() == 0;
+  return size() == 0;
 }
 
 bool String::isNull() const
@@ -429,20 +916,29 @@ ByteVector String::data(Type t) const
   {
   case Latin1:
     {
-      ByteVector v(size(), 0);
-      char *p = v.data();
+      if(isEmpty())
+        return ByteVector();
 
-      for(wstring::const_iterator it = d->data.begin(); it != d->data.end(); it++)
-        *p++ = static_cast<char>(*it);
+      const std::string *source = d->sourceEightBit(false);
+      if(source)
+        return ByteVector(source->data(), source->size());
+
+      ByteVector v(size(), 0);
+      d->toEightBit(false, v.data());
 
       return v;
     }
   case UTF8:
     {
-      ByteVector v(size() * 4 + 1, 0);
+      if(isEmpty())
+        return ByteVector();
 
-      UTF16toUTF8(&d->data[0], d->data.size(), v.data(), v.size());
-      v.resize(::strlen(v.data()));
+      const std::string *source = d->sourceEightBit(true);
+      if(source)
+        return ByteVector(source->data(), source->size());
+
+      ByteVector v(d->eightBitLength(true), 0);
+      d->toEightBit(true, v.data());
 
       return v;
     }
@@ -454,37 +950,31 @@ ByteVector String::data(Type t) const
       // Assume that if we're doing UTF16 and not UTF16BE that we want little
       // endian encoding.  (Byte Order Mark)
 
-      *p++ = '\xff';
-      *p++ = '\xfe';
+      p[0] = '\xff';
+      p[1] = '\xfe';
 
-      for(wstring::const_iterator it = d->data.begin(); it != d->data.end(); it++) {
-        *p++ = static_cast<char>(*it & 0xff);
-        *p++ = static_cast<char>(*it >> 8);
-      }
+      if(!isEmpty())
+        writeUTF16(d->data(), size(), p + 2, WCharByteOrder != UTF16LE);
 
       return v;
     }
   case UTF16BE:
     {
-      ByteVector v(size() * 2, 0);
-      char *p = v.data();
+      if(isEmpty())
+        return ByteVector();
 
-      for(wstring::const_iterator it = d->data.begin(); it != d->data.end(); it++) {
-        *p++ = static_cast<char>(*it >> 8);
-        *p++ = static_cast<char>(*it & 0xff);
-      }
+      ByteVector v(size() * 2, 0);
+      writeUTF16(d->data(), size(), v.data(), WCharByteOrder != UTF16BE);
 
       return v;
     }
   case UTF16LE:
     {
-      ByteVector v(size() * 2, 0);
-      char *p = v.data();
+      if(isEmpty())
+        return ByteVector();
 
-      for(wstring::const_iterator it = d->data.begin(); it != d->data.end(); it++) {
-        *p++ = static_cast<char>(*it & 0xff);
-        *p++ = static_cast<char>(*it >> 8);
-      }
+      ByteVector v(size() * 2, 0);
+      writeUTF16(d->data(), size(), v.data(), WCharByteOrder != UTF16LE);
 
       return v;
     }
@@ -505,13 +995,14 @@ int String::toInt(bool *ok) const
 {
   int value = 0;
 
-  uint size = d->data.size();
-  bool negative = size > 0 && d->data[0] == '-';
+  const uint size = this->size();
+  const ConstIterator data = begin();
+  bool negative = size > 0 && data[0] == '-';
   uint start = negative ? 1 : 0;
   uint i = start;
 
-  for(; i < size && d->data[i] >= '0' && d->data[i] <= '9'; i++)
-    value = value * 10 + (d->data[i] - '0');
+  for(; i < size && data[i] >= '0' && data[i] <= '9'; i++)
+    value = value * 10 + (data[i] - '0');
 
   if(negative)
     value = value * -1;
@@ -524,8 +1015,8 @@ int String::toInt(bool *ok) const
 
 String String::stripWhiteSpace() const
 {
-  wstring::const_iterator begin = d->data.begin();
-  wstring::const_iterator end = d->data.end();
+  ConstIterator begin = this->begin();
+  ConstIterator end = this->end();
 
   while(begin != end &&
         (*begin == '\t' || *begin == '\n' || *begin == '\f' ||
@@ -545,12 +1036,12 @@ String String::stripWhiteSpace() const
   } while(*end == '\t' || *end == '\n' ||
           *end == '\f' || *end == '\r' || *end == ' ');
 
-  return String(wstring(begin, end + 1));
+  return substr(begin - this->begin(), end + 1 - begin);
 }
 
 bool String::isLatin1() const
 {
-  for(wstring::const_iterator it = d->data.begin(); it != d->data.end(); it++) {
+  for(ConstIterator it = begin(); it != end(); it++) {
     if(*it >= 256)
       return false;
   }
@@ -559,7 +1050,7 @@ bool String::isLatin1() const
 
 bool String::isAscii() const
 {
-  for(wstring::const_iterator it = d->data.begin(); it != d->data.end(); it++) {
+  for(ConstIterator it = begin(); it != end(); it++) {
     if(*it >= 128)
       return false;
   }
@@ -597,17 +1088,17 @@ String String::number(int n) // static
 TagLib::wchar &String::operator[](int i)
 {
   detach();
-  return d->data[i];
+  return d->data()[i];
 }
 
 const TagLib::wchar &String::operator[](int i) const
 {
-  return d->data[i];
+  return toCWString()[i];
 }
 
 bool String::operator==(const String &s) const
 {
-  return d == s.d || d->data == s.d->data;
+  return d == s.d || (size() == s.size() && std::equal(begin(), end(), s.begin()));
 }
 
 bool String::operator!=(const String &s) const
@@ -617,42 +1108,30 @@ bool String::operator!=(const String &s) const
 
 String &String::operator+=(const String &s)
 {
-  detach();
-
-  d->data += s.d->data;
-  return *this;
+  return append(s);
 }
 
 String &String::operator+=(const wchar_t *s)
 {
-  detach();
-
-  d->data += s;
+  appendData(s, ::wcslen(s));
   return *this;
 }
 
 String &String::operator+=(const char *s)
 {
-  detach();
-
-  for(int i = 0; s[i] != 0; i++)
-    d->data += uchar(s[i]);
-  return *this;
+  return append(String(s));
 }
 
 String &String::operator+=(wchar_t c)
 {
-  detach();
-
-  d->data += c;
+  appendData(&c, 1);
   return *this;
 }
 
 String &String::operator+=(char c)
 {
-  detach();
-
-  d->data += uchar(c);
+  const wchar w = static_cast<uchar>(c);
+  appendData(&w, 1);
   return *this;
 }
 
@@ -661,87 +1140,87 @@ String &String::operator=(const String &s)
   if(&s == this)
     return *this;
 
-  if(d->deref())
-    delete d;
+  if(s.d)
+    s.d->ref();
+  if(d)
+    d->deref();
+
   d = s.d;
-  d->ref();
   return *this;
 }
 
-String &String::operator=(const std::string &s)
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+String &String::operator=(String &&s)
 {
-  if(d->deref())
-    delete d;
+  if(&s == this)
+    return *this;
+
+  if(d)
+    d->deref();
 
-  d = new StringPrivate;
-  copyFromLatin1(s.c_str(), s.length());
+  d = s.d;
+  s.d = 0;
+  return *this;
+}
 
+#endif
+
+String &String::operator=(const std::string &s)
+{
+  *this = String(s);
   return *this;
 }
 
 String &String::operator=(const wstring &s)
 {
-  if(d->deref())
-    delete d;
-  d = new StringPrivate(s);
+  *this = String(s);
   return *this;
 }
 
 String &String::operator=(const wchar_t *s)
 {
-  if(d->deref())
-    delete d;
-
-  d = new StringPrivate(s);
+  *this = String(s);
   return *this;
 }
 
 String &String::operator=(char c)
 {
-  if(d->deref())
-    delete d;
-
-  d = new StringPrivate(1, static_cast<uchar>(c));
+  *this = String(c);
   return *this;
 }
 
 String &String::operator=(wchar_t c)
 {
-  if(d->deref())
-    delete d;
-
-  d = new StringPrivate(1, c);
+  *this = String(StringPrivate::create(&c, 1));
   return *this;
 }
 
 String &String::operator=(const char *s)
 {
-  if(d->deref())
-    delete d;
-
-  d = new StringPrivate;
-  copyFromLatin1(s, ::strlen(s));
-
+  *this = String(s);
   return *this;
 }
 
 String &String::operator=(const ByteVector &v)
 {
-  if(d->deref())
-    delete d;
+  // If we hit a null in the ByteVector, the string ends there.
 
-  d = new StringPrivate;
-  copyFromLatin1(v.data(), v.size());
+  const int end = v.find('\0');
 
-  // If we hit a null in the ByteVector, shrink the string again.
-  d->data.resize(::wcslen(d->data.c_str()));
+  String s;
+  s.copyFromLatin1(v.data(), end >= 0 ? end : v.size());
+  *this = s;
 
   return *this;
 }
 
 bool String::operator<(const String &s) const
 {
-  return d->data < s.d->data;
+  if(d == s.d)
+    return false;
+
+  return std::lexicographical_compare(begin(), end(), s.begin(), s.end());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -750,9 +1229,17 @@ bool String::operator<(const String &s) const
 
 void String::detach()
 {
-  if(d->count() > 1) {
+  if(d && d->isShared()) {
+    StringPrivate *newData = StringPrivate::create(d->data(), d->length);
     d->deref();
-    d = new StringPrivate(d->data);
+    d = newData;
+  }
+
+  // Only called before handing out access to the characters.
+
+  if(d) {
+    d->dropSource();
+    d->exposed = true;
   }
 }
 
@@ -760,20 +1247,33 @@ void String::detach()
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
+String::String(StringPrivate *data)
+  : d(data)
+{
+}
+
 void String::copyFromLatin1(const char *s, size_t length)
 {
-  d->data.resize(length);
+  if(length == 0)
+    return;
 
-  for(size_t i = 0; i < length; ++i)
-    d->data[i] = static_cast<uchar>(s[i]);
+  d = StringPrivate::create(length);
+  widenLatin1(s, length, d->data());
+  d->keepSource(s, length, false);
 }
 
 void String::copyFromUTF8(const char *s, size_t length)
 {
-  d->data.resize(length);
+  if(length == 0)
+    return;
+
+  // A UTF-8 string never has more UTF-16 characters than bytes.
 
-  UTF8toUTF16(s, length, &d->data[0], d->data.size());
-  d->data.resize(::wcslen(d->data.c_str()));
+  d = StringPrivate::create(length);
+
+  size_t bytesRead;
+  d->setLength(UTF8toUTF16(s, length, d->data(), bytesRead));
+  d->keepSource(s, bytesRead, true);
 }
 
 void String::copyFromUTF16(const wchar_t *s, size_t length, Type t)
@@ -795,12 +1295,14 @@ void String::copyFromUTF16(const wchar_t *s, size_t length, Type t)
   else 
     swap = (t != WCharByteOrder);
 
-  d->data.resize(length);
-  memcpy(&d->data[0], s, length * sizeof(wchar_t));
+  if(length == 0)
+    return;
+
+  d = StringPrivate::create(s, length);
 
   if(swap) {
     for(size_t i = 0; i < length; ++i)
-      d->data[i] = byteSwap(static_cast<ushort>(s[i]));
+      d->data()[i] = byteSwap(static_cast<ushort>(s[i]));
   }
 }
 
@@ -832,11 +1334,41 @@ void String::copyFromUTF16(const char *s, size_t length, Type t)
   else 
     swap = (t != WCharByteOrder);
 
-  d->data.resize(length / 2);
-  for(size_t i = 0; i < length / 2; ++i) {
-    d->data[i] = swap ? combine(*s, *(s + 1)) : combine(*(s + 1), *s);
-    s += 2;
+  if(length < 2)
+    return;
+
+  d = StringPrivate::create(length / 2);
+  readUTF16(s, length / 2, d->data(), swap);
+}
+
+void String::appendData(const wchar *s, size_t length)
+{
+  if(length == 0)
+    return;
+
+  const size_t oldLength = size();
+  const size_t newLength = oldLength + length;
+
+  if(d && !d->isShared() && newLength <= d->capacity) {
+
+    // s may point into this very buffer, but only before its end.
+
+    ::memcpy(d->data() + oldLength, s, length * sizeof(wchar));
+    d->setLength(newLength);
+    return;
   }
+
+  // Leave room for further appends, much like std::wstring does.
+
+  StringPrivate *newData = StringPrivate::create(std::max(newLength, oldLength * 2));
+  if(oldLength > 0)
+    ::memcpy(newData->data(), d->data(), oldLength * sizeof(wchar));
+  ::memcpy(newData->data() + oldLength, s, length * sizeof(wchar));
+  newData->setLength(newLength);
+
+  if(d)
+    d->deref();
+  d = newData;
 }
 
 #if SYSTEM_BYTEORDER == 1
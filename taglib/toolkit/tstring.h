@@ -29,6 +29,7 @@
 #include "taglib_export.h"
 #include "taglib.h"
 #include "tbytevector.h"
+#include "tbytevectorview.h"
 
 #include <string>
 #include <iostream>
@@ -80,8 +81,8 @@ namespace TagLib {
   public:
 
 #ifndef DO_NOT_DOCUMENT
-    typedef std::basic_string<wchar>::iterator Iterator;
-    typedef std::basic_string<wchar>::const_iterator ConstIterator;
+    typedef wchar *Iterator;
+    typedef const wchar *ConstIterator;
 #endif
 
     /**
@@ -124,6 +125,14 @@ namespace TagLib {
      */
     String(const String &s);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Constructs a String that takes over the data of \a s, leaving \a s
+     * empty.
+     */
+    String(String &&s);
+#endif
+
     /*!
      * Makes a deep copy of the data in \a s.
      *
@@ -172,6 +181,12 @@ namespace TagLib {
      */
     String(const ByteVector &v, Type t = Latin1);
 
+    /*!
+     * Makes a deep copy of the bytes that \a v refers to.  This is the same as
+     * the constructor above but does not need a ByteVector to exist.
+     */
+    String(const ByteVectorView &v, Type t = Latin1);
+
     /*!
      * Destroys this String instance.
      */
@@ -202,7 +217,10 @@ namespace TagLib {
      * by the user.
      *
      * The returned pointer remains valid until this String instance is destroyed 
-     * or toCString() is called again.
+     * or modified, or toCString() is called again.
+     *
+     * A String which has been read from UTF-8 keeps the original bytes, so
+     * toCString(true) just returns them, as do to8Bit(true) and data(UTF8).
      *
      * \warning This however has the side effect that the returned string will remain
      * in memory <b>in addition to</b> other memory that is consumed by this 
@@ -419,6 +437,13 @@ namespace TagLib {
      */
     String &operator=(const String &s);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Takes over the data of \a s, leaving \a s empty.
+     */
+    String &operator=(String &&s);
+#endif
+
     /*!
      * Performs a deep copy of the data in \a s.
      */
@@ -498,7 +523,13 @@ namespace TagLib {
      * \e UTF-16(without BOM/CPU byte order) and copies it to the internal buffer.
      */
     void copyFromUTF16(const char *s, size_t length, Type t);
-    
+
+    /*!
+     * Appends \a length characters of \e UTF-16 (without BOM/CPU byte order)
+     * from \a s, which may point into this String itself.
+     */
+    void appendData(const wchar *s, size_t length);
+
     /*!
      * Indicates which byte order of UTF-16 is used to store strings internally. 
      *
@@ -507,6 +538,16 @@ namespace TagLib {
     static const Type WCharByteOrder;
 
     class StringPrivate;
+
+    /*!
+     * Takes over \a data, which holds a single reference.
+     */
+    explicit String(StringPrivate *data);
+
+    /*
+     * The reference count, the characters and their Latin-1 or UTF-8 source share
+     * a single allocation.  An empty String needs no buffer at all.
+     */
     StringPrivate *d;
   };
 }
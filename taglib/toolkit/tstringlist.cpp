@@ -65,6 +65,27 @@ StringList::StringList(const StringList &l) : List<String>(l)
 
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+StringList::StringList(StringList &&l) : List<String>(std::move(l))
+{
+
+}
+
+StringList &StringList::operator=(const StringList &l)
+{
+  List<String>::operator=(l);
+  return *this;
+}
+
+StringList &StringList::operator=(StringList &&l)
+{
+  List<String>::operator=(std::move(l));
+  return *this;
+}
+
+#endif
+
 StringList::StringList(const String &s) : List<String>()
 {
   append(s);
@@ -106,6 +127,16 @@ StringList &StringList::append(const String &s)
   return *this;
 }
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+
+StringList &StringList::append(String &&s)
+{
+  List<String>::append(std::move(s));
+  return *this;
+}
+
+#endif
+
 StringList &StringList::append(const StringList &l)
 {
   List<String>::append(l);
@@ -58,6 +58,23 @@ namespace TagLib {
      */
     StringList(const StringList &l);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Constructs a list that takes over the data of \a l.
+     */
+    StringList(StringList &&l);
+
+    /*!
+     * Make a shallow, implicitly shared, copy of \a l.
+     */
+    StringList &operator=(const StringList &l);
+
+    /*!
+     * Exchanges the data of this list with that of \a l.
+     */
+    StringList &operator=(StringList &&l);
+#endif
+
     /*!
      * Constructs a StringList with \a s as a member.
      */
@@ -87,6 +104,13 @@ namespace TagLib {
      */
     StringList &append(const String &s);
 
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+    /*!
+     * Moves \a s to the end of the list and returns a reference to the list.
+     */
+    StringList &append(String &&s);
+#endif
+
     /*!
      * Appends all of the values in \a l to the end of the list and returns a
      * reference to the list.
@@ -44,6 +44,82 @@
 # include <sys/endian.h>
 #endif
 
+#if defined(HAVE_MSC_AVX2) || defined(HAVE_MSC_PCLMUL)
+# include <intrin.h>
+#endif
+
+// Atomic reference counting, used by RefCounter and by the shared buffers of
+// ByteVector and String.
+
+#if defined(HAVE_STD_ATOMIC)
+# include <atomic>
+# define ATOMIC_INT std::atomic<unsigned int>
+# define ATOMIC_INC(x) x.fetch_add(1)
+# define ATOMIC_DEC(x) (x.fetch_sub(1) - 1)
+#elif defined(HAVE_BOOST_ATOMIC)
+# include <boost/atomic.hpp>
+# define ATOMIC_INT boost::atomic<unsigned int>
+# define ATOMIC_INC(x) x.fetch_add(1)
+# define ATOMIC_DEC(x) (x.fetch_sub(1) - 1)
+#elif defined(HAVE_GCC_ATOMIC)
+# define ATOMIC_INT int
+# define ATOMIC_INC(x) __sync_add_and_fetch(&x, 1)
+# define ATOMIC_DEC(x) __sync_sub_and_fetch(&x, 1)
+#elif defined(HAVE_WIN_ATOMIC)
+# if !defined(NOMINMAX)
+#   define NOMINMAX
+# endif
+# include <windows.h>
+# define ATOMIC_INT long
+# define ATOMIC_INC(x) InterlockedIncrement(&x)
+# define ATOMIC_DEC(x) InterlockedDecrement(&x)
+#elif defined(HAVE_MAC_ATOMIC)
+# include <libkern/OSAtomic.h>
+# define ATOMIC_INT int32_t
+# define ATOMIC_INC(x) OSAtomicIncrement32Barrier(&x)
+# define ATOMIC_DEC(x) OSAtomicDecrement32Barrier(&x)
+#elif defined(HAVE_IA64_ATOMIC)
+# include <ia64intrin.h>
+# define ATOMIC_INT int
+# define ATOMIC_INC(x) __sync_add_and_fetch(&x, 1)
+# define ATOMIC_DEC(x) __sync_sub_and_fetch(&x, 1)
+#else
+# define ATOMIC_INT int
+# define ATOMIC_INC(x) (++x)
+# define ATOMIC_DEC(x) (--x)
+#endif
+
+// A plain mutex, used to guard the little global state of the library.
+
+#if defined(HAVE_STD_MUTEX)
+# include <mutex>
+#elif defined(HAVE_WIN_MUTEX)
+# if !defined(NOMINMAX)
+#   define NOMINMAX
+# endif
+# include <windows.h>
+#elif defined(HAVE_PTHREAD_MUTEX)
+# include <pthread.h>
+#endif
+
+// Functions using AVX2 instructions have to be marked with this, and must only
+// be called if cpuSupportsAVX2() returns true.
+
+#if defined(HAVE_GCC_AVX2)
+# define TAGLIB_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(HAVE_MSC_AVX2)
+# define TAGLIB_TARGET_AVX2
+#endif
+
+// The same for carry-less multiplication, which is used together with SSSE3
+// byte shuffles, and cpuSupportsPCLMUL().
+
+#if defined(HAVE_GCC_PCLMUL)
+# define TAGLIB_TARGET_PCLMUL __attribute__((target("pclmul,ssse3")))
+#elif defined(HAVE_MSC_PCLMUL)
+# define TAGLIB_TARGET_PCLMUL
+#endif
+
 namespace TagLib
 {
 
@@ -144,6 +220,122 @@ namespace TagLib
 #endif
   }
 
+  inline bool detectAVX2()
+  {
+#if defined(HAVE_GCC_AVX2)
+
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("avx2") != 0);
+
+#elif defined(HAVE_MSC_AVX2)
+
+    int info[4];
+
+    __cpuid(info, 0);
+    if(info[0] < 7)
+      return false;
+
+    // The OS has to save the YMM registers as well.
+
+    __cpuid(info, 1);
+    if((info[2] & 0x18000000) != 0x18000000 || (_xgetbv(0) & 0x06) != 0x06)
+      return false;
+
+    __cpuidex(info, 7, 0);
+    return ((info[1] & 0x20) != 0);
+
+#else
+
+    return false;
+
+#endif
+  }
+
+  inline bool cpuSupportsAVX2()
+  {
+    static const bool supported = detectAVX2();
+    return supported;
+  }
+
+  inline bool detectPCLMUL()
+  {
+#if defined(HAVE_GCC_PCLMUL)
+
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("pclmul") != 0 && __builtin_cpu_supports("ssse3") != 0);
+
+#elif defined(HAVE_MSC_PCLMUL)
+
+    int info[4];
+
+    __cpuid(info, 1);
+    return ((info[2] & 0x00000202) == 0x00000202);
+
+#else
+
+    return false;
+
+#endif
+  }
+
+  inline bool cpuSupportsPCLMUL()
+  {
+    static const bool supported = detectPCLMUL();
+    return supported;
+  }
+
+  class Mutex
+  {
+  public:
+#if defined(HAVE_STD_MUTEX)
+
+    void lock()   { m.lock(); }
+    void unlock() { m.unlock(); }
+
+  private:
+    std::mutex m;
+
+#elif defined(HAVE_WIN_MUTEX)
+
+    Mutex()       { InitializeCriticalSection(&m); }
+    ~Mutex()      { DeleteCriticalSection(&m); }
+    void lock()   { EnterCriticalSection(&m); }
+    void unlock() { LeaveCriticalSection(&m); }
+
+  private:
+    CRITICAL_SECTION m;
+
+#elif defined(HAVE_PTHREAD_MUTEX)
+
+    Mutex()       { pthread_mutex_init(&m, 0); }
+    ~Mutex()      { pthread_mutex_destroy(&m); }
+    void lock()   { pthread_mutex_lock(&m); }
+    void unlock() { pthread_mutex_unlock(&m); }
+
+  private:
+    pthread_mutex_t m;
+
+#else
+
+    void lock()   {}
+    void unlock() {}
+
+#endif
+  };
+
+  class MutexLocker
+  {
+  public:
+    explicit MutexLocker(Mutex &mutex) : m(mutex) { m.lock(); }
+    ~MutexLocker() { m.unlock(); }
+
+  private:
+    MutexLocker(const MutexLocker &);
+    MutexLocker &operator=(const MutexLocker &);
+
+    Mutex &m;
+  };
+
 };
 
 #endif
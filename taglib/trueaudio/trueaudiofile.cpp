@@ -85,7 +85,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 TrueAudio::File::File(FileName file, bool readProperties,
-                 Properties::ReadStyle propertiesStyle) : TagLib::File(file)
+                 Properties::ReadStyle propertiesStyle,
+                 int readOptions) : TagLib::File(file, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -93,8 +94,9 @@ TrueAudio::File::File(FileName file, bool readProperties,
 }
 
 TrueAudio::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle propertiesStyle) :
-  TagLib::File(file)
+                 bool readProperties, Properties::ReadStyle propertiesStyle,
+                 int readOptions) :
+  TagLib::File(file, readOptions)
 {
   d = new FilePrivate(frameFactory);
   if(isOpen())
@@ -102,7 +104,8 @@ TrueAudio::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
 }
 
 TrueAudio::File::File(IOStream *stream, bool readProperties,
-                 Properties::ReadStyle propertiesStyle) : TagLib::File(stream)
+                 Properties::ReadStyle propertiesStyle,
+                 int readOptions) : TagLib::File(stream, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -110,8 +113,9 @@ TrueAudio::File::File(IOStream *stream, bool readProperties,
 }
 
 TrueAudio::File::File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle propertiesStyle) :
-  TagLib::File(stream)
+                 bool readProperties, Properties::ReadStyle propertiesStyle,
+                 int readOptions) :
+  TagLib::File(stream, readOptions)
 {
   d = new FilePrivate(frameFactory);
   if(isOpen())
@@ -169,6 +173,11 @@ bool TrueAudio::File::save()
     return false;
   }
 
+  if(readInPart()) {
+    debug("TrueAudio::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   // Update ID3v2 tag
 
   if(ID3v2Tag() && !ID3v2Tag()->isEmpty()) {
@@ -176,7 +185,7 @@ bool TrueAudio::File::save()
       d->ID3v2Location = 0;
       d->ID3v2OriginalSize = 0;
     }
-    ByteVector data = ID3v2Tag()->render();
+    ByteVector data = ID3v2Tag()->render(4, true);
     insert(data, d->ID3v2Location, d->ID3v2OriginalSize);
     d->ID3v1Location -= d->ID3v2OriginalSize - data.size();
     d->ID3v2OriginalSize = data.size();
@@ -259,7 +268,8 @@ void TrueAudio::File::read(bool readProperties, Properties::ReadStyle /* propert
 
   if(d->ID3v2Location >= 0) {
 
-    d->tag.set(TrueAudioID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory));
+    d->tag.set(TrueAudioID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory,
+                                                   readOptions()));
 
     d->ID3v2OriginalSize = ID3v2Tag()->header()->completeTagSize();
 
@@ -83,7 +83,8 @@ public:
 ////////////////////////////////////////////////////////////////////////////////
 
 WavPack::File::File(FileName file, bool readProperties,
-                Properties::ReadStyle propertiesStyle) : TagLib::File(file)
+                Properties::ReadStyle propertiesStyle,
+                int readOptions) : TagLib::File(file, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -91,7 +92,8 @@ WavPack::File::File(FileName file, bool readProperties,
 }
 
 WavPack::File::File(IOStream *stream, bool readProperties,
-                Properties::ReadStyle propertiesStyle) : TagLib::File(stream)
+                Properties::ReadStyle propertiesStyle,
+                int readOptions) : TagLib::File(stream, readOptions)
 {
   d = new FilePrivate;
   if(isOpen())
@@ -144,6 +146,11 @@ bool WavPack::File::save()
     return false;
   }
 
+  if(readInPart()) {
+    debug("WavPack::File::save() -- The tags were read only in part.");
+    return false;
+  }
+
   // Update ID3v1 tag
 
   if(ID3v1Tag()) {
@@ -261,7 +268,7 @@ void WavPack::File::read(bool readProperties, Properties::ReadStyle /* propertie
   d->APELocation = findAPE();
 
   if(d->APELocation >= 0) {
-    d->tag.set(WavAPEIndex, new APE::Tag(this, d->APELocation));
+    d->tag.set(WavAPEIndex, new APE::Tag(this, d->APELocation, readOptions()));
     d->APESize = APETag()->footer()->completeTagSize();
     d->APELocation = d->APELocation + APETag()->footer()->size() - d->APESize;
     d->hasAPE = true;
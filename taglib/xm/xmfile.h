@@ -71,13 +71,13 @@ namespace TagLib {
          * Implements the unified property interface -- export function.
          * Forwards to Mod::Tag::properties().
          */
-        PropertyMap properties() const;
+        virtual PropertyMap properties() const;
 
         /*!
          * Implements the unified property interface -- import function.
          * Forwards to Mod::Tag::setProperties().
          */
-        PropertyMap setProperties(const PropertyMap &);
+        virtual PropertyMap setProperties(const PropertyMap &);
 
         /*!
          * Returns the XM::Properties for this file. If no audio properties
@@ -4,6 +4,8 @@
 #include <tstringlist.h>
 #include <tbytevectorlist.h>
 #include <tpropertymap.h>
+#include <tfilestream.h>
+#include <tbytevectorstream.h>
 #include <asffile.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
@@ -24,6 +26,7 @@ class TestASF : public CppUnit::TestFixture
   CPPUNIT_TEST(testSavePicture);
   CPPUNIT_TEST(testSaveMultiplePictures);
   CPPUNIT_TEST(testProperties);
+  CPPUNIT_TEST(testDeferPicture);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -250,6 +253,44 @@ public:
     CPPUNIT_ASSERT_EQUAL(StringList("3"), tags["DISCNUMBER"]);
   }
 
+  void testDeferPicture()
+  {
+    ScopedFileCopy copy("silence-1", ".wma");
+    string newname = copy.fileName();
+
+    const ByteVector data(100000, 'J');
+
+    {
+      ASF::File f(newname.c_str());
+      ASF::Picture picture;
+      picture.setMimeType("image/jpeg");
+      picture.setType(ASF::Picture::FrontCover);
+      picture.setDescription("description");
+      picture.setPicture(data);
+      f.tag()->attributeListMap()["WM/Picture"].append(ASF::Attribute(picture));
+      f.save();
+    }
+
+    // An attribute this large is stored in the Metadata Library Object.  Its
+    // picture is read from the stream only when it is used, so it sees the
+    // bytes changed after the file has been opened.
+
+    FileStream file(newname.c_str(), true);
+    ByteVectorStream stream(file.readBlock(file.length()));
+
+    ASF::File f(&stream, false, ASF::Properties::Average, File::DeferBinaryData);
+    ASF::Picture picture = f.tag()->attributeListMap()["WM/Picture"].front().toPicture();
+    CPPUNIT_ASSERT(picture.isValid());
+    CPPUNIT_ASSERT_EQUAL(ASF::Picture::FrontCover, picture.type());
+    CPPUNIT_ASSERT_EQUAL(String("image/jpeg"), picture.mimeType());
+    CPPUNIT_ASSERT_EQUAL(String("description"), picture.description());
+
+    const int offset = stream.data()->find(data);
+    CPPUNIT_ASSERT(offset > 0);
+    ::memset(stream.data()->data() + offset, 'K', data.size());
+    CPPUNIT_ASSERT(picture.picture() == ByteVector(100000, 'K'));
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestASF);
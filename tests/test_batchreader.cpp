@@ -0,0 +1,185 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <tag.h>
+#include <fileref.h>
+#include <batchreader.h>
+#include <tfilestream.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "utils.h"
+
+using namespace std;
+using namespace TagLib;
+
+namespace
+{
+  const char *testFiles[] = {
+    "xing.mp3", "no-extension", "empty.ogg", "silence-44-s.flac", "click.mpc",
+    "has-tags.m4a", "silence-1.wma", "empty.wav", "noise.aif", "mac-399.ape",
+    "click.wv", "empty.tta", "test.mod", "test.xm", "unsupported-extension.xxx",
+    "rare_frames.mp3", "test.ogg", "correctness_gain_silent_output.opus",
+    "ilst-is-last.m4a", "id3v22-tda.mp3", "w000.mp3"
+  };
+
+  const uint testFileCount = sizeof(testFiles) / sizeof(testFiles[0]);
+
+  class FileStreamFactory : public BatchReader::StreamFactory
+  {
+  public:
+    FileStreamFactory(const vector<string> &names) : names(names) {}
+
+    IOStream *createStream(TagLib::uint index) const
+    {
+      return new FileStream(names[index].c_str(), true);
+    }
+
+  private:
+    const vector<string> &names;
+  };
+}
+
+class TestBatchReader : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestBatchReader);
+  CPPUNIT_TEST(testRead);
+  CPPUNIT_TEST(testStreams);
+  CPPUNIT_TEST(testFields);
+  CPPUNIT_TEST(testEmpty);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  vector<string> testFileNames()
+  {
+    vector<string> names;
+    for(TagLib::uint i = 0; i < testFileCount; ++i)
+      names.push_back(testFilePath(testFiles[i]));
+    return names;
+  }
+
+  string utf8(const BatchReader &reader, const BatchReader::Text &text)
+  {
+    return string(reader.textData() + text.offset, text.length);
+  }
+
+  void checkRecords(const BatchReader &reader, const vector<string> &names)
+  {
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(names.size()), reader.size());
+
+    for(TagLib::uint i = 0; i < names.size(); ++i) {
+      const BatchReader::Record &r = reader[i];
+      FileRef f(names[i].c_str());
+      CPPUNIT_ASSERT_EQUAL(!f.isNull(), r.isValid);
+      if(f.isNull())
+        continue;
+
+      Tag *tag = f.tag();
+      CPPUNIT_ASSERT_EQUAL(tag->title().to8Bit(true), utf8(reader, r.title));
+      CPPUNIT_ASSERT_EQUAL(tag->artist().to8Bit(true), utf8(reader, r.artist));
+      CPPUNIT_ASSERT_EQUAL(tag->album().to8Bit(true), utf8(reader, r.album));
+      CPPUNIT_ASSERT_EQUAL(tag->comment().to8Bit(true), utf8(reader, r.comment));
+      CPPUNIT_ASSERT_EQUAL(tag->genre().to8Bit(true), utf8(reader, r.genre));
+      CPPUNIT_ASSERT_EQUAL(tag->year(), r.year);
+      CPPUNIT_ASSERT_EQUAL(tag->track(), r.track);
+
+      AudioProperties *properties = f.audioProperties();
+      CPPUNIT_ASSERT(properties != NULL);
+      CPPUNIT_ASSERT_EQUAL(properties->length(), r.length);
+      CPPUNIT_ASSERT_EQUAL(properties->bitrate(), r.bitrate);
+      CPPUNIT_ASSERT_EQUAL(properties->sampleRate(), r.sampleRate);
+      CPPUNIT_ASSERT_EQUAL(properties->channels(), r.channels);
+    }
+  }
+
+  void testRead()
+  {
+    const vector<string> names = testFileNames();
+    List<FileName> fileNames;
+    for(TagLib::uint i = 0; i < names.size(); ++i)
+      fileNames.append(names[i].c_str());
+
+    BatchReader reader;
+    CPPUNIT_ASSERT(reader.threadCount() >= 1);
+
+    const TagLib::uint threadCounts[] = { 1, 3, 8, 64 };
+    for(TagLib::uint i = 0; i < 4; ++i) {
+      reader.setThreadCount(threadCounts[i]);
+#ifdef HAVE_THREADSAFE_STATICS
+      CPPUNIT_ASSERT_EQUAL(threadCounts[i], reader.threadCount());
+#else
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(1), reader.threadCount());
+#endif
+      reader.read(fileNames);
+      checkRecords(reader, names);
+    }
+
+    CPPUNIT_ASSERT(!reader[1].isValid);
+    CPPUNIT_ASSERT(reader[0].isValid);
+    CPPUNIT_ASSERT(reader[6].isValid);
+  }
+
+  void testStreams()
+  {
+    const vector<string> names = testFileNames();
+    const FileStreamFactory factory(names);
+
+    BatchReader reader;
+    reader.setThreadCount(4);
+    reader.read(names.size(), factory);
+    checkRecords(reader, names);
+  }
+
+  void testFields()
+  {
+    const string name = testFilePath("ilst-is-last.m4a");
+    List<FileName> fileNames;
+    fileNames.append(name.c_str());
+    fileNames.append(name.c_str());
+
+    BatchReader reader(BatchReader::Title | BatchReader::Year);
+    reader.read(fileNames);
+
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(2), reader.size());
+    for(TagLib::uint i = 0; i < 2; ++i) {
+      const BatchReader::Record &r = reader[i];
+      CPPUNIT_ASSERT(r.isValid);
+      CPPUNIT_ASSERT_EQUAL(String("Intro"), reader.text(r.title));
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(1995), r.year);
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(0), r.artist.length);
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(0), r.track);
+      CPPUNIT_ASSERT_EQUAL(0, r.length);
+      CPPUNIT_ASSERT_EQUAL(0, r.sampleRate);
+    }
+
+    CPPUNIT_ASSERT(string(reader.textData(), 10) == "IntroIntro");
+
+    BatchReader properties(BatchReader::Properties);
+    properties.read(fileNames);
+
+    const FileRef f(name.c_str());
+    for(TagLib::uint i = 0; i < 2; ++i) {
+      const BatchReader::Record &r = properties[i];
+      CPPUNIT_ASSERT(r.isValid);
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(0), r.title.length);
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(0), r.year);
+      CPPUNIT_ASSERT_EQUAL(f.audioProperties()->length(), r.length);
+      CPPUNIT_ASSERT_EQUAL(f.audioProperties()->sampleRate(), r.sampleRate);
+    }
+    CPPUNIT_ASSERT_EQUAL(String(), properties.text(properties[0].title));
+  }
+
+  void testEmpty()
+  {
+    BatchReader reader;
+    reader.read(List<FileName>());
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(0), reader.size());
+    CPPUNIT_ASSERT_EQUAL(String(), reader.text(BatchReader::Text()));
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestBatchReader);
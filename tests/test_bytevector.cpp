@@ -37,9 +37,15 @@ class TestByteVector : public CppUnit::TestFixture
   CPPUNIT_TEST(testFind2);
   CPPUNIT_TEST(testRfind1);
   CPPUNIT_TEST(testRfind2);
+  CPPUNIT_TEST(testFindLong);
   CPPUNIT_TEST(testToHex);
   CPPUNIT_TEST(testToUShort);
   CPPUNIT_TEST(testReplace);
+  CPPUNIT_TEST(testSharing);
+  CPPUNIT_TEST(testInlineStorage);
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  CPPUNIT_TEST(testMove);
+#endif
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -181,6 +187,41 @@ public:
     CPPUNIT_ASSERT_EQUAL(10, r4.rfind("OggS", 12));
   }
 
+  void testFindLong()
+  {
+    // Long enough to go through the vectorized searches.
+
+    ByteVector v(200, '*');
+    v[0] = 'O';
+    v[198] = 'S';
+
+    for(uint i = 1; i < 197; i += 7) {
+      ByteVector w = v;
+      w[i] = 'O';
+      w[i + 1] = 'g';
+      w[i + 2] = 'g';
+      w[i + 3] = 'S';
+
+      CPPUNIT_ASSERT_EQUAL(int(i), w.find("OggS"));
+      CPPUNIT_ASSERT_EQUAL(int(i), w.rfind("OggS"));
+      CPPUNIT_ASSERT_EQUAL(int(i + 1), w.find('g'));
+      CPPUNIT_ASSERT_EQUAL(-1, w.find("OggS", i + 1));
+      CPPUNIT_ASSERT_EQUAL(int(i), w.rfind("OggS", i));
+      CPPUNIT_ASSERT_EQUAL(int(i), w.rfind("OggS", i + 5));
+      if(i > 1)
+        CPPUNIT_ASSERT_EQUAL(-1, w.rfind("OggS", i - 1));
+      CPPUNIT_ASSERT_EQUAL(-1, w.find("OgS"));
+      CPPUNIT_ASSERT_EQUAL(-1, w.rfind("OgS"));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0, v.find("O*"));
+    CPPUNIT_ASSERT_EQUAL(0, v.rfind("O*"));
+    CPPUNIT_ASSERT_EQUAL(197, v.find("*S"));
+    CPPUNIT_ASSERT_EQUAL(197, v.rfind("*S"));
+    CPPUNIT_ASSERT_EQUAL(198, v.find('S'));
+    CPPUNIT_ASSERT_EQUAL(-1, v.find('S', 199));
+  }
+
   void testToHex()
   {
     ByteVector v("\xf0\xe1\xd2\xc3\xb4\xa5\x96\x87\x78\x69\x5a\x4b\x3c\x2d\x1e\x0f", 16);
@@ -241,6 +282,96 @@ public:
     }
   }
 
+  void testSharing()
+  {
+    const ByteVector a = ByteVector(50, 'x') + ByteVector("0123456789") + ByteVector(50, 'y');
+    const ByteVector b = a.mid(45, 40);
+    CPPUNIT_ASSERT(b.startsWith("xxxxx0123456789yyy"));
+    CPPUNIT_ASSERT(b.data() == a.data() + 45);
+
+    ByteVector c = a.mid(50, 40);
+    c[0] = 'z';
+    CPPUNIT_ASSERT(c.startsWith("z123456789"));
+    CPPUNIT_ASSERT(a.containsAt("0123456789", 50));
+
+    ByteVector d = a.mid(50, 3);
+    d.append("abc");
+    CPPUNIT_ASSERT_EQUAL(ByteVector("012abc"), d);
+
+    d.resize(2);
+    d.resize(4, 'z');
+    CPPUNIT_ASSERT_EQUAL(ByteVector("01zz"), d);
+
+    d.append(d);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("01zz01zz"), d);
+
+    ByteVector e = a.mid(40, 30);
+    e.resize(5);
+    e.resize(10, 'w');
+    CPPUNIT_ASSERT_EQUAL(ByteVector("xxxxxwwwww"), e);
+    CPPUNIT_ASSERT(a.containsAt("xxxxx0123456789", 45));
+
+    ByteVector f = ByteVector::null;
+    CPPUNIT_ASSERT(f.isNull());
+    CPPUNIT_ASSERT(!ByteVector().isNull());
+    f.append('a');
+    CPPUNIT_ASSERT(!f.isNull());
+    CPPUNIT_ASSERT(ByteVector::null.isEmpty());
+  }
+
+  void testInlineStorage()
+  {
+    ByteVector a("0123456789");
+    ByteVector b = a;
+    b[0] = 'x';
+    CPPUNIT_ASSERT_EQUAL(ByteVector("0123456789"), a);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("x123456789"), b);
+
+    for(int i = 0; i < 10; i++)
+      b.append("0123456789");
+    CPPUNIT_ASSERT_EQUAL(uint(110), b.size());
+    CPPUNIT_ASSERT(b.startsWith("x1234567890123456789"));
+    CPPUNIT_ASSERT(b.endsWith("01234567890123456789"));
+
+    b.resize(3);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("x12"), b);
+
+    ByteVector c(24, 'c');
+    ByteVector d = c;
+    d.append('d');
+    CPPUNIT_ASSERT_EQUAL(ByteVector(24, 'c'), c);
+    CPPUNIT_ASSERT_EQUAL(ByteVector(24, 'c') + ByteVector("d"), d);
+
+    c = d;
+    CPPUNIT_ASSERT_EQUAL(d, c);
+    d = a;
+    CPPUNIT_ASSERT_EQUAL(a, d);
+  }
+
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  void testMove()
+  {
+    ByteVector a(100, 'a');
+    const char *data = a.data();
+    ByteVector b(std::move(a));
+    CPPUNIT_ASSERT(a.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(uint(100), b.size());
+    CPPUNIT_ASSERT(b.data() == data);
+
+    ByteVector c("abc");
+    c = std::move(b);
+    CPPUNIT_ASSERT(b.isEmpty());
+    CPPUNIT_ASSERT(c.data() == data);
+
+    b = ByteVector("xyz");
+    CPPUNIT_ASSERT_EQUAL(ByteVector("xyz"), b);
+    a = std::move(b);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("xyz"), a);
+    CPPUNIT_ASSERT(b.isEmpty());
+    b.append("def");
+    CPPUNIT_ASSERT_EQUAL(ByteVector("def"), b);
+  }
+#endif
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestByteVector);
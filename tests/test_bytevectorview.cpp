@@ -0,0 +1,113 @@
+#include <tbytevector.h>
+#include <tbytevectorview.h>
+#include <tstring.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace std;
+using namespace TagLib;
+
+class TestByteVectorView : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestByteVectorView);
+  CPPUNIT_TEST(testMid);
+  CPPUNIT_TEST(testFind);
+  CPPUNIT_TEST(testToNumber);
+  CPPUNIT_TEST(testCompare);
+  CPPUNIT_TEST(testChecksum);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void testMid()
+  {
+    ByteVector v("0123456789");
+    ByteVectorView view(v);
+    CPPUNIT_ASSERT(view.data() == v.data());
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(10), view.size());
+
+    ByteVectorView m = view.mid(2, 3);
+    CPPUNIT_ASSERT(m.data() == v.data() + 2);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("234"), m.toByteVector());
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(2), view.mid(8).size());
+    CPPUNIT_ASSERT(view.mid(20, 5).isEmpty());
+    CPPUNIT_ASSERT_EQUAL('9', view.at(9));
+    CPPUNIT_ASSERT_EQUAL('\0', view.at(10));
+    CPPUNIT_ASSERT(ByteVectorView().isEmpty());
+  }
+
+  void testFind()
+  {
+    ByteVectorView view("....SggO." "....SggO.");
+    CPPUNIT_ASSERT_EQUAL(4, view.find("SggO"));
+    CPPUNIT_ASSERT_EQUAL(13, view.find("SggO", 5));
+    CPPUNIT_ASSERT_EQUAL(13, view.rfind("SggO"));
+    CPPUNIT_ASSERT_EQUAL(4, view.find('S'));
+    CPPUNIT_ASSERT_EQUAL(-1, view.find("OggS"));
+    CPPUNIT_ASSERT_EQUAL(13, view.find("SggO", 1, 2));
+    CPPUNIT_ASSERT_EQUAL(4, view.find("SggO", 0, 2));
+    CPPUNIT_ASSERT(view.startsWith("...."));
+    CPPUNIT_ASSERT(view.endsWith("SggO."));
+    CPPUNIT_ASSERT(view.containsAt("SggO", 13));
+  }
+
+  void testToNumber()
+  {
+    ByteVector v("\x00\x00\x01\x02\x03\x04\x05\x06\x07\x08", 10);
+    ByteVectorView view(v);
+    CPPUNIT_ASSERT_EQUAL(v.toUInt(), view.toUInt());
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(0x01020304), view.toUInt(2U));
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(0x04030201), view.toUInt(2U, false));
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(0x010203), view.toUInt(2U, 3U));
+    CPPUNIT_ASSERT_EQUAL((unsigned short)0x0102, view.toUShort(2U));
+    CPPUNIT_ASSERT_EQUAL(0x0102030405060708LL, view.toLongLong(2U));
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(0x0708), view.mid(8).toUInt());
+  }
+
+  void testCompare()
+  {
+    ByteVector v("abcabc");
+    ByteVectorView view(v);
+    CPPUNIT_ASSERT(view.mid(0, 3) == view.mid(3, 3));
+    CPPUNIT_ASSERT(view.mid(0, 3) == "abc");
+    CPPUNIT_ASSERT(view.mid(0, 3) != "abcd");
+    CPPUNIT_ASSERT(view == v);
+    CPPUNIT_ASSERT(view.mid(0, 3).equalsIgnoreCase("aBC"));
+    CPPUNIT_ASSERT(!view.mid(0, 3).equalsIgnoreCase("abcd"));
+    CPPUNIT_ASSERT(!ByteVectorView("@").equalsIgnoreCase("`"));
+    CPPUNIT_ASSERT(ByteVectorView().equalsIgnoreCase(""));
+    CPPUNIT_ASSERT_EQUAL(String("bca"), String(view.mid(1, 3)));
+  }
+
+  static TagLib::uint referenceChecksum(const char *data, TagLib::uint length)
+  {
+    TagLib::uint crc = 0;
+    for(TagLib::uint i = 0; i < length; i++) {
+      crc ^= TagLib::uint(TagLib::uchar(data[i])) << 24;
+      for(int j = 0; j < 8; j++)
+        crc = (crc & 0x80000000) ? ((crc << 1) ^ 0x04c11db7) : (crc << 1);
+    }
+    return crc;
+  }
+
+  void testChecksum()
+  {
+    ByteVector v(1000U);
+    for(TagLib::uint i = 0; i < v.size(); i++)
+      v[i] = static_cast<char>(i * 7 + (i >> 3));
+
+    const ByteVectorView view(v);
+    for(TagLib::uint offset = 0; offset < 4; offset++) {
+      for(TagLib::uint length = 0; length < 300; length++) {
+        const ByteVectorView part = view.mid(offset, length);
+        CPPUNIT_ASSERT_EQUAL(referenceChecksum(part.data(), length), part.checksum());
+      }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(referenceChecksum(v.data(), v.size()), v.checksum());
+    CPPUNIT_ASSERT_EQUAL(v.checksum(), view.mid(100).checksum(view.mid(0, 100).checksum()));
+    CPPUNIT_ASSERT_EQUAL(v.checksum(), view.mid(3).checksum(view.mid(0, 3).checksum()));
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestByteVectorView);
@@ -0,0 +1,141 @@
+#include <string>
+#include <stdio.h>
+#include <tcachediostream.h>
+#include <tbytevectorstream.h>
+#include <tfilestream.h>
+#include <tag.h>
+#include <mpegfile.h>
+#include <id3v2framefactory.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "utils.h"
+
+using namespace std;
+using namespace TagLib;
+
+class TestCachedIOStream : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestCachedIOStream);
+  CPPUNIT_TEST(testReadBlock);
+  CPPUNIT_TEST(testHitsAndMisses);
+  CPPUNIT_TEST(testEviction);
+  CPPUNIT_TEST(testWrite);
+  CPPUNIT_TEST(testNullStream);
+  CPPUNIT_TEST(testMPEG);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void testReadBlock()
+  {
+    ByteVectorStream data(ByteVector("0123456789abcdefghij"));
+    CachedIOStream stream(&data, 4, 2);
+
+    CPPUNIT_ASSERT_EQUAL(20L, stream.length());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("012"), stream.readBlock(3));
+    CPPUNIT_ASSERT_EQUAL(3L, stream.tell());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("3456"), stream.readBlock(4));
+    stream.seek(-3, IOStream::End);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("hij"), stream.readBlock(10));
+    CPPUNIT_ASSERT_EQUAL(ByteVector::null, stream.readBlock(10));
+
+    // Bigger than the whole cache
+    stream.seek(1);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("123456789abcdefghij"), stream.readBlock(100));
+  }
+
+  void testHitsAndMisses()
+  {
+    ByteVectorStream data(ByteVector("0123456789abcdefghij"));
+    CachedIOStream stream(&data, 4, 2);
+
+    stream.readBlock(2);
+    stream.readBlock(2);
+    stream.seek(1);
+    stream.readBlock(3);
+    CPPUNIT_ASSERT_EQUAL(TagLib::ulong(1), stream.misses());
+    CPPUNIT_ASSERT_EQUAL(TagLib::ulong(2), stream.hits());
+
+    stream.seek(2);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("2345"), stream.readBlock(4));
+    CPPUNIT_ASSERT_EQUAL(TagLib::ulong(2), stream.misses());
+    CPPUNIT_ASSERT_EQUAL(TagLib::ulong(3), stream.hits());
+  }
+
+  void testEviction()
+  {
+    ByteVectorStream data(ByteVector("0123456789abcdefghij"));
+    CachedIOStream stream(&data, 4, 2);
+
+    stream.readBlock(1);
+    stream.seek(4);
+    stream.readBlock(1);
+    stream.seek(0);
+    stream.readBlock(1);
+    stream.seek(8);
+    stream.readBlock(1);
+    CPPUNIT_ASSERT_EQUAL(TagLib::ulong(3), stream.misses());
+
+    // The block at 0 was used more recently than the one at 4.
+    stream.seek(0);
+    stream.readBlock(1);
+    CPPUNIT_ASSERT_EQUAL(TagLib::ulong(3), stream.misses());
+    stream.seek(4);
+    stream.readBlock(1);
+    CPPUNIT_ASSERT_EQUAL(TagLib::ulong(4), stream.misses());
+  }
+
+  void testWrite()
+  {
+    ByteVectorStream data(ByteVector("0123456789"));
+    CachedIOStream stream(&data, 4, 2);
+
+    CPPUNIT_ASSERT_EQUAL(ByteVector("0123"), stream.readBlock(4));
+    stream.seek(1);
+    stream.writeBlock("xy");
+    CPPUNIT_ASSERT_EQUAL(3L, stream.tell());
+    stream.seek(0);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("0xy3"), stream.readBlock(4));
+
+    stream.insert("abc", 0, 1);
+    CPPUNIT_ASSERT_EQUAL(12L, stream.length());
+    stream.seek(0);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("abcxy3"), stream.readBlock(6));
+
+    stream.truncate(4);
+    CPPUNIT_ASSERT_EQUAL(4L, stream.length());
+  }
+
+  void testNullStream()
+  {
+    CachedIOStream stream(0);
+
+    CPPUNIT_ASSERT(!stream.isOpen());
+    CPPUNIT_ASSERT(stream.readOnly());
+    CPPUNIT_ASSERT_EQUAL(0L, stream.length());
+    CPPUNIT_ASSERT_EQUAL(ByteVector::null, stream.readBlock(4));
+
+    stream.seek(-1, IOStream::End);
+    stream.seek(2);
+    stream.writeBlock("xy");
+    stream.insert("abc", 0, 1);
+    stream.removeBlock(0, 1);
+    stream.truncate(0);
+    stream.clear();
+    stream.setAccessHints(IOStream::SequentialAccess);
+    CPPUNIT_ASSERT_EQUAL(2L, stream.tell());
+    CPPUNIT_ASSERT_EQUAL(0L, stream.length());
+  }
+
+  void testMPEG()
+  {
+    FileStream file(TEST_FILE_PATH_C("mpeg2.mp3"), true);
+    CachedIOStream stream(&file, 4096, 4);
+    MPEG::File f(&stream, ID3v2::FrameFactory::instance());
+    CPPUNIT_ASSERT(f.isValid());
+    CPPUNIT_ASSERT_EQUAL(5387, f.audioProperties()->length());
+    CPPUNIT_ASSERT(stream.hits() > 0);
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCachedIOStream);
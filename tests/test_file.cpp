@@ -0,0 +1,222 @@
+#include <tfile.h>
+#include <tbytevectorstream.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "utils.h"
+
+using namespace std;
+using namespace TagLib;
+
+// File subclass that gives access to the protected constructor.
+class PlainFile : public File
+{
+public:
+  explicit PlainFile(IOStream *stream) : File(stream) {}
+  using File::queueInsert;
+  using File::queueRemoveBlock;
+  using File::commitEdits;
+  using File::bufferSize;
+  using File::streamBufferSize;
+  Tag *tag() const { return 0; }
+  AudioProperties *audioProperties() const { return 0; }
+  bool save() { return false; }
+};
+
+// ByteVectorStream that counts the calls that shift data.
+class ShiftCountingStream : public ByteVectorStream
+{
+public:
+  explicit ShiftCountingStream(const ByteVector &data) : ByteVectorStream(data), shifts(0) {}
+  void insert(const ByteVector &data, ulong start, ulong replace)
+  {
+    ++shifts;
+    ByteVectorStream::insert(data, start, replace);
+  }
+  void removeBlock(ulong start, ulong length)
+  {
+    ++shifts;
+    ByteVectorStream::removeBlock(start, length);
+  }
+  int shifts;
+};
+
+class TestFile : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestFile);
+  CPPUNIT_TEST(testFind);
+  CPPUNIT_TEST(testRFind);
+  CPPUNIT_TEST(testFindAcrossWindows);
+  CPPUNIT_TEST(testFindBefore);
+  CPPUNIT_TEST(testFindLimit);
+  CPPUNIT_TEST(testCommitEdits);
+  CPPUNIT_TEST(testBufferSize);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void testFind()
+  {
+    ByteVectorStream stream(ByteVector("OggS..OggS....OggS"));
+    PlainFile f(&stream);
+
+    f.seek(3);
+    CPPUNIT_ASSERT_EQUAL(0L, f.find("OggS"));
+    CPPUNIT_ASSERT_EQUAL(6L, f.find("OggS", 1));
+    CPPUNIT_ASSERT_EQUAL(14L, f.find("OggS", 7));
+    CPPUNIT_ASSERT_EQUAL(-1L, f.find("OggS", 15));
+    CPPUNIT_ASSERT_EQUAL(-1L, f.find("fLaC"));
+    CPPUNIT_ASSERT_EQUAL(3L, f.tell());
+  }
+
+  void testRFind()
+  {
+    ByteVectorStream stream(ByteVector("OggS..OggS....OggS"));
+    PlainFile f(&stream);
+
+    CPPUNIT_ASSERT_EQUAL(14L, f.rfind("OggS"));
+    CPPUNIT_ASSERT_EQUAL(6L, f.rfind("OggS", 14));
+    CPPUNIT_ASSERT_EQUAL(0L, f.rfind("OggS", 9));
+    CPPUNIT_ASSERT_EQUAL(-1L, f.rfind("OggS", 3));
+    CPPUNIT_ASSERT_EQUAL(-1L, f.rfind("fLaC"));
+  }
+
+  void testFindAcrossWindows()
+  {
+    // Put a match across every possible window boundary.
+
+    for(uint i = 1000; i < 1100; i += 3) {
+      ByteVector data(300000, 'x');
+      data[i] = 'a';
+      data[i + 1] = 'b';
+      data[i + 2] = 'c';
+      data[299990 - i] = 'a';
+      data[299991 - i] = 'b';
+      data[299992 - i] = 'c';
+
+      ByteVectorStream stream(data);
+      PlainFile f(&stream);
+      f.setSearchWindowSize(4096);
+
+      CPPUNIT_ASSERT_EQUAL(long(i), f.find("abc"));
+      CPPUNIT_ASSERT_EQUAL(long(299990 - i), f.find("abc", i + 1));
+      CPPUNIT_ASSERT_EQUAL(long(299990 - i), f.rfind("abc"));
+      CPPUNIT_ASSERT_EQUAL(long(i), f.rfind("abc", 299990 - i));
+      CPPUNIT_ASSERT_EQUAL(-1L, f.find("abd"));
+      CPPUNIT_ASSERT_EQUAL(-1L, f.rfind("abd"));
+    }
+  }
+
+  void testFindBefore()
+  {
+    ByteVectorStream stream(ByteVector("....ID3....fLaC....ID3"));
+    PlainFile f(&stream);
+
+    CPPUNIT_ASSERT_EQUAL(4L, f.find("ID3", 0, "fLaC"));
+    CPPUNIT_ASSERT_EQUAL(-1L, f.find("ID3", 5, "fLaC"));
+    CPPUNIT_ASSERT_EQUAL(19L, f.rfind("ID3", 0, "fLaC"));
+    CPPUNIT_ASSERT_EQUAL(-1L, f.rfind("ID3", 18, "fLaC"));
+  }
+
+  void testFindLimit()
+  {
+    ByteVectorStream stream(ByteVector("OggS..OggS....OggS"));
+    PlainFile f(&stream);
+
+    CPPUNIT_ASSERT_EQUAL(6L, f.find("OggS", 1, ByteVector::null, 10));
+    CPPUNIT_ASSERT_EQUAL(-1L, f.find("OggS", 1, ByteVector::null, 9));
+    CPPUNIT_ASSERT_EQUAL(6L, f.rfind("OggS", 14, ByteVector::null, 6));
+    CPPUNIT_ASSERT_EQUAL(-1L, f.rfind("OggS", 14, ByteVector::null, 7));
+  }
+
+  void testCommitEdits()
+  {
+    ByteVector original(300000, 0);
+    for(uint i = 0; i < original.size(); ++i)
+      original[i] = static_cast<char>(i * 7 + i / 251);
+
+    // Tags growing at the front and shrinking at the end, and the other way
+    // around, so that the parts in between move in both directions.
+
+    {
+      ByteVectorStream stream(original);
+      PlainFile f(&stream);
+      f.queueInsert(ByteVector(100000, 'a'), 0, 10);
+      f.queueRemoveBlock(150000, 70000);
+      f.queueInsert(ByteVector(5, 'b'), 290000, 10000);
+      f.queueInsert(ByteVector(128, 'c'), 300000);
+      f.commitEdits();
+
+      const ByteVector expected = ByteVector(100000, 'a') + original.mid(10, 149990)
+        + original.mid(220000, 70000) + ByteVector(5, 'b') + ByteVector(128, 'c');
+      CPPUNIT_ASSERT(expected == *stream.data());
+    }
+    {
+      ByteVectorStream stream(original);
+      PlainFile f(&stream);
+      f.queueInsert(ByteVector(3, 'a'), 0, 200000);
+      f.queueInsert(ByteVector(150000, 'b'), 250000);
+      f.queueInsert(ByteVector(10, 'c'), 299990, 10);
+      f.commitEdits();
+
+      const ByteVector expected = ByteVector(3, 'a') + original.mid(200000, 50000)
+        + ByteVector(150000, 'b') + original.mid(250000, 49990) + ByteVector(10, 'c');
+      CPPUNIT_ASSERT(expected == *stream.data());
+    }
+    {
+      ByteVectorStream stream(original);
+      PlainFile f(&stream);
+      f.queueInsert(ByteVector(20, 'a'), 100, 20);
+      f.queueInsert(ByteVector(5, 'b'), 100);
+      f.queueInsert(ByteVector(5, 'c'), 110, 5);
+      f.commitEdits();
+
+      const ByteVector expected = original.mid(0, 100) + ByteVector(5, 'b')
+        + ByteVector(20, 'a') + original.mid(120);
+      CPPUNIT_ASSERT(expected == *stream.data());
+    }
+
+    // Only one edit changes the size, so the stream shifts the data once and
+    // the other edit is overwritten in place.
+
+    {
+      ShiftCountingStream stream(original);
+      PlainFile f(&stream);
+      f.queueInsert(ByteVector(128, 'a'), 299872, 128);
+      f.queueInsert(ByteVector(4096, 'b'), 0, 1000);
+      f.commitEdits();
+
+      const ByteVector expected = ByteVector(4096, 'b') + original.mid(1000, 298872)
+        + ByteVector(128, 'a');
+      CPPUNIT_ASSERT(expected == *stream.data());
+      CPPUNIT_ASSERT_EQUAL(1, stream.shifts);
+    }
+    {
+      ShiftCountingStream stream(original);
+      PlainFile f(&stream);
+      f.queueInsert(ByteVector(4, 'a'), 4, 4);
+      f.queueInsert(ByteVector(10, 'b'), 100, 10);
+      f.commitEdits();
+
+      const ByteVector expected = original.mid(0, 4) + ByteVector(4, 'a')
+        + original.mid(8, 92) + ByteVector(10, 'b') + original.mid(110);
+      CPPUNIT_ASSERT(expected == *stream.data());
+      CPPUNIT_ASSERT_EQUAL(0, stream.shifts);
+    }
+  }
+
+  void testBufferSize()
+  {
+    ByteVectorStream stream(ByteVector("OggS..OggS....OggS"));
+    PlainFile f(&stream);
+
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(1024), PlainFile::bufferSize());
+    CPPUNIT_ASSERT_EQUAL(stream.bufferSize(), f.streamBufferSize());
+
+    stream.setBufferSize(4);
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(4), f.streamBufferSize());
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(1024), PlainFile::bufferSize());
+    CPPUNIT_ASSERT_EQUAL(14L, f.find("OggS", 7));
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFile);
@@ -4,12 +4,65 @@
 #include <fileref.h>
 #include <oggflacfile.h>
 #include <vorbisfile.h>
+#include <speexfile.h>
+#include <opusfile.h>
+#include <mpegfile.h>
+#include <flacfile.h>
+#include <mpcfile.h>
+#include <mp4file.h>
+#include <asffile.h>
+#include <wavfile.h>
+#include <aifffile.h>
+#include <apefile.h>
+#include <wavpackfile.h>
+#include <trueaudiofile.h>
+#include <modfile.h>
+#include <s3mfile.h>
+#include <itfile.h>
+#include <xmfile.h>
+#include <tfilestream.h>
+#include <tbytevectorstream.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
 using namespace std;
 using namespace TagLib;
 
+namespace
+{
+  class DummyFile : public File
+  {
+  public:
+    DummyFile(FileName fileName) : File(fileName) {}
+    DummyFile(IOStream *stream) : File(stream) {}
+    DummyFile(IOStream *stream, int readOptions) : File(stream, readOptions) {}
+    int options() const { return readOptions(); }
+    Tag *tag() const { return 0; }
+    AudioProperties *audioProperties() const { return 0; }
+    bool save() { return false; }
+  };
+
+  class DummyFormat : public FileRef::FileFormat
+  {
+  public:
+    StringList extensions() const { return StringList("dummy"); }
+    TagLib::uint signatureLength() const { return 8; }
+    bool isSignature(const ByteVectorView &data) const { return data.startsWith("DUMMYFMT"); }
+    File *createFile(FileName fileName, bool, AudioProperties::ReadStyle) const
+    {
+      return new DummyFile(fileName);
+    }
+    File *createFile(IOStream *stream, bool, AudioProperties::ReadStyle) const
+    {
+      return new DummyFile(stream);
+    }
+    File *createFile(IOStream *stream, bool, AudioProperties::ReadStyle, int readOptions) const
+    {
+      return new DummyFile(stream, readOptions);
+    }
+  };
+}
+
 class TestFileRef : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestFileRef);
@@ -28,6 +81,10 @@ class TestFileRef : public CppUnit::TestFixture
   CPPUNIT_TEST(testAPE);
   CPPUNIT_TEST(testWav);
   CPPUNIT_TEST(testUnsupported);
+  CPPUNIT_TEST(testStream);
+  CPPUNIT_TEST(testWrongExtension);
+  CPPUNIT_TEST(testDefaultFileExtensions);
+  CPPUNIT_TEST(testFileFormat);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -76,6 +133,17 @@ public:
     delete f;
   }
 
+  template <class T>
+  void detectFromStream(const char *fileName)
+  {
+    FileStream file(TEST_FILE_PATH_C(fileName), true);
+    ByteVectorStream stream(file.readBlock(file.length()));
+
+    FileRef f(&stream);
+    CPPUNIT_ASSERT(!f.isNull());
+    CPPUNIT_ASSERT(dynamic_cast<T *>(f.file()) != NULL);
+  }
+
   void testMusepack()
   {
     fileRefSave("click", ".mpc");
@@ -157,6 +225,98 @@ public:
     
     FileRef f2(TEST_FILE_PATH_C("unsupported-extension.xxx"));
     CPPUNIT_ASSERT(f2.isNull());
+
+    ByteVectorStream stream(ByteVector(2048, 0));
+    FileRef f3(&stream);
+    CPPUNIT_ASSERT(f3.isNull());
+  }
+
+  void testStream()
+  {
+    detectFromStream<MPEG::File>("xing.mp3");
+    detectFromStream<MPEG::File>("compressed_id3_frame.mp3");
+    detectFromStream<Ogg::Vorbis::File>("empty.ogg");
+    detectFromStream<Ogg::Vorbis::File>("empty_vorbis.oga");
+    detectFromStream<Ogg::FLAC::File>("empty_flac.oga");
+    detectFromStream<Ogg::Speex::File>("empty.spx");
+    detectFromStream<Ogg::Opus::File>("correctness_gain_silent_output.opus");
+    detectFromStream<FLAC::File>("silence-44-s.flac");
+    detectFromStream<MPC::File>("click.mpc");
+    detectFromStream<MPC::File>("sv8_header.mpc");
+    detectFromStream<WavPack::File>("click.wv");
+    detectFromStream<TrueAudio::File>("empty.tta");
+    detectFromStream<MP4::File>("has-tags.m4a");
+    detectFromStream<MP4::File>("64bit.mp4");
+    detectFromStream<ASF::File>("silence-1.wma");
+    detectFromStream<RIFF::WAV::File>("empty.wav");
+    detectFromStream<RIFF::AIFF::File>("noise.aif");
+    detectFromStream<APE::File>("mac-399.ape");
+    detectFromStream<Mod::File>("test.mod");
+    detectFromStream<S3M::File>("test.s3m");
+    detectFromStream<IT::File>("test.it");
+    detectFromStream<XM::File>("test.xm");
+  }
+
+  void testWrongExtension()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName() + ".ogg";
+    CPPUNIT_ASSERT(rename(copy.fileName().c_str(), newname.c_str()) == 0);
+
+    {
+      FileRef f(newname.c_str());
+      CPPUNIT_ASSERT(!f.isNull());
+      CPPUNIT_ASSERT(dynamic_cast<MPEG::File *>(f.file()) != NULL);
+    }
+
+    CPPUNIT_ASSERT(rename(newname.c_str(), copy.fileName().c_str()) == 0);
+  }
+
+  void testDefaultFileExtensions()
+  {
+    const StringList l = FileRef::defaultFileExtensions();
+    CPPUNIT_ASSERT_EQUAL(String("ogg"), l.front());
+    CPPUNIT_ASSERT(l.contains("mp3"));
+    CPPUNIT_ASSERT(l.contains("opus"));
+    CPPUNIT_ASSERT(l.contains("3g2"));
+    CPPUNIT_ASSERT(l.contains("wow"));
+    CPPUNIT_ASSERT(l.contains("xm"));
+    CPPUNIT_ASSERT(!l.contains("MP3"));
+  }
+
+  void testFileFormat()
+  {
+    static const DummyFormat format;
+    CPPUNIT_ASSERT(FileRef::addFileFormat(&format) == &format);
+    CPPUNIT_ASSERT_EQUAL(String("dummy"), FileRef::defaultFileExtensions().back());
+
+    ByteVector data("DUMMYFMT");
+    data.resize(2048, 0);
+    ByteVectorStream stream(data);
+    FileRef f(&stream);
+    CPPUNIT_ASSERT(!f.isNull());
+    CPPUNIT_ASSERT(dynamic_cast<DummyFile *>(f.file()) != NULL);
+
+    // Other content is still detected by its own signature.
+    detectFromStream<MPEG::File>("xing.mp3");
+    detectFromStream<XM::File>("test.xm");
+
+    File *file = FileRef::create(TEST_FILE_PATH_C("xing.DUMMY"));
+    CPPUNIT_ASSERT(dynamic_cast<DummyFile *>(file) != NULL);
+    delete file;
+
+    // An added format is given the read options of a FileRef opened by name.
+
+    ScopedFileCopy copy("xing", ".mp3");
+    {
+      FileStream out(copy.fileName().c_str());
+      out.writeBlock(data);
+      out.truncate(data.size());
+    }
+    FileRef g(copy.fileName().c_str(), false, AudioProperties::Average, File::DeferBinaryData);
+    const DummyFile *dummy = dynamic_cast<DummyFile *>(g.file());
+    CPPUNIT_ASSERT(dummy != NULL);
+    CPPUNIT_ASSERT_EQUAL(int(File::DeferBinaryData), dummy->options());
   }
 };
 
@@ -0,0 +1,211 @@
+#include <string>
+#include <stdio.h>
+#include <tfilestream.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "utils.h"
+
+using namespace std;
+using namespace TagLib;
+
+class TestFileStream : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestFileStream);
+  CPPUNIT_TEST(testSeek);
+  CPPUNIT_TEST(testInsertAndRemove);
+  CPPUNIT_TEST(testInsertAndRemoveBlocks);
+  CPPUNIT_TEST(testBufferSizeAndHints);
+#ifndef _WIN32
+  CPPUNIT_TEST(testRewrite);
+  CPPUNIT_TEST(testSharedDescriptor);
+  CPPUNIT_TEST(testReadOnlyDescriptor);
+#endif
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void testSeek()
+  {
+    FileStream stream(TEST_FILE_PATH_C("xing.mp3"), true);
+    CPPUNIT_ASSERT(stream.isOpen());
+    const ByteVector data = stream.readBlock(stream.length());
+
+    stream.seek(100);
+    CPPUNIT_ASSERT_EQUAL(100L, stream.tell());
+    stream.seek(20, IOStream::Current);
+    CPPUNIT_ASSERT_EQUAL(120L, stream.tell());
+    stream.seek(-128, IOStream::End);
+    CPPUNIT_ASSERT_EQUAL(stream.length() - 128, stream.tell());
+    CPPUNIT_ASSERT_EQUAL(data.mid(data.size() - 128, 3), stream.readBlock(3));
+    CPPUNIT_ASSERT_EQUAL(stream.length() - 125, stream.tell());
+  }
+
+  void testInsertAndRemove()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    FileStream stream(newname.c_str());
+    CPPUNIT_ASSERT(!stream.readOnly());
+
+    const long length = stream.length();
+    stream.insert(ByteVector(10000, 'x'), 10, 5);
+    CPPUNIT_ASSERT_EQUAL(length + 9995, stream.length());
+    stream.seek(10);
+    CPPUNIT_ASSERT_EQUAL(ByteVector(10000, 'x'), stream.readBlock(10000));
+
+    stream.removeBlock(10, 10000);
+    stream.insert(ByteVector(5, '\0'), 10, 0);
+    stream.seek(0);
+    ByteVector original = FileStream(TEST_FILE_PATH_C("xing.mp3"), true).readBlock(length);
+    ByteVector modified = stream.readBlock(length);
+    CPPUNIT_ASSERT_EQUAL(length, stream.length());
+    CPPUNIT_ASSERT(original.mid(0, 10) == modified.mid(0, 10));
+    CPPUNIT_ASSERT(original.mid(15) == modified.mid(15));
+  }
+
+  void testInsertAndRemoveBlocks()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    FileStream stream(newname.c_str());
+    const long length = stream.length();
+    const ByteVector original = stream.readBlock(length);
+
+    // Block sized deltas, which may be done by shifting the file's extents.
+
+    stream.insert(ByteVector(4096 + 10, 'x'), 0, 10);
+    CPPUNIT_ASSERT_EQUAL(length + 4096, stream.length());
+    stream.seek(0);
+    CPPUNIT_ASSERT_EQUAL(ByteVector(4096 + 10, 'x'), stream.readBlock(4096 + 10));
+    CPPUNIT_ASSERT(original.mid(10) == stream.readBlock(length));
+
+    stream.insert(ByteVector(10, 'y'), 0, 4096 + 10);
+    CPPUNIT_ASSERT_EQUAL(length, stream.length());
+    stream.seek(0);
+    CPPUNIT_ASSERT_EQUAL(ByteVector(10, 'y'), stream.readBlock(10));
+    CPPUNIT_ASSERT(original.mid(10) == stream.readBlock(length));
+
+    stream.insert(ByteVector(8192, 'z'), 4096, 0);
+    stream.removeBlock(4096, 8192);
+    CPPUNIT_ASSERT_EQUAL(length, stream.length());
+    stream.seek(10);
+    CPPUNIT_ASSERT(original.mid(10) == stream.readBlock(length));
+  }
+
+  void testBufferSizeAndHints()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    FileStream stream(newname.c_str());
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(8192), stream.bufferSize());
+    CPPUNIT_ASSERT_EQUAL(int(IOStream::NormalAccess), stream.accessHints());
+
+    stream.setBufferSize(1024 * 1024);
+    stream.setAccessHints(IOStream::SequentialAccess | IOStream::NoReuse);
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(1024 * 1024), stream.bufferSize());
+    CPPUNIT_ASSERT_EQUAL(int(IOStream::SequentialAccess | IOStream::NoReuse), stream.accessHints());
+
+    // Large blocks are used for shifting data as well.
+
+    const long length = stream.length();
+    const ByteVector original = stream.readBlock(length);
+    stream.insert(ByteVector(100, 'x'), 10, 5);
+    stream.seek(0);
+    CPPUNIT_ASSERT(original.mid(0, 10) + ByteVector(100, 'x') + original.mid(15) == stream.readBlock(length + 95));
+  }
+
+#ifndef _WIN32
+
+  void testRewrite()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    struct stat before;
+    CPPUNIT_ASSERT_EQUAL(0, stat(newname.c_str(), &before));
+
+    FileStream stream(newname.c_str());
+    const long length = stream.length();
+    const ByteVector original = stream.readBlock(length);
+
+    CPPUNIT_ASSERT(stream.rewrite(ByteVector(10000, 'x'), 10, 5));
+    CPPUNIT_ASSERT_EQUAL(length + 9995, stream.length());
+    stream.seek(0);
+    const ByteVector modified = stream.readBlock(length + 9995);
+    CPPUNIT_ASSERT(original.mid(0, 10) == modified.mid(0, 10));
+    CPPUNIT_ASSERT(ByteVector(10000, 'x') == modified.mid(10, 10000));
+    CPPUNIT_ASSERT(original.mid(15) == modified.mid(10010));
+
+    struct stat after;
+    CPPUNIT_ASSERT_EQUAL(0, stat(newname.c_str(), &after));
+    CPPUNIT_ASSERT(before.st_ino != after.st_ino);
+    CPPUNIT_ASSERT_EQUAL(before.st_mode, after.st_mode);
+
+    CPPUNIT_ASSERT(stream.rewrite(ByteVector::null, 10, 10000));
+    stream.seek(0);
+    CPPUNIT_ASSERT(original.mid(0, 10) + original.mid(15) == stream.readBlock(length));
+
+    CPPUNIT_ASSERT(!FileStream(TEST_FILE_PATH_C("xing.mp3"), true).rewrite("x", 0, 0));
+
+    // Several changes go into a single new file.
+
+    const ByteVector current = original.mid(0, 10) + original.mid(15);
+
+    List<FileStream::Change> changes;
+    changes.append(FileStream::Change(ByteVector(5000, 'a'), 0, 10));
+    changes.append(FileStream::Change(ByteVector(10, 'b'), 100, 10));
+    changes.append(FileStream::Change(ByteVector::null, 200, 50));
+    CPPUNIT_ASSERT(stream.rewrite(changes));
+    stream.seek(0);
+    const ByteVector expected = ByteVector(5000, 'a') + current.mid(10, 90)
+      + ByteVector(10, 'b') + current.mid(110, 90) + current.mid(250);
+    CPPUNIT_ASSERT(expected == stream.readBlock(expected.size() + 1));
+
+    changes.append(FileStream::Change("c", 150, 0));
+    CPPUNIT_ASSERT(!stream.rewrite(changes));
+  }
+
+  void testSharedDescriptor()
+  {
+    const int fd = open(TEST_FILE_PATH_C("xing.mp3"), O_RDONLY);
+    CPPUNIT_ASSERT(fd != -1);
+
+    FileStream stream1(fd, true);
+    FileStream stream2(fd, true);
+    CPPUNIT_ASSERT(stream1.isOpen());
+    CPPUNIT_ASSERT(stream2.isOpen());
+    CPPUNIT_ASSERT(stream1.readOnly());
+
+    const ByteVector data = FileStream(TEST_FILE_PATH_C("xing.mp3"), true).readBlock(stream1.length());
+
+    stream2.seek(-128, IOStream::End);
+    CPPUNIT_ASSERT_EQUAL(data.mid(0, 4), stream1.readBlock(4));
+    CPPUNIT_ASSERT_EQUAL(data.mid(data.size() - 128, 3), stream2.readBlock(3));
+    CPPUNIT_ASSERT_EQUAL(data.mid(4, 4), stream1.readBlock(4));
+    CPPUNIT_ASSERT_EQUAL(8L, stream1.tell());
+
+    // The descriptor still belongs to the caller and its offset is untouched.
+
+    CPPUNIT_ASSERT_EQUAL(off_t(0), lseek(fd, 0, SEEK_CUR));
+    close(fd);
+  }
+
+  void testReadOnlyDescriptor()
+  {
+    const int fd = open(TEST_FILE_PATH_C("xing.mp3"), O_RDONLY);
+
+    FileStream stream(fd);
+    close(fd);
+
+    CPPUNIT_ASSERT(stream.isOpen());
+    CPPUNIT_ASSERT(stream.readOnly());
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(4), stream.readBlock(4).size());
+  }
+
+#endif
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFileStream);
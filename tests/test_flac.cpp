@@ -4,6 +4,9 @@
 #include <tstringlist.h>
 #include <tbytevectorlist.h>
 #include <tpropertymap.h>
+#include <tfilestream.h>
+#include <tbytevectorstream.h>
+#include <id3v2framefactory.h>
 #include <flacfile.h>
 #include <xiphcomment.h>
 #include <cppunit/extensions/HelperMacros.h>
@@ -25,6 +28,7 @@ class TestFLAC : public CppUnit::TestFixture
   CPPUNIT_TEST(testSaveMultipleValues);
   CPPUNIT_TEST(testDict);
   CPPUNIT_TEST(testInvalid);
+  CPPUNIT_TEST(testDeferPicture);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -243,6 +247,45 @@ public:
     CPPUNIT_ASSERT_EQUAL(TagLib::uint(0), f.properties().size());
   }
 
+  void testDeferPicture()
+  {
+    ScopedFileCopy copy("silence-44-s", ".flac");
+    string newname = copy.fileName();
+
+    const ByteVector data(100000, 'J');
+
+    {
+      FLAC::File f(newname.c_str());
+      FLAC::Picture *newpic = new FLAC::Picture();
+      newpic->setType(FLAC::Picture::BackCover);
+      newpic->setMimeType("image/jpeg");
+      newpic->setDescription("new image");
+      newpic->setData(data);
+      f.addPicture(newpic);
+      f.save();
+    }
+
+    // Only the data of the large picture block is left in the stream, so it
+    // sees the bytes changed after the file has been opened.
+
+    FileStream file(newname.c_str(), true);
+    ByteVectorStream stream(file.readBlock(file.length()));
+
+    FLAC::File f(&stream, ID3v2::FrameFactory::instance(), false,
+                 FLAC::Properties::Average, File::DeferBinaryData);
+    List<FLAC::Picture *> lst = f.pictureList();
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(2), lst.size());
+    CPPUNIT_ASSERT_EQUAL(FLAC::Picture::BackCover, lst[1]->type());
+    CPPUNIT_ASSERT_EQUAL(String("image/jpeg"), lst[1]->mimeType());
+    CPPUNIT_ASSERT_EQUAL(String("new image"), lst[1]->description());
+
+    const int offset = stream.data()->find(data);
+    CPPUNIT_ASSERT(offset > 0);
+    ::memset(stream.data()->data() + offset, 'K', data.size());
+    CPPUNIT_ASSERT(lst[1]->data() == ByteVector(100000, 'K'));
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(150), lst[0]->data().size());
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestFLAC);
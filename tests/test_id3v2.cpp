@@ -78,8 +78,10 @@ class TestID3v2 : public CppUnit::TestFixture
   // CPPUNIT_TEST(testUpdateFullDate22); TODO TYE+TDA should be upgraded to TDRC together
   CPPUNIT_TEST(testCompressedFrameWithBrokenLength);
   CPPUNIT_TEST(testW000);
+  CPPUNIT_TEST(testRenderAlignGrowth);
   CPPUNIT_TEST(testPropertyInterface);
   CPPUNIT_TEST(testPropertyInterface2);
+  CPPUNIT_TEST(testPropertyKeys);
   CPPUNIT_TEST(testDeleteFrame);
   CPPUNIT_TEST(testSaveAndStripID3v1ShouldNotAddFrameFromID3v1ToId3v2);
   CPPUNIT_TEST_SUITE_END();
@@ -618,6 +620,21 @@ public:
     CPPUNIT_ASSERT_EQUAL(String("lukas.lalinsky@example.com____"), frame->url());
   }
 
+  void testRenderAlignGrowth()
+  {
+    MPEG::File f1(TEST_FILE_PATH_C("w000.mp3"), false);
+    MPEG::File f2(TEST_FILE_PATH_C("w000.mp3"), false);
+    const TagLib::uint size = f1.ID3v2Tag()->header()->completeTagSize();
+
+    f1.ID3v2Tag()->setTitle(String(ByteVector(2000, 'T')));
+    f2.ID3v2Tag()->setTitle(String(ByteVector(2000, 'T')));
+
+    const ByteVector plain = f1.ID3v2Tag()->render(4);
+    const ByteVector aligned = f2.ID3v2Tag()->render(4, true);
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(0), (aligned.size() - size) % 4096);
+    CPPUNIT_ASSERT(plain.size() < aligned.size());
+  }
+
   void testPropertyInterface()
   {
     ScopedFileCopy copy("rare_frames", ".mp3");
@@ -646,6 +663,17 @@ public:
     CPPUNIT_ASSERT_EQUAL(String("UFID/supermihi@web.de"), dict.unsupportedData().front());
   }
 
+  void testPropertyKeys()
+  {
+    CPPUNIT_ASSERT_EQUAL(ByteVector("TIT2"), ID3v2::Frame::keyToFrameID("TITLE"));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("TIT2"), ID3v2::Frame::keyToFrameID("title"));
+    CPPUNIT_ASSERT(ID3v2::Frame::keyToFrameID("NOTAKEY").isNull());
+    CPPUNIT_ASSERT_EQUAL(String("DATE"), ID3v2::Frame::frameIDToKey("TYER"));
+    CPPUNIT_ASSERT_EQUAL(String("ALBUM"), ID3v2::Frame::frameIDToKey("TALB"));
+    CPPUNIT_ASSERT_EQUAL(String("MUSICBRAINZ_ALBUMID"), ID3v2::Frame::txxxToKey("MusicBrainz Album Id"));
+    CPPUNIT_ASSERT_EQUAL(String("MusicBrainz Album Id"), ID3v2::Frame::keyToTXXX("musicbrainz_albumid"));
+  }
+
   void testPropertyInterface2()
   {
     ID3v2::Tag tag;
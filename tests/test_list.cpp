@@ -23,6 +23,7 @@
  */
 
 #include <cppunit/extensions/HelperMacros.h>
+#include <tstring.h>
 #include <tlist.h>
 
 using namespace std;
@@ -32,6 +33,13 @@ class TestList : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestList);
   CPPUNIT_TEST(testList);
+  CPPUNIT_TEST(testIndex);
+  CPPUNIT_TEST(testSortedInsert);
+  CPPUNIT_TEST(testAppendSelf);
+  CPPUNIT_TEST(testDetach);
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  CPPUNIT_TEST(testMove);
+#endif
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -53,6 +61,97 @@ public:
     CPPUNIT_ASSERT(l1 == l3);
   }
 
+  void testIndex()
+  {
+    List<int> l;
+    for(int i = 0; i < 100; ++i)
+      l.append(i * 2);
+
+    const List<int> &c = l;
+    CPPUNIT_ASSERT_EQUAL(0, c[0]);
+    CPPUNIT_ASSERT_EQUAL(84, c[42]);
+    CPPUNIT_ASSERT_EQUAL(198, c[99]);
+
+    l[42] = 1;
+    CPPUNIT_ASSERT_EQUAL(1, c[42]);
+
+    l.erase(l.find(1));
+    CPPUNIT_ASSERT_EQUAL(uint(99), l.size());
+    CPPUNIT_ASSERT_EQUAL(86, l[42]);
+  }
+
+  void testSortedInsert()
+  {
+    List<int> l;
+    l.sortedInsert(3);
+    l.sortedInsert(1);
+    l.sortedInsert(2);
+    l.sortedInsert(2, true);
+    l.sortedInsert(3);
+
+    List<int> expected;
+    expected.append(1);
+    expected.append(2);
+    expected.append(3);
+    expected.append(3);
+    CPPUNIT_ASSERT(l == expected);
+  }
+
+  void testAppendSelf()
+  {
+    List<int> l;
+    l.append(1);
+    l.append(2);
+    l.append(l);
+    l.prepend(l);
+    CPPUNIT_ASSERT_EQUAL(uint(8), l.size());
+    CPPUNIT_ASSERT_EQUAL(1, l[4]);
+    CPPUNIT_ASSERT_EQUAL(2, l.back());
+  }
+
+  void testDetach()
+  {
+    List<int> l1;
+    l1.append(1);
+    l1.append(2);
+
+    List<int> l2 = l1;
+    l2[0] = 3;
+    l2.erase(l2.find(2));
+    CPPUNIT_ASSERT_EQUAL(uint(2), l1.size());
+    CPPUNIT_ASSERT_EQUAL(1, l1.front());
+    CPPUNIT_ASSERT_EQUAL(uint(1), l2.size());
+    CPPUNIT_ASSERT_EQUAL(3, l2.front());
+  }
+
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  void testMove()
+  {
+    List<String> l1;
+    String s("abc");
+    const wchar_t *data = s.toCWString();
+    l1.append(std::move(s));
+    CPPUNIT_ASSERT(s.isEmpty());
+    CPPUNIT_ASSERT(l1.front().toCWString() == data);
+
+    List<String> l2(std::move(l1));
+    CPPUNIT_ASSERT_EQUAL(uint(1), l2.size());
+    CPPUNIT_ASSERT(l1.isEmpty());
+    l1.append("def");
+    CPPUNIT_ASSERT_EQUAL(uint(1), l1.size());
+    l1 = l2;
+    l1.prepend(String("xyz"));
+    CPPUNIT_ASSERT_EQUAL(uint(2), l1.size());
+    CPPUNIT_ASSERT_EQUAL(uint(1), l2.size());
+
+    List<String> l3;
+    l3 = std::move(l1);
+    CPPUNIT_ASSERT_EQUAL(uint(2), l3.size());
+    CPPUNIT_ASSERT_EQUAL(String("xyz"), l3.front());
+    CPPUNIT_ASSERT_EQUAL(String("abc"), l3.back());
+  }
+#endif
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestList);
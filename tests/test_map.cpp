@@ -9,6 +9,14 @@ class TestMap : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestMap);
   CPPUNIT_TEST(testInsert);
+  CPPUNIT_TEST(testOrder);
+  CPPUNIT_TEST(testErase);
+  CPPUNIT_TEST(testMissingKey);
+  CPPUNIT_TEST(testConstKey);
+  CPPUNIT_TEST(testIterators);
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  CPPUNIT_TEST(testMove);
+#endif
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -22,6 +30,119 @@ public:
     CPPUNIT_ASSERT_EQUAL(7, m["foo"]);
   }
 
+  void testOrder()
+  {
+    Map<int, int> m;
+    for(int i = 0; i < 50; ++i)
+      m.insert((i * 37) % 50, i);
+
+    CPPUNIT_ASSERT_EQUAL(uint(50), m.size());
+
+    int expected = 0;
+    for(Map<int, int>::ConstIterator it = m.begin(); it != m.end(); ++it) {
+      CPPUNIT_ASSERT_EQUAL(expected, it->first);
+      CPPUNIT_ASSERT_EQUAL(expected, (it->second * 37) % 50);
+      ++expected;
+    }
+  }
+
+  void testErase()
+  {
+    Map<String, int> m;
+    m["b"] = 2;
+    m["a"] = 1;
+    m["c"] = 3;
+
+    Map<String, int> copy = m;
+    m.erase("b");
+    CPPUNIT_ASSERT(!m.contains("b"));
+    CPPUNIT_ASSERT(m.contains("a"));
+    CPPUNIT_ASSERT(m.contains("c"));
+    CPPUNIT_ASSERT(copy.contains("b"));
+
+    m.erase(m.find("a"));
+    CPPUNIT_ASSERT_EQUAL(uint(1), m.size());
+    CPPUNIT_ASSERT(m.find("a") == m.end());
+    CPPUNIT_ASSERT_EQUAL(String("c"), m.begin()->first);
+  }
+
+  void testMissingKey()
+  {
+    Map<String, int> m;
+    m.insert("foo", 3);
+
+    const Map<String, int> &c = m;
+    CPPUNIT_ASSERT_EQUAL(0, c["bar"]);
+    CPPUNIT_ASSERT_EQUAL(uint(1), m.size());
+
+    CPPUNIT_ASSERT_EQUAL(0, m["bar"]);
+    CPPUNIT_ASSERT_EQUAL(uint(2), m.size());
+  }
+
+  void testConstKey()
+  {
+    Map<const String, int> m;
+    m.insert("b", 2);
+    m.insert("a", 1);
+    CPPUNIT_ASSERT_EQUAL(String("a"), m.begin()->first);
+    CPPUNIT_ASSERT_EQUAL(2, m["b"]);
+  }
+
+  void testIterators()
+  {
+    Map<String, int> m;
+    m.insert("b", 2);
+    m.insert("a", 1);
+
+    Map<String, int>::Iterator it = m.begin();
+    CPPUNIT_ASSERT_EQUAL(String("a"), it->first);
+    it->second = 10;
+    CPPUNIT_ASSERT_EQUAL(10, m["a"]);
+
+    Map<String, int>::ConstIterator cit = it;
+    CPPUNIT_ASSERT(cit == m.begin());
+    ++cit;
+    CPPUNIT_ASSERT_EQUAL(String("b"), (*cit).first);
+    CPPUNIT_ASSERT_EQUAL(2, (*cit).second);
+    CPPUNIT_ASSERT(++cit == m.end());
+    CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(std::distance(m.begin(), m.end())));
+
+    // The items are pairs, as with std::map.
+
+    std::pair<String, int> p = *m.begin();
+    CPPUNIT_ASSERT_EQUAL(String("a"), p.first);
+    const std::pair<const String, int> &r = *m.find("b");
+    CPPUNIT_ASSERT_EQUAL(2, r.second);
+
+    m.erase(m.find("a"));
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(1), m.size());
+  }
+
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  void testMove()
+  {
+    Map<String, String> m1;
+    String s("bar");
+    const wchar_t *data = s.toCWString();
+    m1.insert("foo", std::move(s));
+    CPPUNIT_ASSERT(s.isEmpty());
+    CPPUNIT_ASSERT(m1["foo"].toCWString() == data);
+
+    Map<String, String> m2(std::move(m1));
+    CPPUNIT_ASSERT_EQUAL(uint(1), m2.size());
+    CPPUNIT_ASSERT(m1.isEmpty());
+    CPPUNIT_ASSERT(!m1.contains("foo"));
+    m1 = m2;
+    m1.insert("baz", String("qux"));
+    CPPUNIT_ASSERT_EQUAL(uint(2), m1.size());
+    CPPUNIT_ASSERT_EQUAL(uint(1), m2.size());
+
+    m2 = std::move(m1);
+    CPPUNIT_ASSERT_EQUAL(uint(2), m2.size());
+    CPPUNIT_ASSERT_EQUAL(String("qux"), m2["baz"]);
+  }
+#endif
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestMap);
@@ -0,0 +1,100 @@
+#include <string>
+#include <stdio.h>
+#include <tmmapstream.h>
+#include <tfilestream.h>
+#include <tag.h>
+#include <mpegfile.h>
+#include <flacfile.h>
+#include <id3v2framefactory.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "utils.h"
+
+using namespace std;
+using namespace TagLib;
+
+class TestMMapStream : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestMMapStream);
+  CPPUNIT_TEST(testReadBlock);
+  CPPUNIT_TEST(testSeek);
+  CPPUNIT_TEST(testReadOnly);
+  CPPUNIT_TEST(testInvalidFile);
+  CPPUNIT_TEST(testMPEG);
+  CPPUNIT_TEST(testFLAC);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void testReadBlock()
+  {
+    MMapStream stream(TEST_FILE_PATH_C("xing.mp3"));
+    FileStream file(TEST_FILE_PATH_C("xing.mp3"), true);
+
+    CPPUNIT_ASSERT(stream.isOpen());
+    CPPUNIT_ASSERT_EQUAL(file.length(), stream.length());
+    CPPUNIT_ASSERT_EQUAL(file.readBlock(4), stream.readBlock(4));
+    CPPUNIT_ASSERT_EQUAL(4L, stream.tell());
+    CPPUNIT_ASSERT_EQUAL(file.readBlock(1000), stream.readBlock(1000));
+
+    stream.seek(-10, IOStream::End);
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(10), stream.readBlock(100).size());
+    CPPUNIT_ASSERT_EQUAL(ByteVector::null, stream.readBlock(100));
+  }
+
+  void testSeek()
+  {
+    MMapStream stream(TEST_FILE_PATH_C("xing.mp3"));
+
+    stream.seek(100);
+    CPPUNIT_ASSERT_EQUAL(100L, stream.tell());
+    stream.seek(20, IOStream::Current);
+    CPPUNIT_ASSERT_EQUAL(120L, stream.tell());
+    stream.seek(-128, IOStream::End);
+    CPPUNIT_ASSERT_EQUAL(stream.length() - 128, stream.tell());
+    stream.seek(-1);
+    CPPUNIT_ASSERT_EQUAL(stream.length() - 128, stream.tell());
+  }
+
+  void testReadOnly()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    MMapStream stream(newname.c_str());
+    CPPUNIT_ASSERT(stream.readOnly());
+
+    const long length = stream.length();
+    stream.insert(ByteVector("abcd"), 0, 0);
+    stream.writeBlock(ByteVector("abcd"));
+    stream.truncate(10);
+    CPPUNIT_ASSERT_EQUAL(length, stream.length());
+    CPPUNIT_ASSERT(fileEqual(newname, TEST_FILE_PATH_C("xing.mp3")));
+  }
+
+  void testInvalidFile()
+  {
+    MMapStream stream("does/not/exist.mp3");
+    CPPUNIT_ASSERT(!stream.isOpen());
+    CPPUNIT_ASSERT_EQUAL(ByteVector::null, stream.readBlock(10));
+  }
+
+  void testMPEG()
+  {
+    MMapStream stream(TEST_FILE_PATH_C("mpeg2.mp3"));
+    MPEG::File f(&stream, ID3v2::FrameFactory::instance());
+    CPPUNIT_ASSERT(f.isValid());
+    CPPUNIT_ASSERT_EQUAL(5387, f.audioProperties()->length());
+  }
+
+  void testFLAC()
+  {
+    MMapStream stream(TEST_FILE_PATH_C("silence-44-s.flac"));
+    FLAC::File f(&stream, ID3v2::FrameFactory::instance());
+    CPPUNIT_ASSERT(f.isValid());
+    CPPUNIT_ASSERT_EQUAL(String("Quod Libet Test Data"), f.tag()->album());
+    CPPUNIT_ASSERT(!f.save());
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestMMapStream);
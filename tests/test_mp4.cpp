@@ -4,6 +4,8 @@
 #include <mp4tag.h>
 #include <tbytevectorlist.h>
 #include <tpropertymap.h>
+#include <tfilestream.h>
+#include <tbytevectorstream.h>
 #include <mp4atom.h>
 #include <mp4file.h>
 #include <cppunit/extensions/HelperMacros.h>
@@ -27,6 +29,8 @@ class TestMP4 : public CppUnit::TestFixture
   CPPUNIT_TEST(testCovrWrite);
   CPPUNIT_TEST(testCovrRead2);
   CPPUNIT_TEST(testProperties);
+  CPPUNIT_TEST(testCovrDeferred);
+  CPPUNIT_TEST(testReadBasicFields);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -275,6 +279,52 @@ public:
     CPPUNIT_ASSERT_EQUAL(StringList("0"), tags["COMPILATION"]);
   }
 
+  void testCovrDeferred()
+  {
+    ScopedFileCopy copy("has-tags", ".m4a");
+    string filename = copy.fileName();
+
+    const ByteVector data(100000, 'J');
+
+    {
+      MP4::File f(filename.c_str());
+      MP4::CoverArtList l = f.tag()->itemListMap()["covr"].toCoverArtList();
+      l.append(MP4::CoverArt(MP4::CoverArt::JPEG, data));
+      f.tag()->itemListMap()["covr"] = l;
+      f.save();
+    }
+
+    // Each data atom of the covr atom is left in the stream after its header,
+    // so the last one sees the bytes changed after the file has been opened.
+
+    FileStream file(filename.c_str(), true);
+    ByteVectorStream stream(file.readBlock(file.length()));
+
+    MP4::File f(&stream, false, MP4::Properties::Average, File::DeferBinaryData);
+    MP4::CoverArtList l = f.tag()->itemListMap()["covr"].toCoverArtList();
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(3), l.size());
+    CPPUNIT_ASSERT_EQUAL(MP4::CoverArt::PNG, l[0].format());
+    CPPUNIT_ASSERT_EQUAL(MP4::CoverArt::JPEG, l[2].format());
+
+    const int offset = stream.data()->find(data);
+    CPPUNIT_ASSERT(offset > 0);
+    ::memset(stream.data()->data() + offset, 'K', data.size());
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(79), l[0].data().size());
+    CPPUNIT_ASSERT(l[2].data() == ByteVector(100000, 'K'));
+  }
+
+  void testReadBasicFields()
+  {
+    ScopedFileCopy copy("has-tags", ".m4a");
+    string filename = copy.fileName();
+
+    MP4::File f(filename.c_str(), false, MP4::Properties::Average, File::ReadArtist);
+    CPPUNIT_ASSERT_EQUAL(String("Test Artist"), f.tag()->artist());
+    CPPUNIT_ASSERT(!f.tag()->itemListMap().contains("covr"));
+    CPPUNIT_ASSERT(!f.tag()->itemListMap().contains("----:com.apple.iTunes:iTunNORM"));
+    CPPUNIT_ASSERT(!f.save());
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestMP4);
@@ -3,6 +3,8 @@
 #include <tstring.h>
 #include <mpegfile.h>
 #include <id3v2tag.h>
+#include <attachedpictureframe.h>
+#include <privateframe.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
@@ -16,6 +18,10 @@ class TestMPEG : public CppUnit::TestFixture
   CPPUNIT_TEST(testSaveID3v24);
   CPPUNIT_TEST(testSaveID3v24WrongParam);
   CPPUNIT_TEST(testSaveID3v23);
+  CPPUNIT_TEST(testSaveReplaceFile);
+  CPPUNIT_TEST(testDeferBinaryData);
+  CPPUNIT_TEST(testReadBasicFields);
+  CPPUNIT_TEST(testReadBasicFieldsHugeFrame);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -83,6 +89,163 @@ public:
     CPPUNIT_ASSERT_EQUAL(xxx, f2.tag()->title());
   }
 
+  void testSaveReplaceFile()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    ByteVector audio;
+    {
+      MPEG::File f(newname.c_str());
+      f.seek(0);
+      audio = f.readBlock(f.length());
+      f.setSaveStrategy(File::ReplaceFile);
+      f.tag()->setTitle("Title");
+      f.save(MPEG::File::ID3v2);
+    }
+    {
+      MPEG::File f(newname.c_str());
+      f.setSaveStrategy(File::ReplaceFile);
+      f.tag()->setArtist(String(ByteVector(5000, 'A')));
+      f.save(MPEG::File::ID3v2);
+    }
+    {
+      MPEG::File f(newname.c_str());
+      f.setSaveStrategy(File::ReplaceFile);
+      f.ID3v2Tag()->removeFrames("TPE1");
+      f.ID3v2Tag()->setArtist("Artist");
+      f.save(MPEG::File::ID3v2);
+    }
+
+    MPEG::File f(newname.c_str());
+    CPPUNIT_ASSERT(f.isValid());
+    CPPUNIT_ASSERT_EQUAL(String("Title"), f.tag()->title());
+    CPPUNIT_ASSERT_EQUAL(String("Artist"), f.tag()->artist());
+
+    const long audioOffset = f.ID3v2Tag()->header()->completeTagSize();
+    f.seek(audioOffset);
+    CPPUNIT_ASSERT_EQUAL(f.length() - audioOffset, static_cast<long>(audio.size()));
+    CPPUNIT_ASSERT(f.readBlock(audio.size()) == audio);
+  }
+
+  void testDeferBinaryData()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    const ByteVector picture(100000, 'P');
+    const ByteVector data(50000, 'D');
+
+    {
+      MPEG::File f(newname.c_str());
+      ID3v2::AttachedPictureFrame *apic = new ID3v2::AttachedPictureFrame;
+      apic->setMimeType("image/jpeg");
+      apic->setDescription("Cover");
+      apic->setPicture(picture);
+      f.ID3v2Tag(true)->addFrame(apic);
+      ID3v2::PrivateFrame *priv = new ID3v2::PrivateFrame;
+      priv->setOwner("owner");
+      priv->setData(data);
+      f.ID3v2Tag()->addFrame(priv);
+      f.tag()->setTitle("Title");
+      f.save();
+    }
+    {
+      MPEG::File f(newname.c_str(), false, MPEG::Properties::Average, File::DeferBinaryData);
+      CPPUNIT_ASSERT(!f.audioProperties());
+      CPPUNIT_ASSERT_EQUAL(String("Title"), f.tag()->title());
+
+      ID3v2::AttachedPictureFrame *apic =
+        static_cast<ID3v2::AttachedPictureFrame *>(f.ID3v2Tag()->frameList("APIC").front());
+      CPPUNIT_ASSERT_EQUAL(String("image/jpeg"), apic->mimeType());
+      CPPUNIT_ASSERT_EQUAL(String("Cover"), apic->description());
+
+      // The picture and the private data must survive the tag moving.
+
+      f.tag()->setArtist(String(ByteVector(10000, 'A')));
+      f.save();
+
+      CPPUNIT_ASSERT(apic->picture() == picture);
+    }
+    {
+      MPEG::File f(newname.c_str(), false, MPEG::Properties::Average, File::DeferBinaryData);
+      ID3v2::AttachedPictureFrame *apic =
+        static_cast<ID3v2::AttachedPictureFrame *>(f.ID3v2Tag()->frameList("APIC").front());
+      CPPUNIT_ASSERT(apic->picture() == picture);
+      ID3v2::PrivateFrame *priv =
+        static_cast<ID3v2::PrivateFrame *>(f.ID3v2Tag()->frameList("PRIV").front());
+      CPPUNIT_ASSERT_EQUAL(String("owner"), priv->owner());
+      CPPUNIT_ASSERT(priv->data() == data);
+      CPPUNIT_ASSERT_EQUAL(String("Title"), f.tag()->title());
+    }
+  }
+
+  void testReadBasicFields()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    {
+      MPEG::File f(newname.c_str());
+      f.ID3v2Tag(true)->setTitle("Title");
+      f.ID3v2Tag()->setArtist("Artist");
+      f.ID3v2Tag()->setTrack(5);
+      f.save(MPEG::File::ID3v2);
+    }
+    {
+      MPEG::File f(newname.c_str(), false, MPEG::Properties::Average,
+                   File::ReadTitle | File::ReadTrack);
+      CPPUNIT_ASSERT_EQUAL(String("Title"), f.tag()->title());
+      CPPUNIT_ASSERT_EQUAL(String(), f.tag()->artist());
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(5), f.tag()->track());
+      CPPUNIT_ASSERT(f.ID3v2Tag()->frameListMap()["TPE1"].isEmpty());
+      CPPUNIT_ASSERT(!f.save());
+    }
+    {
+      MPEG::File f(newname.c_str(), false, MPEG::Properties::Average,
+                   File::ReadArtist | File::DeferBinaryData);
+      CPPUNIT_ASSERT_EQUAL(String(), f.tag()->title());
+      CPPUNIT_ASSERT_EQUAL(String("Artist"), f.tag()->artist());
+    }
+    {
+      MPEG::File f(newname.c_str());
+      CPPUNIT_ASSERT_EQUAL(String("Title"), f.tag()->title());
+      CPPUNIT_ASSERT_EQUAL(String("Artist"), f.tag()->artist());
+    }
+  }
+
+  void testReadBasicFieldsHugeFrame()
+  {
+    // A TXXX frame whose size takes the position of the next frame round to
+    // itself must not be skipped over.
+
+    const ByteVector frames =
+      ByteVector("TIT2\x00\x00\x00\x03\x00\x00\x00Ti", 13) +
+      ByteVector("TXXX\xff\xff\xff\xf6\x00\x00", 10) +
+      ByteVector(10, 'x');
+
+    // Unsynchronised tags are parsed in one go, others frame by frame.
+
+    const char flags[] = { 0x00, char(0x80) };
+
+    for(int i = 0; i < 2; ++i) {
+      ScopedFileCopy copy("xing", ".mp3");
+      string newname = copy.fileName();
+
+      {
+        MPEG::File f(newname.c_str());
+        f.insert(ByteVector("ID3\x03\x00", 5) + ByteVector(1, flags[i]) +
+                 ByteVector::fromUInt(frames.size()) + frames, 0, 0);
+      }
+      {
+        MPEG::File f(newname.c_str(), false, MPEG::Properties::Average,
+                     File::ReadTitle);
+        CPPUNIT_ASSERT(f.isValid());
+        CPPUNIT_ASSERT_EQUAL(String("Ti"), f.tag()->title());
+      }
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestMPEG);
@@ -6,6 +6,7 @@
 #include <tpropertymap.h>
 #include <oggfile.h>
 #include <vorbisfile.h>
+#include <oggpage.h>
 #include <oggpageheader.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
@@ -20,6 +21,9 @@ class TestOGG : public CppUnit::TestFixture
   CPPUNIT_TEST(testSplitPackets);
   CPPUNIT_TEST(testDictInterface1);
   CPPUNIT_TEST(testDictInterface2);
+  CPPUNIT_TEST(testPropertiesThroughFile);
+  CPPUNIT_TEST(testPageChecksum);
+  CPPUNIT_TEST(testReadBasicFields);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -99,6 +103,70 @@ public:
     delete f;
   }
 
+  void testPropertiesThroughFile()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    string newname = copy.fileName();
+
+    Vorbis::File f(newname.c_str());
+    TagLib::File &file = f;
+
+    PropertyMap tags;
+    tags["TITLE"] = StringList("title");
+    CPPUNIT_ASSERT(file.setProperties(tags).isEmpty());
+    CPPUNIT_ASSERT_EQUAL(StringList("title"), file.properties()["TITLE"]);
+
+    file.removeUnsupportedProperties(StringList("UNKNOWN"));
+    CPPUNIT_ASSERT_EQUAL(StringList("title"), f.properties()["TITLE"]);
+  }
+
+  void testPageChecksum()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    string newname = copy.fileName();
+
+    Vorbis::File *f = new Vorbis::File(newname.c_str());
+    f->tag()->addField("test", ByteVector(128 * 1024, 'x'));
+    f->save();
+    f->seek(0);
+    ByteVector data = f->readBlock(f->length());
+    delete f;
+
+    int pages = 0;
+    for(int pos = data.find("OggS"); pos != -1; pos = data.find("OggS", pos + 1)) {
+      CPPUNIT_ASSERT(Ogg::Page::checksumIsValid(data.mid(pos)));
+      pages++;
+    }
+    CPPUNIT_ASSERT(pages > 10);
+
+    ByteVector page = data.mid(0, 58);
+    CPPUNIT_ASSERT(Ogg::Page::checksumIsValid(page));
+    page[40] = page[40] + 1;
+    CPPUNIT_ASSERT(!Ogg::Page::checksumIsValid(page));
+    CPPUNIT_ASSERT(!Ogg::Page::checksumIsValid(page.mid(0, 30)));
+  }
+
+  void testReadBasicFields()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    string newname = copy.fileName();
+
+    {
+      Vorbis::File f(newname.c_str());
+      f.tag()->setTitle("Title");
+      f.tag()->setAlbum("Album");
+      f.tag()->addField("MUSICBRAINZ_TRACKID", "1234");
+      f.save();
+    }
+    {
+      Vorbis::File f(newname.c_str(), false, Vorbis::Properties::Average, File::ReadAlbum);
+      CPPUNIT_ASSERT_EQUAL(String(), f.tag()->title());
+      CPPUNIT_ASSERT_EQUAL(String("Album"), f.tag()->album());
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(1), f.tag()->fieldCount());
+      CPPUNIT_ASSERT(!f.save());
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestOGG);
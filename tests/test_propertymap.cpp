@@ -4,6 +4,10 @@ class TestPropertyMap : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestPropertyMap);
   CPPUNIT_TEST(testInvalidKeys);
+  CPPUNIT_TEST(testCaseInsensitiveKeys);
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  CPPUNIT_TEST(testMovedFrom);
+#endif
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -27,6 +31,45 @@ public:
     CPPUNIT_ASSERT(!map2.contains(map1));
 
   }
+
+  void testCaseInsensitiveKeys()
+  {
+    TagLib::PropertyMap map;
+    map.insert("Title", TagLib::StringList("first"));
+    map.insert("TITLE", TagLib::StringList("second"));
+    CPPUNIT_ASSERT_EQUAL(1u, map.size());
+    CPPUNIT_ASSERT_EQUAL(TagLib::String("TITLE"), map.begin()->first);
+    CPPUNIT_ASSERT_EQUAL(2u, map["title"].size());
+    CPPUNIT_ASSERT_EQUAL(TagLib::String("second"), map["tItLe"][1]);
+    CPPUNIT_ASSERT(map.contains("title"));
+
+    map.replace("title", TagLib::StringList("third"));
+    CPPUNIT_ASSERT_EQUAL(TagLib::StringList("third"), map["TITLE"]);
+
+    map.erase("Title");
+    CPPUNIT_ASSERT(map.isEmpty());
+  }
+
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  void testMovedFrom()
+  {
+    TagLib::PropertyMap map1;
+    map1["TITLE"].append("Title");
+    map1.unsupportedData().append("APIC");
+
+    TagLib::PropertyMap map2(std::move(map1));
+    CPPUNIT_ASSERT_EQUAL(1u, map2.size());
+    CPPUNIT_ASSERT(map1.isEmpty());
+    CPPUNIT_ASSERT(map1.unsupportedData().isEmpty());
+    CPPUNIT_ASSERT(!map1.contains("TITLE"));
+
+    TagLib::StringList list1("a");
+    TagLib::StringList list2(std::move(list1));
+    CPPUNIT_ASSERT(list1.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(TagLib::String(), list1.toString());
+  }
+#endif
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestPropertyMap);
@@ -22,8 +22,15 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
 #include <tstring.h>
 #include <string.h>
+#ifdef HAVE_STD_THREAD
+#include <thread>
+#endif
 #include <cppunit/extensions/HelperMacros.h>
 
 using namespace std;
@@ -43,6 +50,19 @@ class TestString : public CppUnit::TestFixture
   CPPUNIT_TEST(testToInt);
   CPPUNIT_TEST(testSubstr);
   CPPUNIT_TEST(testNewline);
+  CPPUNIT_TEST(testSharing);
+  CPPUNIT_TEST(testUTF8Encode);
+  CPPUNIT_TEST(testUTF8Decode);
+  CPPUNIT_TEST(testUTF8DecodeInvalid);
+  CPPUNIT_TEST(testLongStrings);
+  CPPUNIT_TEST(testEightBitCache);
+#ifdef HAVE_STD_THREAD
+  CPPUNIT_TEST(testEightBitThreads);
+#endif
+  CPPUNIT_TEST(testUpper);
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  CPPUNIT_TEST(testMove);
+#endif
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -228,6 +248,249 @@ public:
     CPPUNIT_ASSERT_EQUAL(L'\x0a', String(crlf)[4]);
   }
 
+  void testSharing()
+  {
+    String a("abc");
+    String b = a;
+    b[0] = L'x';
+    CPPUNIT_ASSERT_EQUAL(String("abc"), a);
+    CPPUNIT_ASSERT_EQUAL(String("xbc"), b);
+
+    a += a;
+    CPPUNIT_ASSERT_EQUAL(String("abcabc"), a);
+
+    String c;
+    for(int i = 0; i < 100; i++)
+      c += L'a';
+    CPPUNIT_ASSERT_EQUAL(uint(100), c.size());
+    CPPUNIT_ASSERT_EQUAL(uint(100), uint(::wcslen(c.toCWString())));
+
+    CPPUNIT_ASSERT(String::null.isNull());
+    CPPUNIT_ASSERT(String(String::null).isNull());
+    CPPUNIT_ASSERT(!String().isNull());
+    CPPUNIT_ASSERT(!String("").isNull());
+    CPPUNIT_ASSERT_EQUAL(String(), String::null);
+    CPPUNIT_ASSERT_EQUAL(0, ::strcmp("", String().toCString()));
+    CPPUNIT_ASSERT_EQUAL(0, ::wcscmp(L"", String().toCWString()));
+    CPPUNIT_ASSERT_EQUAL(-1, String().find("a"));
+    CPPUNIT_ASSERT_EQUAL(String(), String("abc").substr(3));
+  }
+
+  void testUTF8Encode()
+  {
+    String s;
+    s += L'a';
+    s += static_cast<wchar_t>(0xe9);
+    s += static_cast<wchar_t>(0x20ac);
+    s += static_cast<wchar_t>(0xd834);
+    s += static_cast<wchar_t>(0xdd1e);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("a\xc3\xa9\xe2\x82\xac\xf0\x9d\x84\x9e"), s.data(String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(std::string("a\xc3\xa9\xe2\x82\xac\xf0\x9d\x84\x9e"), s.to8Bit(true));
+
+    String unpaired;
+    unpaired += L'a';
+    unpaired += static_cast<wchar_t>(0xdc00);
+    unpaired += L'b';
+    CPPUNIT_ASSERT_EQUAL(ByteVector("a\xef\xbf\xbd" "b"), unpaired.data(String::UTF8));
+  }
+
+  void testUTF8Decode()
+  {
+    String s(ByteVector("a\xc3\xa9\xe2\x82\xac\xf0\x9d\x84\x9e"), String::UTF8);
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(5), s.size());
+    CPPUNIT_ASSERT_EQUAL(L'a', s[0]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<wchar_t>(0xe9), s[1]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<wchar_t>(0x20ac), s[2]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<wchar_t>(0xd834), s[3]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<wchar_t>(0xdd1e), s[4]);
+
+    // The string ends at a null byte.
+
+    CPPUNIT_ASSERT_EQUAL(String("ab"), String(ByteVector("ab\0cd", 5), String::UTF8));
+  }
+
+  void testUTF8DecodeInvalid()
+  {
+    // Everything before the first malformed sequence is kept.
+
+    CPPUNIT_ASSERT_EQUAL(String("ab"), String(ByteVector("ab\xff" "cd"), String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(String("ab"), String(ByteVector("ab\xc3"), String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(String("ab"), String(ByteVector("ab\xc0\xaf"), String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(String("ab"), String(ByteVector("ab\xed\xa0\x80"), String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(String("ab"), String(ByteVector("ab\xf4\x90\x80\x80"), String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(String("ab"), String(ByteVector("ab\xe2\x28\xa1"), String::UTF8));
+  }
+
+  void testLongStrings()
+  {
+    // Long enough for the block wise conversions, with the non-ASCII
+    // characters in various positions.
+
+    for(int i = 0; i < 40; ++i) {
+      std::string latin(40, 'x');
+      latin[i] = '\xe9';
+
+      const String s(latin, String::Latin1);
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(40), s.size());
+      CPPUNIT_ASSERT_EQUAL(static_cast<wchar_t>(0xe9), s[i]);
+      CPPUNIT_ASSERT_EQUAL(L'x', s[(i + 1) % 40]);
+      CPPUNIT_ASSERT_EQUAL(latin, s.to8Bit());
+      CPPUNIT_ASSERT_EQUAL(ByteVector(latin.data(), latin.size()), s.data(String::Latin1));
+
+      const std::string utf8 = s.to8Bit(true);
+      CPPUNIT_ASSERT_EQUAL(size_t(41), utf8.size());
+      CPPUNIT_ASSERT_EQUAL(s, String(utf8, String::UTF8));
+      CPPUNIT_ASSERT_EQUAL(0, ::strcmp(utf8.c_str(), s.toCString(true)));
+
+      const ByteVector be = s.data(String::UTF16BE);
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(80), be.size());
+      CPPUNIT_ASSERT_EQUAL('\0', be[i * 2]);
+      CPPUNIT_ASSERT_EQUAL('\xe9', be[i * 2 + 1]);
+      CPPUNIT_ASSERT_EQUAL(s, String(be, String::UTF16BE));
+      CPPUNIT_ASSERT_EQUAL(s, String(s.data(String::UTF16LE), String::UTF16LE));
+      CPPUNIT_ASSERT_EQUAL(s, String(s.data(String::UTF16), String::UTF16));
+    }
+
+    String wide;
+    for(int i = 0; i < 40; ++i)
+      wide += static_cast<wchar_t>(0x100 + i);
+    CPPUNIT_ASSERT_EQUAL(wide, String(wide.data(String::UTF16BE), String::UTF16BE));
+    CPPUNIT_ASSERT_EQUAL(wide, String(wide.data(String::UTF8), String::UTF8));
+    CPPUNIT_ASSERT_EQUAL('\x27', wide.data(String::Latin1)[39]);
+  }
+
+  void testEightBitCache()
+  {
+    const ByteVector utf8("Jos\xc3\xa9 Carlos, written in UTF-8");
+    String s(utf8, String::UTF8);
+
+    const char *p = s.toCString(true);
+    CPPUNIT_ASSERT_EQUAL(std::string(utf8.data(), utf8.size()), std::string(p));
+    CPPUNIT_ASSERT(s.toCString(true) == p);
+    CPPUNIT_ASSERT_EQUAL(utf8, s.data(String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(std::string("Jos\xe9 Carlos, written in UTF-8"), std::string(s.toCString()));
+    CPPUNIT_ASSERT_EQUAL(std::string("Jos\xc3\xa9 Carlos, written in UTF-8"), s.to8Bit(true));
+
+    // Copies share the cache, and changing the characters clears it.
+
+    String t = s;
+    t[0] = L'j';
+    CPPUNIT_ASSERT_EQUAL(std::string("jos\xc3\xa9 Carlos, written in UTF-8"), std::string(t.toCString(true)));
+    CPPUNIT_ASSERT_EQUAL(utf8, s.data(String::UTF8));
+
+    s += static_cast<wchar_t>(0x20ac);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("Jos\xc3\xa9 Carlos, written in UTF-8\xe2\x82\xac"), s.data(String::UTF8));
+
+    // Characters written through an iterator or reference that was handed
+    // out before are seen as well.
+
+    String u("abc");
+    String::Iterator it = u.begin();
+    u.toCString();
+    *it = L'x';
+    CPPUNIT_ASSERT_EQUAL(std::string("xbc"), std::string(u.toCString()));
+    *it = L'y';
+    CPPUNIT_ASSERT_EQUAL(std::string("ybc"), u.to8Bit(true));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("ybc"), u.data(String::UTF8));
+
+    String v("abc");
+    wchar &c = v[0];
+    v.to8Bit(true);
+    c = L'z';
+    CPPUNIT_ASSERT_EQUAL(std::string("zbc"), std::string(v.toCString(true)));
+
+    // Only what has been decoded is kept.
+
+    String invalid(ByteVector("ab\xff" "cd"), String::UTF8);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("ab"), invalid.data(String::UTF8));
+    CPPUNIT_ASSERT_EQUAL(std::string("ab"), std::string(invalid.toCString()));
+
+    // ASCII is the same in Latin-1 and UTF-8.
+
+    String ascii(ByteVector("ascii"), String::UTF8);
+    CPPUNIT_ASSERT(ascii.toCString(false) == ascii.toCString(true));
+
+    String latin("latin");
+    const char *q = latin.toCString();
+    CPPUNIT_ASSERT(latin.toCString(true) == q);
+  }
+
+#ifdef HAVE_STD_THREAD
+
+  static void callToCString(String s, bool unicode, int *failures)
+  {
+    for(int i = 0; i < 1000; ++i) {
+      if(String(s.toCString(unicode), unicode ? String::UTF8 : String::Latin1) != s)
+        ++*failures;
+    }
+  }
+
+  static void callTo8Bit(String s, bool unicode, int *failures)
+  {
+    for(int i = 0; i < 1000; ++i) {
+      if(String(s.to8Bit(unicode), unicode ? String::UTF8 : String::Latin1) != s)
+        ++*failures;
+    }
+  }
+
+  void testEightBitThreads()
+  {
+    // toCString() on one copy must not disturb to8Bit() and data() on another.
+
+    const String fromUTF8(ByteVector("Jos\xc3\xa9 Carlos"), String::UTF8);
+    const String fromWide(L"Jos\u00e9 Carlos");
+
+    for(int i = 0; i < 4; ++i) {
+      const String &s = (i < 2) ? fromUTF8 : fromWide;
+      const bool unicode = (i % 2 == 0);
+
+      int failures1 = 0;
+      int failures2 = 0;
+      std::thread t1(callToCString, s, !unicode, &failures1);
+      std::thread t2(callTo8Bit, s, unicode, &failures2);
+      t1.join();
+      t2.join();
+
+      CPPUNIT_ASSERT_EQUAL(0, failures1);
+      CPPUNIT_ASSERT_EQUAL(0, failures2);
+      CPPUNIT_ASSERT_EQUAL(ByteVector("Jos\xc3\xa9 Carlos"), s.data(String::UTF8));
+    }
+  }
+
+#endif
+
+  void testUpper()
+  {
+    const String s1 = "TITLE";
+    CPPUNIT_ASSERT_EQUAL(s1, s1.upper());
+    CPPUNIT_ASSERT(s1.upper().toCWString() == s1.toCWString());
+
+    const String s2 = "MusicBrainz Album Id";
+    CPPUNIT_ASSERT_EQUAL(String("MUSICBRAINZ ALBUM ID"), s2.upper());
+    CPPUNIT_ASSERT_EQUAL(String("MusicBrainz Album Id"), s2);
+    CPPUNIT_ASSERT_EQUAL(String(), String().upper());
+  }
+
+#ifdef TAGLIB_HAVE_RVALUE_REFERENCES
+  void testMove()
+  {
+    String a("abc");
+    const wchar_t *data = a.toCWString();
+    String b(std::move(a));
+    CPPUNIT_ASSERT(a.isEmpty());
+    CPPUNIT_ASSERT(b.toCWString() == data);
+
+    String c("xyz");
+    c = std::move(b);
+    CPPUNIT_ASSERT(b.isEmpty());
+    CPPUNIT_ASSERT(c.toCWString() == data);
+
+    b += "def";
+    CPPUNIT_ASSERT_EQUAL(String("def"), b);
+    CPPUNIT_ASSERT_EQUAL(String("abc"), c);
+  }
+#endif
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestString);
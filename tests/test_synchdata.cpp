@@ -38,6 +38,8 @@ class TestID3v2SynchData : public CppUnit::TestFixture
   CPPUNIT_TEST(testToUIntBrokenAndTooLarge);
   CPPUNIT_TEST(testDecode1);
   CPPUNIT_TEST(testDecode2);
+  CPPUNIT_TEST(testDecodeInPlace);
+  CPPUNIT_TEST(testEncode);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -102,6 +104,28 @@ public:
     CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\x44", 2), a);
   }
 
+  void testDecodeInPlace()
+  {
+    ByteVector a("\x01\xff\x00\xff\xff\x00\x00\xe0\xff\x00", 10);
+    const TagLib::uint size = ID3v2::SynchData::decode(a.data(), a.size(), a.data());
+    CPPUNIT_ASSERT_EQUAL(TagLib::uint(7), size);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\x01\xff\xff\xff\x00\xe0\xff", 7), a.mid(0, size));
+  }
+
+  void testEncode()
+  {
+    ByteVector a("\xff\x00\xff\xe0\xff\x44\xff", 7);
+    ByteVector b = ID3v2::SynchData::encode(a);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\x00\x00\xff\x00\xe0\xff\x44\xff\x00", 10), b);
+    CPPUNIT_ASSERT_EQUAL(a, ID3v2::SynchData::decode(b));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("abc"), ID3v2::SynchData::encode("abc"));
+
+    ByteVector c(1000U);
+    for(TagLib::uint i = 0; i < c.size(); i++)
+      c[i] = (i % 3 == 0) ? '\xff' : static_cast<char>(i * 37);
+    CPPUNIT_ASSERT_EQUAL(c, ID3v2::SynchData::decode(ID3v2::SynchData::encode(c)));
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestID3v2SynchData);
@@ -4,6 +4,7 @@
 #include <tag.h>
 #include <tbytevectorlist.h>
 #include <wavpackfile.h>
+#include <apetag.h>
 #include "utils.h"
 
 using namespace std;
@@ -14,6 +15,7 @@ class TestWavPack : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(TestWavPack);
   CPPUNIT_TEST(testBasic);
   CPPUNIT_TEST(testLengthScan);
+  CPPUNIT_TEST(testReadBasicFields);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -35,6 +37,28 @@ public:
     CPPUNIT_ASSERT_EQUAL(4, props->length());
   }
 
+  void testReadBasicFields()
+  {
+    ScopedFileCopy copy("click", ".wv");
+    string newname = copy.fileName();
+
+    {
+      WavPack::File f(newname.c_str());
+      f.APETag(true)->setTitle("Title");
+      f.APETag()->setGenre("Genre");
+      f.APETag()->setYear(2001);
+      f.save();
+    }
+    {
+      WavPack::File f(newname.c_str(), false, WavPack::Properties::Average,
+                      File::ReadGenre | File::ReadYear);
+      CPPUNIT_ASSERT(!f.APETag()->itemListMap().contains("TITLE"));
+      CPPUNIT_ASSERT_EQUAL(String("Genre"), f.APETag()->genre());
+      CPPUNIT_ASSERT_EQUAL(TagLib::uint(2001), f.APETag()->year());
+      CPPUNIT_ASSERT(!f.save());
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestWavPack);